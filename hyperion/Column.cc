@@ -76,8 +76,9 @@ index_column(
   typedef typename DataType<DT>::ValueType T;
   static const constexpr size_t min_block_size = 10000;
 
-  // launch index space task on input region to compute accumulator value
-  std::vector<std::tuple<T, Column::COLUMN_INDEX_ROWS_TYPE>> acc;
+  // launch index space task on blocks of the input region to compute the
+  // index of each block, and then merge the block indexes
+  column_index_block<T> acc;
   {
     IndexPartition ip =
       partition_over_default_tunable(
@@ -94,14 +95,15 @@ index_column(
     task.add_region_requirement(
       RegionRequirement(col_lp, 0, READ_ONLY, EXCLUSIVE, col_req.region));
     task.add_field(0, *col_req.privilege_fields.begin());
-    Future f =
-      rt->execute_index_space(
-        ctx,
-        task,
-        OpsManager::reduction_id(DataType<DT>::af_redop_id));
+    FutureMap fm = rt->execute_index_space(ctx, task);
+    std::vector<column_index_block<T>> blocks;
+    for (PointInDomainIterator<1> pid(rt->get_index_space_domain(cs));
+         pid();
+         pid++)
+      blocks.push_back(fm.get_result<column_index_block<T>>(*pid));
     rt->destroy_index_space(ctx, cs);
     rt->destroy_index_partition(ctx, ip);
-    acc = f.get_result<acc_field_redop_rhs<T>>().v;
+    acc = column_index_block<T>::merge(std::move(blocks));
   }
 
   LogicalRegionT<1> result_lr;
@@ -117,7 +119,7 @@ index_column(
       fa.allocate_field(
         sizeof(Column::COLUMN_INDEX_ROWS_TYPE),
         Column::COLUMN_INDEX_ROWS_FID,
-        OpsManager::serdez_id(OpsManager::V_DOMAIN_POINT_SID));
+        OpsManager::serdez_id(OpsManager::V_ROW_RUN_SID));
       rt->attach_name(
         result_fs,
         Column::COLUMN_INDEX_ROWS_FID,
@@ -136,8 +138,12 @@ index_column(
     const WOAccessor<Column::COLUMN_INDEX_ROWS_TYPE, 1>
       rns(result_pr, Column::COLUMN_INDEX_ROWS_FID);
     for (size_t i = 0; i < acc.size(); ++i) {
+      values[i] = acc.values[i];
       ::new (rns.ptr(i)) Column::COLUMN_INDEX_ROWS_TYPE;
-      std::tie(values[i], rns[i]) = acc[i];
+      row_run::from_points(
+        acc.points.begin() + acc.offsets[i],
+        acc.points.begin() + acc.offsets[i + 1],
+        std::back_inserter(rns[i]));
     }
     rt->unmap_region(ctx, result_pr);
   }
@@ -172,34 +178,40 @@ TaskID Column::index_accumulate_task_id[HYPERION_NUM_TYPE_TAGS];
 std::string Column::index_accumulate_task_name[HYPERION_NUM_TYPE_TAGS];
 
 template <typename T, int DIM>
-std::map<T, std::vector<DomainPoint>>
-acc_d_pts(FieldID fid, const DomainT<DIM>& dom, const PhysicalRegion& pr) {
-  std::map<T, std::vector<Legion::DomainPoint>> result;
+static column_index_block<T>
+index_d_block(
+  FieldID fid,
+  const DomainT<DIM>& dom,
+  const PhysicalRegion& pr) {
+  // collect (value, point) pairs in increasing (row-major) point order, so
+  // that the stable sort by value leaves the points of every value sorted
+  std::vector<std::tuple<T, DomainPoint>> pairs;
+  pairs.reserve(dom.volume());
   const ROAccessor<T, DIM> vals(pr, fid);
-  for (PointInDomainIterator<DIM> pid(dom); pid();pid++) {
-    if (result.count(vals[*pid]) == 0)
-      result[vals[*pid]] = std::vector<DomainPoint>();
-    result[vals[*pid]].push_back(*pid);
-  }
-  return result;
+  for (PointInDomainIterator<DIM> pid(dom, false); pid(); pid++)
+    pairs.emplace_back(vals[*pid], *pid);
+  return column_index_block<T>::from_pairs(std::move(pairs));
 }
 
 template <hyperion::TypeTag DT>
-std::map<typename DataType<DT>::ValueType, std::vector<DomainPoint>>
-acc_pts(Runtime* rt, const RegionRequirement& req, const PhysicalRegion& pr) {
+static column_index_block<typename DataType<DT>::ValueType>
+index_block(
+  Runtime* rt,
+  const RegionRequirement& req,
+  const PhysicalRegion& pr) {
   typedef typename DataType<DT>::ValueType T;
   assert(req.privilege_fields.size() == 1);
   Legion::FieldID fid = *(req.privilege_fields.begin());
   IndexSpace is = req.region.get_index_space();
-  std::map<T, std::vector<DomainPoint>> result;
+  column_index_block<T> result;
   switch (is.get_dim()) {
-#define ACC_D_PTS(D)                                                  \
-  case D: {                                                           \
-    result = acc_d_pts<T,D>(fid, rt->get_index_space_domain(is), pr); \
-    break;                                                            \
+#define INDEX_D_BLOCK(D)                                                \
+  case D: {                                                             \
+    result = index_d_block<T,D>(fid, rt->get_index_space_domain(is), pr); \
+    break;                                                              \
   }
-  HYPERION_FOREACH_N(ACC_D_PTS)
-#undef ACC_D_PTS
+  HYPERION_FOREACH_N(INDEX_D_BLOCK)
+#undef INDEX_D_BLOCK
   default:
     assert(false);
     break;
@@ -209,20 +221,13 @@ acc_pts(Runtime* rt, const RegionRequirement& req, const PhysicalRegion& pr) {
 
 #define INDEX_ACCUMULATE_TASK(DT)                                       \
   template <>                                                           \
-  acc_field_redop_rhs<typename DataType<DT>::ValueType> \
+  column_index_block<typename DataType<DT>::ValueType>                  \
   Column::index_accumulate_task<DT>(                                    \
     const Legion::Task* task,                                           \
     const std::vector<Legion::PhysicalRegion>& regions,                 \
     Legion::Context,                                                    \
     Legion::Runtime* rt) {                                              \
-    std::map<                                                           \
-      typename DataType<DT>::ValueType, \
-      std::vector<Legion::DomainPoint>> pts = \
-      acc_pts<DT>(rt, task->regions[0], regions[0]);                    \
-    acc_field_redop_rhs<DataType<DT>::ValueType> result;                \
-    result.v.reserve(pts.size());                                       \
-    std::copy(pts.begin(), pts.end(), std::back_inserter(result.v));    \
-    return result;                                                      \
+    return index_block<DT>(rt, task->regions[0], regions[0]);           \
   }
 HYPERION_FOREACH_DATATYPE(INDEX_ACCUMULATE_TASK);
 #undef INDEX_ACCUMULATE_TASK
@@ -242,7 +247,7 @@ Column::preregister_index_accumulate_task() {
   registrar.set_idempotent();
   // registrar.set_replicable();
   Runtime::preregister_task_variant<
-    acc_field_redop_rhs<typename DataType<DT>::ValueType>,
+    column_index_block<typename DataType<DT>::ValueType>,
     index_accumulate_task<DT>>(
     registrar,
     index_accumulate_task_name[(unsigned)DT].c_str());
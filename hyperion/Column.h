@@ -184,9 +184,11 @@ public:
 
   /**
    * Column index rows field id
+   *
+   * Rows of each index value are stored as a sorted list of disjoint runs.
    */
   static constexpr const Legion::FieldID COLUMN_INDEX_ROWS_FID = 1;
-  typedef std::vector<Legion::DomainPoint> COLUMN_INDEX_ROWS_TYPE;
+  typedef std::vector<row_run> COLUMN_INDEX_ROWS_TYPE;
 
   /**
    * Create a column index Legion::LogicalRegion
@@ -234,10 +236,10 @@ public:
 //   friend class Legion::LegionTaskWrapper;
 
   /**
-   * Task to compute a column index
+   * Task to compute the index of a block of a column
    */
   template <hyperion::TypeTag DT>
-  static acc_field_redop_rhs<typename DataType<DT>::ValueType>
+  static column_index_block<typename DataType<DT>::ValueType>
   index_accumulate_task(
     const Legion::Task* task,
     const std::vector<Legion::PhysicalRegion>& regions,
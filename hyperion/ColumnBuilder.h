@@ -178,13 +178,47 @@ public:
     m_meas_record = std::move(rec);
   }
 
+  /**
+   * Index tree of a row element
+   *
+   * @param[in] any The shape of the row element
+   */
+  virtual IndexTreeL
+  element_tree(const CXX_ANY_NAMESPACE::any&) const = 0;
+
   /**
    * Add a row
    *
    * @param[in] any The shape of the row element
    */
-  virtual void
-  add_row(const CXX_ANY_NAMESPACE::any&) = 0;
+  void
+  add_row(const CXX_ANY_NAMESPACE::any& args) {
+    set_next_row(element_tree(args));
+  }
+
+  /**
+   * Add a block of rows
+   *
+   * Appends a block of rows to the column index space at once, which avoids
+   * the per-row cost of add_row() when the index tree of the block is known,
+   * as it is for columns with a fixed element shape.
+   *
+   * @param[in] num_rows Number of rows in the block
+   * @param[in] block_tree IndexTreeL of the block, with row indexes relative
+   * to the start of the block
+   */
+  void
+  add_rows(size_t num_rows, const IndexTreeL& block_tree) {
+    std::vector<std::tuple<Legion::coord_t, Legion::coord_t, IndexTreeL>> ch;
+    ch.reserve(block_tree.children().size());
+    for (auto& c : block_tree.children())
+      ch.emplace_back(
+        std::get<0>(c) + static_cast<Legion::coord_t>(m_num_rows),
+        std::get<1>(c),
+        std::get<2>(c));
+    m_index_tree = m_index_tree.merged_with(IndexTreeL(ch));
+    m_num_rows += num_rows;
+  }
 
   /**
    * Construct the ColumnArgs
@@ -302,9 +336,9 @@ public:
 
   virtual ~ScalarColumnBuilder() {}
 
-  void
-  add_row(const CXX_ANY_NAMESPACE::any&) override {
-    ColumnBuilder<D>::set_next_row(IndexTreeL());
+  IndexTreeL
+  element_tree(const CXX_ANY_NAMESPACE::any&) const override {
+    return IndexTreeL();
   }
 };
 
@@ -358,10 +392,10 @@ public:
       };
   }
 
-  void
-  add_row(const CXX_ANY_NAMESPACE::any& args) override {
+  IndexTreeL
+  element_tree(const CXX_ANY_NAMESPACE::any& args) const override {
     auto ary = m_element_shape(args);
-    IndexTreeL t =
+    return
       std::accumulate(
         ary.rbegin(),
         ary.rend(),
@@ -369,7 +403,6 @@ public:
         [](const auto& t, const auto& d) {
           return IndexTreeL({{d, t}});
         });
-    ColumnBuilder<D>::set_next_row(t);
   }
 
 private:
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <hyperion/ColumnSpace.h>
+#include <hyperion/Instrumentation.h>
 #include <hyperion/Column.h>
 #include <hyperion/Table.h>
 
@@ -581,21 +582,6 @@ struct ComputeRowMappingTaskArgs {
   IndexPartition row_partition;
 };
 
-static std::vector<DomainPoint>
-intersection(
-  const std::vector<DomainPoint>& first,
-  const std::vector<DomainPoint>& second) {
-
-  std::vector<DomainPoint> result;
-  std::set_intersection(
-    first.begin(),
-    first.end(),
-    second.begin(),
-    second.end(),
-    std::back_inserter(result));
-  return result;
-}
-
 void
 ColumnSpace::compute_row_mapping_task(
   const Task* task,
@@ -603,6 +589,8 @@ ColumnSpace::compute_row_mapping_task(
   Context ctx,
   Runtime *rt) {
 
+  Instrumentation::Scope scope(task);
+
   const ComputeRowMappingTaskArgs* args =
     static_cast<const ComputeRowMappingTaskArgs*>(task->args);
 
@@ -617,31 +605,49 @@ ColumnSpace::compute_row_mapping_task(
   auto ixdim = regions.size() - 1;
 
   unsigned r1 = args->row_dim - 1; // rank above ROW index
-  std::vector<DomainPoint> common_rows;
+  Column::COLUMN_INDEX_ROWS_TYPE common_rows;
   {
     rows_acc_t rows(regions[0], Column::COLUMN_INDEX_ROWS_FID);
     common_rows = rows[task->index_point[0 + r1]];
   }
-  for (size_t i = 1; i < ixdim; ++i) {
+  for (size_t i = 1; common_rows.size() > 0 && i < ixdim; ++i) {
     rows_acc_t rows(regions[i], Column::COLUMN_INDEX_ROWS_FID);
-    common_rows = intersection(common_rows, rows[task->index_point[i + r1]]);
+    common_rows =
+      row_run::intersection(common_rows, rows[task->index_point[i + r1]]);
   }
 
   if (common_rows.size() > 0) {
-    assert((int)args->row_dim == common_rows[0].get_dim());
-    std::vector<DomainPoint> here_rows;
+    assert((int)args->row_dim == common_rows[0].lo.get_dim());
+    // all points in a run share every coordinate but the last, which is
+    // never among those matched here
     int r2 = (int)r1 - (args->allow_rows ? 1 : 0);
+    Column::COLUMN_INDEX_ROWS_TYPE here_runs;
     std::copy_if(
       common_rows.begin(),
       common_rows.end(),
-      std::back_inserter(here_rows),
-      [task, &r2](auto& pt) {
+      std::back_inserter(here_runs),
+      [task, &r2](auto& run) {
         bool match = true;
         for (int i = 0; match && i < r2; ++i)
-          match = pt[i] == task->index_point[i];
+          match = run.lo[i] == task->index_point[i];
         return match;
       });
-    if ((args->allow_rows || here_rows.size() == 1)) {
+    size_t num_here_rows =
+      std::accumulate(
+        here_runs.begin(),
+        here_runs.end(),
+        size_t(0),
+        [](auto& acc, auto& run) { return acc + run.size(); });
+    scope.add_rows(num_here_rows);
+    if ((args->allow_rows || num_here_rows == 1)) {
+      std::vector<DomainPoint> here_rows;
+      here_rows.reserve(num_here_rows);
+      for (auto& run : here_runs) {
+        DomainPoint pt = run.lo;
+        int d = pt.get_dim() - 1;
+        for (; pt[d] <= run.hi[d]; ++pt[d])
+          here_rows.push_back(pt);
+      }
       auto rectdim =
         ixdim + (args->allow_rows ? 1 : 0) /* + args->row_dim */ - 1
         + args->row_partition.get_dim() /* - args->row_dim */;
@@ -779,6 +785,9 @@ ColumnSpace::preregister_tasks() {
   {
     // compute_row_mapping_task
     compute_row_mapping_task_id = Runtime::generate_static_task_id();
+    Instrumentation::register_task(
+      compute_row_mapping_task_id,
+      compute_row_mapping_task_name);
     TaskVariantRegistrar
       registrar(compute_row_mapping_task_id, compute_row_mapping_task_name);
     registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
@@ -0,0 +1,259 @@
+/*
+ * Copyright 2020 Associated Universities, Inc. Washington DC, USA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <hyperion/Instrumentation.h>
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+using namespace hyperion;
+
+using namespace Legion;
+
+#if !HAVE_CXX17
+const constexpr unsigned Instrumentation::max_tasks;
+const constexpr unsigned Instrumentation::max_processors;
+#endif
+
+std::atomic<bool> Instrumentation::s_enabled(false);
+
+typedef Processor::id_t proc_id_t;
+
+namespace {
+
+// Registered tasks, and their counters. Task registration takes place before
+// the runtime is started, after which the task slots are only read. Processor
+// slots of each task are claimed on first use by a compare-and-swap on the
+// processor id (in an open addressing table), and counters are only updated
+// atomically, so that no locks are taken by an instrumented task.
+struct Registry {
+  std::unordered_map<TaskID, unsigned> slots;
+  std::vector<std::string> names;
+  std::once_flag allocated;
+  std::once_flag overflowed;
+  std::unique_ptr<std::atomic<proc_id_t>[]> procs;
+  std::unique_ptr<Instrumentation::Counters[]> counters;
+  std::string output;
+};
+
+} // end namespace
+
+static Registry&
+registry() {
+  static Registry result;
+  return result;
+}
+
+void
+Instrumentation::register_task(TaskID task_id, const std::string& name) {
+  auto& reg = registry();
+  if (reg.slots.count(task_id) > 0)
+    return;
+  if (reg.names.size() < max_tasks) {
+    reg.slots[task_id] = reg.names.size();
+    reg.names.push_back(name);
+  } else {
+    std::call_once(
+      reg.overflowed,
+      []() {
+        std::cerr << "WARNING: Instrumentation task limit ("
+                  << max_tasks
+                  << ") reached, further tasks will not be instrumented"
+                  << std::endl;
+      });
+    assert(reg.names.size() < max_tasks);
+  }
+}
+
+void
+Instrumentation::enable(bool on) {
+  if (on) {
+    auto& reg = registry();
+    std::call_once(
+      reg.allocated,
+      [&reg]() {
+        const size_t n = max_tasks * max_processors;
+        reg.procs.reset(new std::atomic<proc_id_t>[n]());
+        reg.counters.reset(new Counters[n]());
+      });
+  }
+  s_enabled.store(on, std::memory_order_release);
+}
+
+void
+Instrumentation::reset() {
+  auto& reg = registry();
+  if (reg.counters) {
+    for (size_t i = 0; i < max_tasks * max_processors; ++i) {
+      auto& c = reg.counters[i];
+      c.count.store(0, std::memory_order_relaxed);
+      c.nanoseconds.store(0, std::memory_order_relaxed);
+      c.bytes.store(0, std::memory_order_relaxed);
+      c.rows.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+void
+Instrumentation::Scope::start(TaskID task_id, Processor proc) {
+  auto& reg = registry();
+  auto ts = reg.slots.find(task_id);
+  if (ts == reg.slots.end())
+    return;
+  const size_t t = ts->second * max_processors;
+  const proc_id_t id = proc.id;
+  const unsigned p0 = id % max_processors;
+  for (unsigned i = 0; m_counters == nullptr && i < max_processors; ++i) {
+    const unsigned p = (p0 + i) % max_processors;
+    proc_id_t slot_id = reg.procs[t + p].load(std::memory_order_relaxed);
+    if (slot_id == 0)
+      reg.procs[t + p].compare_exchange_strong(
+        slot_id,
+        id,
+        std::memory_order_relaxed);
+    // slot_id is now either the previous value (if the exchange failed) or
+    // still 0 (if the slot was claimed)
+    if (slot_id == 0 || slot_id == id)
+      m_counters = &reg.counters[t + p];
+  }
+  m_t0 = Realm::Clock::current_time_in_nanoseconds();
+}
+
+void
+Instrumentation::Scope::stop() {
+  const long long t1 = Realm::Clock::current_time_in_nanoseconds();
+  m_counters->count.fetch_add(1, std::memory_order_relaxed);
+  m_counters->nanoseconds.fetch_add(t1 - m_t0, std::memory_order_relaxed);
+  m_counters->bytes.fetch_add(m_bytes, std::memory_order_relaxed);
+  m_counters->rows.fetch_add(m_rows, std::memory_order_relaxed);
+}
+
+void
+Instrumentation::Scope::add_region_bytes(
+  Runtime* rt,
+  const RegionRequirement& req) {
+
+  if (m_counters == nullptr || req.region == LogicalRegion::NO_REGION)
+    return;
+  size_t field_size = 0;
+  for (auto& fid : req.privilege_fields)
+    field_size += rt->get_field_size(req.region.get_field_space(), fid);
+  m_bytes +=
+    rt->get_index_space_domain(req.region.get_index_space()).get_volume()
+    * field_size;
+}
+
+void
+Instrumentation::Scope::add_region_bytes(
+  Runtime* rt,
+  const std::vector<RegionRequirement>& reqs) {
+
+  if (m_counters == nullptr)
+    return;
+  for (auto& req : reqs)
+    add_region_bytes(rt, req);
+}
+
+void
+Instrumentation::dump(std::ostream& os) {
+  auto& reg = registry();
+  if (!reg.counters)
+    return;
+  auto rate =
+    [](double n, double s) {
+      return (s > 0) ? n / s : 0.0;
+    };
+  auto write =
+    [&](
+      const std::string& name,
+      const std::string& proc,
+      std::uint64_t count,
+      std::uint64_t ns,
+      std::uint64_t bytes,
+      std::uint64_t rows) {
+      const double s = ns * 1.0e-9;
+      os << "\"" << name << "\","
+         << proc << ","
+         << count << ","
+         << s << ","
+         << rate(s * 1.0e3, count) << ","
+         << bytes << ","
+         << rate(bytes * 1.0e-9, s) << ","
+         << rows << std::endl;
+    };
+  os << "task,processor,count,seconds,mean_ms,bytes,GB_per_s,rows"
+     << std::endl;
+  for (size_t t = 0; t < reg.names.size(); ++t) {
+    std::uint64_t count = 0, ns = 0, bytes = 0, rows = 0;
+    unsigned num_procs = 0;
+    for (size_t p = 0; p < max_processors; ++p) {
+      const size_t i = t * max_processors + p;
+      const proc_id_t id = reg.procs[i].load(std::memory_order_relaxed);
+      auto& c = reg.counters[i];
+      const std::uint64_t c_count = c.count.load(std::memory_order_relaxed);
+      if (id == 0 || c_count == 0)
+        continue;
+      const std::uint64_t c_ns = c.nanoseconds.load(std::memory_order_relaxed);
+      const std::uint64_t c_bytes = c.bytes.load(std::memory_order_relaxed);
+      const std::uint64_t c_rows = c.rows.load(std::memory_order_relaxed);
+      std::ostringstream proc;
+      proc << std::hex << std::showbase << id;
+      write(reg.names[t], proc.str(), c_count, c_ns, c_bytes, c_rows);
+      count += c_count;
+      ns += c_ns;
+      bytes += c_bytes;
+      rows += c_rows;
+      ++num_procs;
+    }
+    if (num_procs > 1)
+      write(reg.names[t], "all", count, ns, bytes, rows);
+  }
+}
+
+static void
+dump_at_exit() {
+  auto& output = registry().output;
+  if (output.empty()) {
+    Instrumentation::dump(std::cerr);
+  } else {
+    std::ofstream ofs(output);
+    Instrumentation::dump(ofs);
+  }
+}
+
+void
+Instrumentation::preregister() {
+  const char* val = std::getenv("HYPERION_INSTRUMENTATION");
+  if (val != nullptr && *val != '\0' && std::strcmp(val, "0") != 0) {
+    if (std::strcmp(val, "1") != 0)
+      registry().output = val;
+    enable();
+    std::atexit(dump_at_exit);
+  }
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 2
+// fill-column: 80
+// indent-tabs-mode: nil
+// End:
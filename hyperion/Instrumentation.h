@@ -0,0 +1,202 @@
+/*
+ * Copyright 2020 Associated Universities, Inc. Washington DC, USA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HYPERION_INSTRUMENTATION_H_
+#define HYPERION_INSTRUMENTATION_H_
+
+#include <hyperion/hyperion.h>
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hyperion {
+
+/**
+ * Lightweight task instrumentation
+ *
+ * Tasks that are registered with register_task() (before the Legion runtime
+ * is started) accumulate counts of invocations, execution time, bytes and rows
+ * in per-task, per-processor counters, through an Instrumentation::Scope
+ * instance at the top of the task body. Counters are updated with relaxed
+ * atomic operations only, and, when instrumentation is not enabled, a Scope
+ * does nothing beyond testing a flag.
+ *
+ * Instrumentation is enabled at runtime by the environment variable
+ * HYPERION_INSTRUMENTATION: a value of "1" enables instrumentation with a
+ * summary written to standard error at process exit, "0" (or no value) leaves
+ * it disabled, and any other value enables it with the summary written to a
+ * file of that name. A summary can also be written at any time by dump().
+ */
+class HYPERION_EXPORT Instrumentation {
+public:
+
+  /**
+   * maximum number of registered tasks
+   */
+  static const constexpr unsigned max_tasks = 256;
+
+  /**
+   * maximum number of distinct processors per task
+   */
+  static const constexpr unsigned max_processors = 128;
+
+  /**
+   * task invocation counters, padded to the size of a cache line
+   */
+  struct Counters {
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> nanoseconds;
+    std::atomic<std::uint64_t> bytes;
+    std::atomic<std::uint64_t> rows;
+    char pad[64 - 4 * sizeof(std::atomic<std::uint64_t>)];
+  };
+
+  /**
+   * RAII instrumentation scope for a task body
+   *
+   * Time is accumulated from construction to destruction; bytes and rows are
+   * added as the task proceeds, and are accumulated on destruction.
+   */
+  class HYPERION_EXPORT Scope {
+  public:
+
+    Scope(const Legion::Task* task)
+      : m_counters(nullptr)
+      , m_t0(0)
+      , m_bytes(0)
+      , m_rows(0) {
+      if (enabled())
+        start(task->task_id, task->current_proc);
+    }
+
+    Scope(const Scope&) = delete;
+
+    Scope&
+    operator=(const Scope&) = delete;
+
+    ~Scope() {
+      if (m_counters != nullptr)
+        stop();
+    }
+
+    /**
+     * true iff the task instance is being instrumented
+     */
+    bool
+    active() const {
+      return m_counters != nullptr;
+    }
+
+    void
+    add_bytes(std::size_t n) {
+      m_bytes += n;
+    }
+
+    void
+    add_rows(std::size_t n) {
+      m_rows += n;
+    }
+
+    /**
+     * add the size of the privilege fields of a region to the byte count
+     */
+    void
+    add_region_bytes(
+      Legion::Runtime* rt,
+      const Legion::RegionRequirement& req);
+
+    /**
+     * add the size of the privilege fields of all regions to the byte count
+     */
+    void
+    add_region_bytes(
+      Legion::Runtime* rt,
+      const std::vector<Legion::RegionRequirement>& reqs);
+
+  private:
+
+    void
+    start(Legion::TaskID task_id, Legion::Processor proc);
+
+    void
+    stop();
+
+    Counters* m_counters;
+
+    long long m_t0;
+
+    std::size_t m_bytes;
+
+    std::size_t m_rows;
+  };
+
+  /**
+   * register a task for instrumentation
+   *
+   * Must be called before the Legion runtime is started. Tasks registered
+   * after max_tasks tasks have been registered are not instrumented, and a
+   * warning is written (once) to standard error.
+   */
+  static void
+  register_task(Legion::TaskID task_id, const std::string& name);
+
+  static bool
+  enabled() {
+    return s_enabled.load(std::memory_order_acquire);
+  }
+
+  /**
+   * enable or disable instrumentation
+   */
+  static void
+  enable(bool on = true);
+
+  /**
+   * zero all counters
+   */
+  static void
+  reset();
+
+  /**
+   * write a summary of all non-zero counters
+   */
+  static void
+  dump(std::ostream& os);
+
+  /**
+   * enable instrumentation according to the value of the
+   * HYPERION_INSTRUMENTATION environment variable
+   */
+  static void
+  preregister();
+
+private:
+
+  static std::atomic<bool> s_enabled;
+};
+
+} // end namespace hyperion
+
+#endif // HYPERION_INSTRUMENTATION_H_
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 2
+// fill-column: 80
+// indent-tabs-mode: nil
+// End:
@@ -690,7 +690,7 @@ public:
   template <
     template <typename, int, typename> typename A = Legion::GenericAccessor,
     typename COORD_T = Legion::coord_t>
-  PhysicalColumnTD<HYPERION_TYPE_BOOL, row_rank, uvw_rank, A, COORD_T>
+  PhysicalColumnTD<HYPERION_TYPE_DOUBLE, row_rank, uvw_rank, A, COORD_T>
   uvw() const {
     return decltype(uvw<A, COORD_T>())(
       *m_columns.at(HYPERION_COLUMN_NAME(MAIN, UVW)));
@@ -733,7 +733,7 @@ public:
   template <
     template <typename, int, typename> typename A = Legion::GenericAccessor,
     typename COORD_T = Legion::coord_t>
-  PhysicalColumnTD<HYPERION_TYPE_BOOL, row_rank, uvw2_rank, A, COORD_T>
+  PhysicalColumnTD<HYPERION_TYPE_DOUBLE, row_rank, uvw2_rank, A, COORD_T>
   uvw2() const {
     return decltype(uvw2<A, COORD_T>())(
       *m_columns.at(HYPERION_COLUMN_NAME(MAIN, UVW2)));
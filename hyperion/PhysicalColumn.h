@@ -167,6 +167,22 @@ public:
       v);
     T::m_value.write(pt, v);
   }
+
+  // write the values f(pt) at all points pt in "rect"; points are visited in
+  // groups by measure reference, so that every reference's converter is set
+  // up at most once
+  template <typename F>
+  void
+  write(const Legion::Rect<COLUMN_RANK, COORD_T>& rect, F&& f) {
+
+    T::m_meas_ref.convert_rect(
+      rect,
+      [this, &f](const Legion::Point<COLUMN_RANK, COORD_T>& pt, auto& cvt) {
+        typename DataType<DT>::ValueType v;
+        MClassT<MC>::template store<DT>(cvt(f(pt)), T::m_units, v);
+        T::m_value.write(pt, v);
+      });
+  }
 };
 
 template <
@@ -202,6 +218,30 @@ public:
       T::m_value.write(ept, vs[i]);
     }
   }
+
+  // write the values f(pt) at all points pt in "rect"; points are visited in
+  // groups by measure reference, so that every reference's converter is set
+  // up at most once
+  template <typename F>
+  void
+  write(const Legion::Rect<COLUMN_RANK - 1, COORD_T>& rect, F&& f) {
+
+    casacore::Vector<typename DataType<DT>::ValueType> vs(MV_SIZE);
+    T::m_meas_ref.convert_rect(
+      rect,
+      [this, &f, &vs](
+        const Legion::Point<COLUMN_RANK - 1, COORD_T>& pt,
+        auto& cvt) {
+        MClassT<MC>::template store<DT>(cvt(f(pt)), T::m_units, vs);
+        Legion::Point<COLUMN_RANK, COORD_T> ept;
+        for (size_t i = 0; i < COLUMN_RANK - 1; ++i)
+          ept[i] = pt[i];
+        for (size_t i = 0; i < MV_SIZE; ++i) {
+          ept[COLUMN_RANK - 1] = i;
+          T::m_value.write(ept, vs[i]);
+        }
+      });
+  }
 };
 #endif //HYPERION_USE_CASACORE
 
@@ -1165,22 +1205,47 @@ public:
 
     MC_t&
     convert_at(const Legion::Point<COLUMN_RANK - M_RANK, Legion::coord_t>& pt) {
+      if (m_mrv)
+        return convert_for(mr_index_at(pt));
+      return m_convert;
+    }
+
+    /**
+     * Apply a function to the converter for every point in a Rect
+     *
+     * Points are grouped by measure reference, and the function is called as
+     * f(pt, convert) for all the points with a given reference before moving
+     * on to the next reference, so that a converter's state is reused across
+     * each group. Within a group, points are visited in the Rect's iteration
+     * order.
+     */
+    template <typename F>
+    void
+    convert_rect(
+      const Legion::Rect<COLUMN_RANK - M_RANK, Legion::coord_t>& rect,
+      F&& f) {
+
+      typedef Legion::Point<COLUMN_RANK - M_RANK, Legion::coord_t> pt_t;
       if (m_mrv) {
-#if HAVE_CXX17
-        auto& [mrs, rmap, rcodes] = m_mrv.value();
-#else // !HAVE_CXX17
-        auto& mrs = std::get<0>(m_mrv.value());
-        auto& rmap = std::get<1>(m_mrv.value());
-        auto& rcodes = std::get<2>(m_mrv.value());
-#endif // HAVE_CXX17
-        m_convert.setOut(
-          *mrs[
-            rmap.at(
-              rcodes.read(
-                reinterpret_cast<const Legion::Point<INDEX_RANK, Legion::coord_t>&>(
-                  pt)))]);
+        std::vector<std::vector<pt_t>>
+          groups(std::get<0>(m_mrv.value()).size());
+        for (Legion::PointInRectIterator<COLUMN_RANK - M_RANK> pir(rect, false);
+             pir();
+             pir++)
+          groups[mr_index_at(*pir)].push_back(*pir);
+        for (size_t i = 0; i < groups.size(); ++i) {
+          if (groups[i].size() > 0) {
+            MC_t& cvt = convert_for(i);
+            for (auto& pt : groups[i])
+              f(pt, cvt);
+          }
+        }
+      } else {
+        for (Legion::PointInRectIterator<COLUMN_RANK - M_RANK> pir(rect, false);
+             pir();
+             pir++)
+          f(*pir, m_convert);
       }
-      return m_convert;
     }
 
     MR_t&
@@ -1204,6 +1269,32 @@ public:
     }
 
   private:
+
+    unsigned
+    mr_index_at(
+      const Legion::Point<COLUMN_RANK - M_RANK, Legion::coord_t>& pt) const {
+      auto& rmap = std::get<1>(m_mrv.value());
+      auto& rcodes = std::get<2>(m_mrv.value());
+      return
+        rmap.at(
+          rcodes.read(
+            reinterpret_cast<const Legion::Point<INDEX_RANK, Legion::coord_t>&>(
+              pt)));
+    }
+
+    // converters are created on first use, with one converter per measure
+    // reference, to avoid a (costly) call to MC_t::setOut() for every change
+    // of reference between elements
+    MC_t&
+    convert_for(unsigned i) {
+      auto cvt = m_converts.find(i);
+      if (cvt == m_converts.end()) {
+        cvt = m_converts.emplace(i, MC_t()).first;
+        cvt->second.setOut(*std::get<0>(m_mrv.value())[i]);
+      }
+      return cvt->second;
+    }
+
     std::shared_ptr<MR_t> m_mr;
 
     CXX_OPTIONAL_NAMESPACE::optional<
@@ -1214,6 +1305,8 @@ public:
     m_mrv;
 
     MC_t m_convert;
+
+    std::unordered_map<unsigned, MC_t> m_converts;
   };
 
   template <
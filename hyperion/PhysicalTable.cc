@@ -15,6 +15,13 @@
  */
 #include <hyperion/PhysicalTable.h>
 #include <hyperion/Keywords.h>
+#include <hyperion/Instrumentation.h>
+#ifdef HYPERION_USE_HDF5
+# include <hyperion/hdf5.h>
+#endif
+
+#include <cstring>
+#include <type_traits>
 
 using namespace hyperion;
 using namespace Legion;
@@ -44,6 +51,8 @@ PhysicalTable::PhysicalTable(const PhysicalTable& other)
     other.m_index_col_parent,
     other.m_columns) {
   m_attached = other.m_attached;
+  m_deferred = other.m_deferred;
+  m_file_maps = other.m_file_maps;
 }
 
 PhysicalTable::PhysicalTable(PhysicalTable&& other)
@@ -55,6 +64,8 @@ PhysicalTable::PhysicalTable(PhysicalTable&& other)
     std::move(other).m_index_col_parent,
     std::move(other).m_columns) {
   m_attached = std::move(other).m_attached;
+  m_deferred = std::move(other).m_deferred;
+  m_file_maps = std::move(other).m_file_maps;
 }
 
 CXX_OPTIONAL_NAMESPACE::optional<
@@ -802,6 +813,7 @@ PhysicalTable::remove_columns(
 #endif
       m_columns.erase(nm);
       m_attached.erase(nm);
+      m_deferred.erase(nm);
     }
     for (auto& lr_cs : lrcss) {
       auto& lr = std::get<0>(lr_cs);
@@ -928,7 +940,7 @@ using SA = FieldAccessor<
   DIM,
   coord_t,
   AffineAccessor<typename DataType<DT>::ValueType, DIM, coord_t>,
-  true>;
+  HYPERION_CHECK_BOUNDS>;
 
 template <hyperion::TypeTag DT, int DIM>
 using DA = FieldAccessor<
@@ -937,7 +949,7 @@ using DA = FieldAccessor<
   DIM,
   coord_t,
   AffineAccessor<typename DataType<DT>::ValueType, DIM, coord_t>,
-  true>;
+  HYPERION_CHECK_BOUNDS>;
 
 template <int DDIM, int RDIM>
 using RA = FieldAccessor<
@@ -946,7 +958,80 @@ using RA = FieldAccessor<
   RDIM,
   coord_t,
   AffineAccessor<Rect<DDIM>, RDIM, coord_t>,
-  true>;
+  HYPERION_CHECK_BOUNDS>;
+
+template <hyperion::TypeTag DT, int ROWDIM, int SRCDIM, int DSTDIM>
+static void
+reindex_copy_rows(
+  Runtime *rt,
+  FieldID val_fid,
+  const RegionRequirement& rect_req,
+  const PhysicalRegion& rect_pr,
+  const PhysicalRegion& src_pr,
+  const PhysicalRegion& dst_pr) {
+
+  typedef typename DataType<DT>::ValueType T;
+
+  const SA<DT,SRCDIM> from(src_pr, val_fid);
+  const RA<DSTDIM,ROWDIM> rct(rect_pr, ColumnSpace::REINDEXED_ROW_RECTS_FID);
+  const DA<DT,DSTDIM> to(dst_pr, val_fid);
+
+  // when the innermost axis of the source is a column (not a row) axis, and
+  // values along that axis are adjacent in both source and destination
+  // instances, the innermost extent of every destination rectangle is copied
+  // as a single block
+  const bool copy_runs =
+    SRCDIM > ROWDIM
+    && std::is_trivially_copyable<T>::value
+    && from.accessor.strides[SRCDIM - 1] == static_cast<coord_t>(sizeof(T))
+    && to.accessor.strides[DSTDIM - 1] == static_cast<coord_t>(sizeof(T));
+
+  for (PointInDomainIterator<ROWDIM> row(
+         rt->get_index_space_domain(rect_req.region.get_index_space()),
+         false);
+       row();
+       ++row) {
+    Point<SRCDIM> ps;
+    for (size_t i = 0; i < ROWDIM; ++i)
+      ps[i] = row[i];
+    const Rect<DSTDIM> rect = rct[*row];
+    if (copy_runs) {
+      if (rect.empty())
+        continue;
+      const coord_t run_lo = rect.lo[DSTDIM - 1];
+      const coord_t run_hi = rect.hi[DSTDIM - 1];
+      Rect<DSTDIM> runs = rect;
+      runs.hi[DSTDIM - 1] = run_lo;
+      for (PointInRectIterator<DSTDIM> pd(runs, false); pd(); pd++) {
+        size_t i = SRCDIM - 1;
+        size_t j = DSTDIM - 1;
+        while (i >= ROWDIM)
+          ps[i--] = pd[j--];
+        if (HYPERION_CHECK_BOUNDS) {
+          // check the bounds of the last elements of the run
+          Point<SRCDIM> ps_hi = ps;
+          ps_hi[SRCDIM - 1] = run_hi;
+          Point<DSTDIM> pd_hi = *pd;
+          pd_hi[DSTDIM - 1] = run_hi;
+          from.ptr(ps_hi);
+          to.ptr(pd_hi);
+        }
+        std::memcpy(
+          to.ptr(*pd),
+          from.ptr(ps),
+          (run_hi - run_lo + 1) * sizeof(T));
+      }
+    } else {
+      for (PointInRectIterator<DSTDIM> pd(rect, false); pd(); pd++) {
+        size_t i = SRCDIM - 1;
+        size_t j = DSTDIM - 1;
+        while (i >= ROWDIM)
+          ps[i--] = pd[j--];
+        to[*pd] = from[ps];
+      }
+    }
+  }
+}
 
 template <hyperion::TypeTag DT>
 static void
@@ -964,28 +1049,15 @@ reindex_copy_values(
 
   switch ((rowdim * LEGION_MAX_DIM + srcdim) * LEGION_MAX_DIM + dstdim) {
 #define CPY(ROWDIM,SRCDIM,DSTDIM)                                       \
-    case ((ROWDIM * LEGION_MAX_DIM + SRCDIM) * LEGION_MAX_DIM + DSTDIM): { \
-      const SA<DT,SRCDIM> from(src_pr, val_fid);                        \
-      const RA<DSTDIM,ROWDIM> rct(rect_pr, ColumnSpace::REINDEXED_ROW_RECTS_FID); \
-      const DA<DT,DSTDIM> to(dst_pr, val_fid);                          \
-      for (PointInDomainIterator<ROWDIM> row(                           \
-             rt->get_index_space_domain(rect_req.region.get_index_space()), \
-             false);                                                    \
-           row();                                                       \
-           ++row) {                                                     \
-        Point<SRCDIM> ps;                                               \
-        for (size_t i = 0; i < ROWDIM; ++i)                             \
-          ps[i] = row[i];                                               \
-        for (PointInRectIterator<DSTDIM> pd(rct[*row], false); pd(); pd++) { \
-          size_t i = SRCDIM - 1;                                        \
-          size_t j = DSTDIM - 1;                                        \
-          while (i >= ROWDIM)                                           \
-            ps[i--] = pd[j--];                                          \
-          to[*pd] = from[ps];                                           \
-        }                                                               \
-      }                                                                 \
-      break;                                                            \
-    }
+    case ((ROWDIM * LEGION_MAX_DIM + SRCDIM) * LEGION_MAX_DIM + DSTDIM): \
+      reindex_copy_rows<DT,ROWDIM,SRCDIM,DSTDIM>(                       \
+        rt,                                                             \
+        val_fid,                                                        \
+        rect_req,                                                       \
+        rect_pr,                                                        \
+        src_pr,                                                         \
+        dst_pr);                                                        \
+      break;
     HYPERION_FOREACH_LMN(CPY)
 #undef CPY
     default:
@@ -1001,6 +1073,9 @@ PhysicalTable::reindex_copy_values_task(
   Context ctx,
   Runtime *rt) {
 
+  Instrumentation::Scope scope(task);
+  scope.add_region_bytes(rt, task->regions);
+
   const ReindexCopyValuesTaskArgs* args =
     static_cast<const ReindexCopyValuesTaskArgs*>(task->args);
 
@@ -1468,7 +1543,8 @@ PhysicalTable::attach_columns(
   const CXX_FILESYSTEM_NAMESPACE::path& file_path,
   const std::unordered_map<std::string, std::string>& column_paths,
   const std::unordered_map<std::string, std::tuple<bool, bool, bool>>&
-  column_modes) {
+  column_modes,
+  bool zero_copy) {
 
   std::map<
     std::tuple<LogicalRegion, std::tuple<bool, bool, bool>>,
@@ -1494,9 +1570,63 @@ PhysicalTable::attach_columns(
       regions[key].emplace_back(pc->fid(), nm);
     }
   }
+#ifdef HYPERION_USE_HDF5
+  // attach read-only columns directly to the file data when possible, leaving
+  // the remaining columns in "regions"; the file must be closed again before
+  // any HDF5 attachments are made
+  std::shared_ptr<hdf5::FileMap> file_map;
+  if (zero_copy)
+    file_map = hdf5::FileMap::open(file_path);
+  if (file_map) {
+    const Memory sysmem =
+      Machine::MemoryQuery(Machine::get_machine())
+      .has_affinity_to(rt->get_executing_processor(ctx))
+      .only_kind(Memory::SYSTEM_MEM)
+      .first();
+    hid_t file_id =
+      CHECK_H5(H5Fopen(file_path.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT));
+    for (auto& parent_modes_fid_nms : regions) {
+      auto& parent = std::get<0>(std::get<0>(parent_modes_fid_nms));
+      auto& modes = std::get<1>(std::get<0>(parent_modes_fid_nms));
+      auto& fid_nms = std::get<1>(parent_modes_fid_nms);
+      if (!std::get<0>(modes))
+        continue;
+      for (auto fid_nm = fid_nms.begin(); fid_nm != fid_nms.end();) {
+        auto& fid = std::get<0>(*fid_nm);
+        auto& nm = std::get<1>(*fid_nm);
+        auto pr =
+          hdf5::attach_mapped_dataset(
+            ctx,
+            rt,
+            *file_map,
+            file_id,
+            column_paths.at(nm),
+            m_columns.at(nm)->values_lr(),
+            parent,
+            fid,
+            m_columns.at(nm)->dt(),
+            sysmem,
+            std::get<1>(modes),
+            std::get<2>(modes));
+        if (pr) {
+          m_columns.at(nm)->m_values = pr.value();
+          m_attached[nm] = pr.value();
+          m_deferred.erase(nm);
+          m_file_maps[nm] = file_map;
+          fid_nm = fid_nms.erase(fid_nm);
+        } else {
+          ++fid_nm;
+        }
+      }
+    }
+    CHECK_H5(H5Fclose(file_id));
+  }
+#endif // HYPERION_USE_HDF5
   for (auto& parent_modes_fid_nms : regions) {
     auto& parent_modes = std::get<0>(parent_modes_fid_nms);
     auto& fid_nms= std::get<1>(parent_modes_fid_nms);
+    if (fid_nms.size() == 0)
+      continue;
     std::map<FieldID, const char*> field_map;
     for (auto& fid_nm : fid_nms) {
       auto& fid = std::get<0>(fid_nm);
@@ -1519,11 +1649,93 @@ PhysicalTable::attach_columns(
       auto& nm = std::get<1>(fid_nm);
       m_columns.at(nm)->m_values = pr1;
       m_attached[nm] = pr1;
+      m_deferred.erase(nm);
     }
   }
   return true;
 }
 
+bool
+PhysicalTable::defer_attach_columns(
+  const CXX_FILESYSTEM_NAMESPACE::path& file_path,
+  const std::unordered_map<std::string, std::string>& column_paths,
+  const std::unordered_map<std::string, std::tuple<bool, bool, bool>>&
+  column_modes,
+  bool zero_copy) {
+
+  for (auto& nm_pth : column_paths) {
+    auto& nm = std::get<0>(nm_pth);
+    if (m_columns.count(nm) > 0) {
+      if (column_modes.count(nm) == 0) {
+        // FIXME: log warning message: missing column mode
+        return false;
+      }
+      if (m_attached.count(nm) > 0) {
+        // FIXME: log warning message: column is already attached
+        return false;
+      }
+    }
+  }
+  for (auto& nm_pth : column_paths) {
+    auto& nm = std::get<0>(nm_pth);
+    if (m_columns.count(nm) > 0)
+      m_deferred[nm] =
+        std::make_tuple(
+          file_path,
+          std::get<1>(nm_pth),
+          column_modes.at(nm),
+          zero_copy);
+  }
+  return true;
+}
+
+bool
+PhysicalTable::attach_deferred_columns(
+  Context ctx,
+  Runtime* rt,
+  const std::unordered_set<std::string>& columns) {
+
+  // attach_columns() takes a single file path and zero_copy flag, so group the
+  // columns by both
+  std::map<
+    std::tuple<std::string, bool>,
+    std::tuple<
+      std::unordered_map<std::string, std::string>,
+      std::unordered_map<std::string, std::tuple<bool, bool, bool>>>>
+    by_file;
+  for (auto& nm : columns) {
+    if (m_deferred.count(nm) > 0) {
+      auto& file_path = std::get<0>(m_deferred.at(nm));
+      auto& paths_modes =
+        by_file[{file_path.string(), std::get<3>(m_deferred.at(nm))}];
+      std::get<0>(paths_modes)[nm] = std::get<1>(m_deferred.at(nm));
+      std::get<1>(paths_modes)[nm] = std::get<2>(m_deferred.at(nm));
+    }
+  }
+  bool result = true;
+  for (auto& fz_pms : by_file) {
+    auto& file_path = std::get<0>(std::get<0>(fz_pms));
+    auto& zero_copy = std::get<1>(std::get<0>(fz_pms));
+    auto& paths = std::get<0>(std::get<1>(fz_pms));
+    auto& modes = std::get<1>(std::get<1>(fz_pms));
+    if (attach_columns(ctx, rt, file_path, paths, modes, zero_copy)) {
+      for (auto& nm_pth : paths)
+        m_deferred.erase(std::get<0>(nm_pth));
+    } else {
+      result = false;
+    }
+  }
+  return result;
+}
+
+std::unordered_set<std::string>
+PhysicalTable::deferred_columns() const {
+  std::unordered_set<std::string> result;
+  for (auto& nm_d : m_deferred)
+    result.insert(std::get<0>(nm_d));
+  return result;
+}
+
 void
 PhysicalTable::detach_columns(
   Context ctx,
@@ -1538,16 +1750,21 @@ PhysicalTable::detach_columns(
       PhysicalRegion pr = m_attached.at(nm);
       m_columns.at(nm)->m_values = CXX_OPTIONAL_NAMESPACE::nullopt;
       if (detached.count(pr) == 0) {
-        rt->detach_external_resource(ctx, pr);
+        auto f = rt->detach_external_resource(ctx, pr);
+        // a file map may only be released once the detachment is complete
+        if (m_file_maps.count(nm) > 0)
+          f.wait();
         detached.insert(pr);
       }
     }
   }
   for (auto it = m_attached.begin(); it != m_attached.end();) {
-    if (detached.count(it->second) > 0)
+    if (detached.count(it->second) > 0) {
+      m_file_maps.erase(it->first);
       it = m_attached.erase(it);
-    else
+    } else {
       ++it;
+    }
   }
 }
 
@@ -1582,6 +1799,9 @@ PhysicalTable::preregister_tasks() {
   {
     // reindex_copy_values_task
     reindex_copy_values_task_id = Runtime::generate_static_task_id();
+    Instrumentation::register_task(
+      reindex_copy_values_task_id,
+      reindex_copy_values_task_name);
     TaskVariantRegistrar
       registrar(reindex_copy_values_task_id, reindex_copy_values_task_name);
     registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
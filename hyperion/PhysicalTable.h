@@ -28,6 +28,10 @@
 
 namespace hyperion {
 
+namespace hdf5 {
+class FileMap;
+}
+
 class HYPERION_EXPORT PhysicalTable {
 public:
 
@@ -216,7 +220,10 @@ public:
     return reindexed(ctx, rt, iax, allow_rows);
   }
 
-  // boolean values in 'column_modes': (read-only, restricted, mapped)
+  // boolean values in 'column_modes': (read-only, restricted, mapped); when
+  // 'zero_copy' is true, read-only columns with contiguous datasets are
+  // attached directly to a memory map of the file, and all other columns are
+  // attached through HDF5
   bool
   attach_columns(
     Legion::Context ctx,
@@ -224,7 +231,30 @@ public:
     const CXX_FILESYSTEM_NAMESPACE::path& file_path,
     const std::unordered_map<std::string, std::string>& column_paths,
     const std::unordered_map<std::string, std::tuple<bool, bool, bool>>&
-    column_modes);
+    column_modes,
+    bool zero_copy = false);
+
+  // record the attachment parameters of columns to be attached later, by
+  // attach_deferred_columns(); values in 'column_modes' and 'zero_copy' are as
+  // for attach_columns()
+  bool
+  defer_attach_columns(
+    const CXX_FILESYSTEM_NAMESPACE::path& file_path,
+    const std::unordered_map<std::string, std::string>& column_paths,
+    const std::unordered_map<std::string, std::tuple<bool, bool, bool>>&
+    column_modes,
+    bool zero_copy = false);
+
+  // attach those named columns whose attachment was deferred; columns that
+  // are already attached, or were never deferred, are ignored
+  bool
+  attach_deferred_columns(
+    Legion::Context ctx,
+    Legion::Runtime* rt,
+    const std::unordered_set<std::string>& columns);
+
+  std::unordered_set<std::string>
+  deferred_columns() const;
 
   void
   detach_columns(
@@ -268,6 +298,17 @@ protected:
 
   std::unordered_map<std::string, Legion::PhysicalRegion> m_attached;
 
+  std::unordered_map<
+    std::string,
+    std::tuple<
+      CXX_FILESYSTEM_NAMESPACE::path,
+      std::string,
+      std::tuple<bool, bool, bool>,
+      bool>> m_deferred;
+
+  // file maps of columns attached with zero_copy
+  std::unordered_map<std::string, std::shared_ptr<hdf5::FileMap>> m_file_maps;
+
   std::unordered_map<std::string, Column>
   get_columns() const;
 };
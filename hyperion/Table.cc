@@ -165,7 +165,10 @@ Table::attach_columns(
   const CXX_FILESYSTEM_NAMESPACE::path& file_path,
   const std::unordered_map<std::string, std::string>& column_paths,
   const std::unordered_map<std::string, std::tuple<bool, bool, bool>>&
-    column_modes) const {
+    column_modes,
+  const CXX_OPTIONAL_NAMESPACE::optional<std::unordered_set<std::string>>&
+    projection,
+  bool zero_copy) const {
 
   std::unordered_set<std::string> colnames;
   for (auto& nm_pth : column_paths) {
@@ -280,7 +283,37 @@ Table::attach_columns(
     index_col,
     table_reqs[1].parent,
     pcols);
-  result.attach_columns(ctx, rt, file_path, column_paths, column_modes);
+  if (projection) {
+    std::unordered_map<std::string, std::string> attach_paths;
+    std::unordered_map<std::string, std::string> defer_paths;
+    for (auto& nm_pth : column_paths) {
+      auto& nm = std::get<0>(nm_pth);
+      if (projection.value().count(nm) > 0)
+        attach_paths.insert(nm_pth);
+      else if (colnames.count(nm) > 0)
+        defer_paths.insert(nm_pth);
+    }
+    result.attach_columns(
+      ctx,
+      rt,
+      file_path,
+      attach_paths,
+      column_modes,
+      zero_copy);
+    result.defer_attach_columns(
+      file_path,
+      defer_paths,
+      column_modes,
+      zero_copy);
+  } else {
+    result.attach_columns(
+      ctx,
+      rt,
+      file_path,
+      column_paths,
+      column_modes,
+      zero_copy);
+  }
   for (auto& p : table_parts)
     p.destroy(ctx, rt);
   return result;
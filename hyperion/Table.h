@@ -343,7 +343,11 @@ public:
     return m_columns;
   }
 
-  // boolean values in 'column_modes': (read-only, restricted, mapped)
+  // boolean values in 'column_modes': (read-only, restricted, mapped);
+  // when 'projection' has a value, only the columns it names are attached
+  // immediately, and the attachment of the other columns with paths and modes
+  // is deferred (see PhysicalTable::attach_deferred_columns()); 'zero_copy' is
+  // as for PhysicalTable::attach_columns()
   PhysicalTable
   attach_columns(
     Legion::Context ctx,
@@ -351,7 +355,10 @@ public:
     const CXX_FILESYSTEM_NAMESPACE::path& file_path,
     const std::unordered_map<std::string, std::string>& column_paths,
     const std::unordered_map<std::string, std::tuple<bool, bool, bool>>&
-      column_modes) const;
+      column_modes,
+    const CXX_OPTIONAL_NAMESPACE::optional<std::unordered_set<std::string>>&
+      projection = CXX_OPTIONAL_NAMESPACE::nullopt,
+    bool zero_copy = false) const;
 
   PhysicalTable
   map_inline(
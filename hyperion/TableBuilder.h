@@ -31,8 +31,11 @@
 #include <algorithm>
 #include CXX_ANY_HEADER
 #include <cassert>
+#include <deque>
 #include <functional>
+#include <future>
 #include <memory>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -198,7 +201,8 @@ protected:
         if (std::count(rsh.begin(), rsh.end(), 0) == 0)
           shape = rsh;
       }
-    } else {
+    } else if (!sa.shape.empty()
+               && std::count(sa.shape.begin(), sa.shape.end(), 0) == 0) {
       shape = sa.shape;
     }
     if (shape) {
@@ -297,6 +301,63 @@ protected:
     return result;
   }
 
+  // add all rows of a column with elements of varying shape
+  static void
+  add_scanned_rows(
+    const casacore::Table& table,
+    const std::string& nm,
+    ColumnBuilder<D>& col) {
+
+    // casacore is not thread-safe, so the element shapes are read serially,
+    // but the index trees of blocks of rows are built concurrently, and then
+    // merged in row order
+    static const constexpr size_t block_size = 1 << 16;
+    const size_t max_pending =
+      std::max(std::thread::hardware_concurrency(), 1u);
+    casacore::TableColumn tcol(table, nm);
+    size_t nrow = table.nrow();
+    std::deque<std::tuple<size_t, std::future<IndexTreeL>>> pending;
+    for (size_t r0 = 0; r0 < nrow; r0 += block_size) {
+      size_t r1 = std::min(r0 + block_size, nrow);
+      std::vector<casacore::IPosition> shapes;
+      shapes.reserve(r1 - r0);
+      for (size_t r = r0; r < r1; ++r)
+        shapes.push_back(
+          tcol.hasContent(r) ? tcol.shape(r) : casacore::IPosition());
+      if (pending.size() == max_pending) {
+        col.add_rows(
+          std::get<0>(pending.front()),
+          std::get<1>(pending.front()).get());
+        pending.pop_front();
+      }
+      pending.emplace_back(
+        r1 - r0,
+        std::async(
+          std::launch::async,
+          [&col, shapes=std::move(shapes)]() {
+            // consecutive rows with equal element shapes form a single child
+            std::vector<
+              std::tuple<Legion::coord_t, Legion::coord_t, IndexTreeL>> ch;
+            for (size_t i = 0; i < shapes.size(); ++i) {
+              SizeArgs sa;
+              sa.shape = shapes[i];
+              auto t = col.element_tree(sa);
+              if (ch.size() > 0 && std::get<2>(ch.back()) == t)
+                ++std::get<1>(ch.back());
+              else
+                ch.emplace_back(i, 1, t);
+            }
+            return IndexTreeL(ch);
+          }));
+    }
+    while (pending.size() > 0) {
+      col.add_rows(
+        std::get<0>(pending.front()),
+        std::get<1>(pending.front()).get());
+      pending.pop_front();
+    }
+  }
+
   std::string m_name;
 
   std::unordered_map<std::string, std::shared_ptr<ColumnBuilder<D>>> m_columns;
@@ -406,30 +467,29 @@ public:
         }
       });
 
-    // scan rows to get shapes for all selected array columns
+    // build the index trees of all columns; the index tree of a column with a
+    // fixed element shape (which includes every scalar column) is built
+    // directly, independent of the number of rows, and only the rows of other
+    // columns are scanned
     //
-    std::unordered_map<std::string, CXX_ANY_NAMESPACE::any> args;
-    // local variable to hold row number, args values contain
-    // pointer to this variable
-    unsigned row;
-    std::transform(
-      array_names.begin(),
-      array_names.end(),
-      std::inserter(args, args.end()),
-      [&table, &tdesc, &row](auto& nm) {
+    size_t nrow = table.nrow();
+    for (auto& nm_col : result.m_columns) {
+      auto& nm = std::get<0>(nm_col);
+      auto& col = std::get<1>(nm_col);
+      if (array_names.count(nm) == 0) {
+        col->add_rows(nrow, IndexTreeL(nrow));
+      } else if (!tdesc[nm].shape().empty()) {
         SizeArgs sa;
-        sa.row = &row;
-        const casacore::IPosition& shp = tdesc[nm].shape();
-        if (shp.empty())
-          sa.tcol = std::make_shared<casacore::TableColumn>(table, nm);
-        else
-          sa.shape = shp;
-        return std::make_pair(nm, sa);
-      });
-
-    auto nrow = table.nrow();
-    for (row = 0; row < nrow; ++row)
-      result.add_row(args);
+        sa.shape = tdesc[nm].shape();
+        col->add_rows(
+          nrow,
+          IndexTreeL(
+            {{0, static_cast<Legion::coord_t>(nrow), col->element_tree(sa)}}));
+      } else {
+        add_scanned_rows(table, nm, *col);
+      }
+    }
+    result.m_num_rows = nrow;
 
     return result;
   }
@@ -21,10 +21,14 @@ using namespace Legion;
 
 static unsigned
 layout_index(const std::vector<RegionRequirement>& regions, unsigned idx) {
+  auto tag = TableMapper::layout_mapping_tag(regions[idx].tag);
+  return ((tag >= (1uL << TableMapper::layout_tag_shift)) ? tag : idx);
+}
+
+static bool
+is_numa_affine(const RegionRequirement& req) {
   return
-    ((regions[idx].tag >= (1uL << TableMapper::layout_tag_shift))
-     ? regions[idx].tag
-     : idx);
+    (TableMapper::placement_flags(req.tag) & TableMapper::numa_affine) != 0;
 }
 
 TableMapper::TableMapper(
@@ -35,6 +39,65 @@ TableMapper::TableMapper(
   : Mapping::DefaultMapper(rt->get_mapper_runtime(), machine, local, name, true) {
 }
 
+std::vector<std::tuple<std::string, LayoutConstraintID>>
+TableMapper::m_layouts;
+
+TableMapper::LayoutTag
+TableMapper::register_layout(const std::string& name, LayoutConstraintID id) {
+  auto ltag = layout_tag(name);
+  if (ltag)
+    return ltag.value();
+  assert(m_layouts.size() + 1 < (1u << layout_tag_bits) - 1);
+  m_layouts.emplace_back(name, id);
+  return static_cast<LayoutTag>(m_layouts.size());
+}
+
+CXX_OPTIONAL_NAMESPACE::optional<TableMapper::LayoutTag>
+TableMapper::layout_tag(const std::string& name) {
+  CXX_OPTIONAL_NAMESPACE::optional<LayoutTag> result;
+  for (size_t i = 0; !result && i < m_layouts.size(); ++i)
+    if (std::get<0>(m_layouts[i]) == name)
+      result = static_cast<LayoutTag>(i + 1);
+  return result;
+}
+
+TaskVariantRegistrar&
+TableMapper::add_layouts(TaskVariantRegistrar& registrar) {
+  for (size_t i = 0; i < m_layouts.size(); ++i)
+    registrar.add_layout_constraint_set(
+      to_mapping_tag(static_cast<LayoutTag>(i + 1)),
+      std::get<1>(m_layouts[i]));
+  return registrar;
+}
+
+Memory
+TableMapper::numa_affine_memory(Processor proc) {
+  auto mem = m_numa_affine_memories.find(proc);
+  if (mem == m_numa_affine_memories.end()) {
+    Memory result = Memory::NO_MEMORY;
+    switch (proc.kind()) {
+    case Processor::LOC_PROC:
+    case Processor::IO_PROC:
+    case Processor::PROC_SET:
+    case Processor::OMP_PROC:
+    case Processor::PY_PROC:
+      for (auto& kind : {Memory::SOCKET_MEM, Memory::SYSTEM_MEM}) {
+        Machine::MemoryQuery memories(machine);
+        memories.only_kind(kind).best_affinity_to(proc);
+        if (memories.count() > 0) {
+          result = memories.first();
+          break;
+        }
+      }
+      break;
+    default:
+      break;
+    }
+    mem = m_numa_affine_memories.emplace(proc, result).first;
+  }
+  return mem->second;
+}
+
 void
 TableMapper::premap_task(
   const Mapping::MapperContext ctx,
@@ -225,6 +288,11 @@ TableMapper::premap_task(
     case Processor::PROC_SET:
     case Processor::OMP_PROC:
     case Processor::PY_PROC: {
+      if (is_numa_affine(task.regions[it->first])) {
+        target_memory = numa_affine_memory(task.target_proc);
+        if (target_memory.exists())
+          break;
+      }
       visible_memories.only_kind(Memory::SYSTEM_MEM);
       if (visible_memories.count() == 0) {
         std::cerr
@@ -469,11 +537,15 @@ TableMapper::map_task(
         missing_fields[idx].empty())
       continue;
     // See if this is a reduction
+    const bool numa_affine = is_numa_affine(task.regions[idx]);
     Memory target_memory =
-      default_policy_select_target_memory(
-        ctx,
-        task.target_proc,
-        task.regions[idx]);
+      numa_affine ? numa_affine_memory(task.target_proc) : Memory::NO_MEMORY;
+    if (!target_memory.exists())
+      target_memory =
+        default_policy_select_target_memory(
+          ctx,
+          task.target_proc,
+          task.regions[idx]);
     if (task.regions[idx].privilege == LEGION_REDUCE) {
       size_t footprint;
       if (!default_create_custom_instances(
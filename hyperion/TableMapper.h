@@ -45,12 +45,76 @@ public:
 
   typedef unsigned LayoutTag;
 
+  // layout of the default_column_layout_tag is chosen by each task variant
   static const constexpr LayoutTag default_column_layout_tag = 0;
 
+  // named layouts, registered by hyperion::preregister_all(); tasks that add
+  // the registered layouts to their variants with add_layouts() may request
+  // any of these layouts for a region by setting the RegionRequirement tag to
+  // the value of to_mapping_tag() for the layout tag
+  static const constexpr LayoutTag soa_right_layout_tag = 1;
+  static const constexpr LayoutTag soa_left_layout_tag = 2;
+  static const constexpr LayoutTag aos_right_layout_tag = 3;
+  static const constexpr LayoutTag aos_left_layout_tag = 4;
+
+  /**
+   * Register a named layout
+   *
+   * Must be called before task variant registration (i.e, before the Legion
+   * runtime is started). Returns the layout tag assigned to the layout; a
+   * name that has already been registered retains its existing tag.
+   */
+  static LayoutTag
+  register_layout(const std::string& name, Legion::LayoutConstraintID id);
+
+  /**
+   * Layout tag of a named layout
+   */
+  static CXX_OPTIONAL_NAMESPACE::optional<LayoutTag>
+  layout_tag(const std::string& name);
+
+  /**
+   * Add layout constraint sets for all registered layouts to a task variant
+   * registrar
+   */
+  static Legion::TaskVariantRegistrar&
+  add_layouts(Legion::TaskVariantRegistrar& registrar);
+
+  // TableMapper placement flags saved to RegionRequirement are in a bitfield
+  // left shifted by "placement_flags_shift" bits, above the layout tag bits;
+  // these flags are not part of the layout tag id
+  static const constexpr unsigned placement_flags_shift =
+    layout_tag_shift + layout_tag_bits;
+
+  typedef enum {
+    // place instances in the memory nearest the processor of each task (or
+    // index task point), preferring SOCKET_MEM to SYSTEM_MEM; set by row block
+    // index launches (e.g, TableReadTask and the gridder tasks on MAIN table
+    // row blocks)
+    numa_affine = 1,
+  } PlacementFlag;
+
+  static constexpr Legion::MappingTagID
+  to_mapping_tag(
+    LayoutTag ltag,
+    unsigned flags = 0,
+    unsigned pflags = 0) {
+    return
+      (static_cast<Legion::MappingTagID>(pflags) << placement_flags_shift)
+      | (static_cast<Legion::MappingTagID>(ltag + 1) << layout_tag_shift)
+      | flags;
+  }
+
+  static constexpr unsigned
+  placement_flags(Legion::MappingTagID tag) {
+    return static_cast<unsigned>(tag >> placement_flags_shift);
+  }
+
   static constexpr Legion::MappingTagID
-  to_mapping_tag(LayoutTag ltag, unsigned flags = 0) {
+  layout_mapping_tag(Legion::MappingTagID tag) {
     return
-      (static_cast<Legion::MappingTagID>(ltag + 1) << layout_tag_shift) | flags;
+      tag
+      & ((static_cast<Legion::MappingTagID>(1) << placement_flags_shift) - 1);
   }
 
   virtual void
@@ -67,6 +131,20 @@ public:
     const Legion::Mapping::Mapper::MapTaskInput& input,
     Legion::Mapping::Mapper::MapTaskOutput& output) override;
 
+protected:
+
+  // memory with best affinity to "proc" for instances of a region with
+  // placement flag "numa_affine", or Memory::NO_MEMORY if no such memory exists
+  Legion::Memory
+  numa_affine_memory(Legion::Processor proc);
+
+  std::map<Legion::Processor, Legion::Memory> m_numa_affine_memories;
+
+private:
+
+  // named layouts, indexed by (layout tag - 1)
+  static std::vector<std::tuple<std::string, Legion::LayoutConstraintID>>
+  m_layouts;
 };
 
 } // end namespace hyperion
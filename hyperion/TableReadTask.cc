@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <hyperion/TableReadTask.h>
+#include <hyperion/Instrumentation.h>
 #include <hyperion/PhysicalTable.h>
 #include <hyperion/PhysicalColumn.h>
 #include <hyperion/TableMapper.h>
@@ -27,6 +28,34 @@ using namespace hyperion;
 
 using namespace Legion;
 
+// values of types for which this is true can be copied directly between
+// casacore and Legion buffers
+template <hyperion::TypeTag DT>
+struct casacore_layout_compatible
+  : public std::integral_constant<
+      bool,
+      (std::is_arithmetic<typename DataType<DT>::CasacoreType>::value
+       || DT == HYPERION_TYPE_COMPLEX
+       || DT == HYPERION_TYPE_DCOMPLEX)
+      && (sizeof(typename DataType<DT>::ValueType)
+          == sizeof(typename DataType<DT>::CasacoreType))> {};
+
+// pointer to values in "rect", when those values are contiguous in row-major
+// order; otherwise, nullptr
+template <typename T, unsigned DIM, typename A>
+static T*
+dense_row_major_ptr(const A& values, const Rect<DIM>& rect) {
+  size_t strides[DIM];
+  T* result = values.ptr(rect, strides);
+  size_t stride = 1;
+  for (int i = DIM - 1; i >= 0; --i) {
+    if (strides[i] != stride && rect.hi[i] > rect.lo[i])
+      return nullptr;
+    stride *= rect.hi[i] - rect.lo[i] + 1;
+  }
+  return result;
+}
+
 template <hyperion::TypeTag DT, unsigned DIM>
 static void
 read_scalar_column(
@@ -34,11 +63,41 @@ read_scalar_column(
   const casacore::ColumnDesc& col_desc,
   const PhysicalColumnTD<DT, 1, DIM, AffineAccessor>& column) {
 
+  typedef typename DataType<DT>::ValueType VT;
   typedef typename DataType<DT>::CasacoreType CT;
 
   auto values = column.template accessor<WRITE_ONLY>();
 
   casacore::ScalarColumn<CT> col(table, col_desc.name());
+
+  // read all rows with a single call when the rows are contiguous
+  if (DIM == 1 && column.domain().dense()) {
+    const Rect<DIM> rect = column.rect();
+    if (rect.empty())
+      return;
+    const casacore::Slicer rows(
+      casacore::IPosition(1, rect.lo[0]),
+      casacore::IPosition(1, rect.hi[0] - rect.lo[0] + 1));
+    VT* buffer =
+      (casacore_layout_compatible<DT>::value
+       ? dense_row_major_ptr<VT, DIM>(values, rect)
+       : nullptr);
+    if (buffer != nullptr) {
+      // read directly into the region instance
+      casacore::Vector<CT> vec(
+        casacore::IPosition(1, rect.hi[0] - rect.lo[0] + 1),
+        reinterpret_cast<CT*>(buffer),
+        casacore::SHARE);
+      col.getColumnRange(rows, vec);
+    } else {
+      casacore::Vector<CT> vec = col.getColumnRange(rows);
+      size_t i = 0;
+      for (PointInRectIterator<DIM> pir(rect, false); pir(); pir++, i++)
+        DataType<DT>::from_casacore(values[*pir], vec[i]);
+    }
+    return;
+  }
+
   coord_t row_number;
   CT col_value;
   {
@@ -68,6 +127,59 @@ read_array_column(
   auto values = column.template accessor<WRITE_ONLY>();
 
   casacore::ArrayColumn<CT> col(table, col_desc.name());
+
+  // read all rows with a single call when the rows are contiguous, and every
+  // row has the same cell shape, which covers the column domain
+  if (column.domain().dense()) {
+    const Rect<DIM> rect = column.rect();
+    if (rect.empty())
+      return;
+    const coord_t num_rows = rect.hi[0] - rect.lo[0] + 1;
+    const casacore::IPosition cell_shape = col.shape(rect.lo[0]);
+    // casacore array axis i corresponds to Legion index space dimension
+    // DIM - i - 1
+    bool full_cells = cell_shape.size() == DIM - 1;
+    for (unsigned i = 0; full_cells && i < DIM - 1; ++i)
+      full_cells =
+        rect.lo[DIM - i - 1] == 0
+        && rect.hi[DIM - i - 1] + 1 == cell_shape[i];
+    if (full_cells) {
+      const casacore::Slicer rows(
+        casacore::IPosition(1, rect.lo[0]),
+        casacore::IPosition(1, num_rows));
+      casacore::IPosition shape(DIM);
+      for (unsigned i = 0; i < DIM - 1; ++i)
+        shape[i] = cell_shape[i];
+      shape[DIM - 1] = num_rows;
+      // the casacore array, in column-major order, has the same element order
+      // as the Legion rect, in row-major order
+      typename DataType<DT>::ValueType* buffer =
+        (casacore_layout_compatible<DT>::value
+         ? dense_row_major_ptr<typename DataType<DT>::ValueType, DIM>(
+           values,
+           rect)
+         : nullptr);
+      if (buffer != nullptr) {
+        // read directly into the region instance
+        casacore::Array<CT> arr(
+          shape,
+          reinterpret_cast<CT*>(buffer),
+          casacore::SHARE);
+        col.getColumnRange(rows, arr);
+      } else {
+        casacore::Array<CT> arr(shape);
+        col.getColumnRange(rows, arr);
+        bool delete_storage;
+        const CT* storage = arr.getStorage(delete_storage);
+        size_t i = 0;
+        for (PointInRectIterator<DIM> pir(rect, false); pir(); pir++, i++)
+          DataType<DT>::from_casacore(values[*pir], storage[i]);
+        arr.freeStorage(storage, delete_storage);
+      }
+      return;
+    }
+  }
+
   coord_t row_number;
   unsigned array_cell_rank;
   {
@@ -182,12 +294,14 @@ void
 TableReadTask::preregister_tasks() {
   {
     TASK_ID = Runtime::generate_static_task_id();
+    Instrumentation::register_task(TASK_ID, TASK_NAME);
     TaskVariantRegistrar registrar(TASK_ID, TASK_NAME);
     registrar.add_constraint(ProcessorConstraint(Processor::IO_PROC));
     registrar.set_leaf();
     registrar.add_layout_constraint_set(
       TableMapper::to_mapping_tag(TableMapper::default_column_layout_tag),
       soa_right_layout);
+    TableMapper::add_layouts(registrar);
     Runtime::preregister_task_variant<impl>(registrar, TASK_NAME);
   }
 }
@@ -199,6 +313,9 @@ TableReadTask::impl(
   Context ctx,
   Runtime *rt) {
 
+  Instrumentation::Scope scope(task);
+  scope.add_region_bytes(rt, task->regions);
+
   const Args* args = static_cast<const Args*>(task->args);
 
   auto ptcr =
@@ -224,6 +341,7 @@ TableReadTask::impl(
     casacore::TableLock::PermanentLockingWait);
   auto tdesc = cctable.tableDesc();
 
+  size_t num_rows = 0;
   for (auto& nm_column : table.columns()) {
 #if HAVE_CXX17
     auto& [nm, column] = nm_column;
@@ -232,6 +350,11 @@ TableReadTask::impl(
     auto& column = std::get<1>(nm_column);
 #endif // HAVE_CXX17
     if (nm != "") {
+      if (scope.active() && column->domain().get_dim() > 0) {
+        auto dom = column->domain();
+        num_rows =
+          std::max(num_rows, (size_t)(dom.hi()[0] - dom.lo()[0] + 1));
+      }
       switch (column->domain().get_dim()) {
       case 0: // for index column space
         break;
@@ -257,16 +380,25 @@ TableReadTask::impl(
       }
     }
   }
+  scope.add_rows(num_rows);
 }
 
+// column requirements for reading into a table; when the table is read in row
+// blocks, each block's instances are placed in the memory nearest the
+// processor that reads the block
 static Column::Requirements
-column_reqs(PrivilegeMode privilege) {
+column_reqs(PrivilegeMode privilege, const ColumnSpacePartition& partition) {
   return Column::Requirements{
     Column::Req{privilege, EXCLUSIVE, true},
     Column::default_requirements.keywords,
     Column::default_requirements.measref,
     Column::default_requirements.column_space,
-    Column::default_requirements.tag};
+    (partition.is_valid()
+     ? TableMapper::to_mapping_tag(
+       TableMapper::default_column_layout_tag,
+       0,
+       TableMapper::numa_affine)
+     : Column::default_requirements.tag)};
 };
 
 std::tuple<
@@ -291,7 +423,7 @@ TableReadTask::requirements(
       rt,
       table_partition,
       {},
-      column_reqs(columns_privilege));
+      column_reqs(columns_privilege, table_partition));
 }
 
 std::tuple<
@@ -316,7 +448,7 @@ TableReadTask::requirements(
       rt,
       table_partition,
       {},
-      column_reqs(columns_privilege));
+      column_reqs(columns_privilege, table_partition));
 }
 
 // Local Variables:
@@ -0,0 +1,551 @@
+/*
+ * Copyright 2020 Associated Universities, Inc. Washington DC, USA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <hyperion/synthesis/PSTermTable.h>
+#include <hyperion/synthesis/WTermTable.h>
+#include <hyperion/synthesis/ATermTable.h>
+#include <hyperion/synthesis/ProductCFTable.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <casacore/coordinates/Coordinates/LinearCoordinate.h>
+
+using namespace hyperion::synthesis;
+using namespace hyperion;
+using namespace Legion;
+
+namespace cc = casacore;
+
+// Benchmarks of convolution function computation
+//
+// For every combination of the values of the swept parameters (CF grid size,
+// oversampling factor, number of W planes, parallactic angle bins, frequencies
+// and Stokes values), the following operations are timed separately: PS term,
+// W term and A term CF computation, the product of the A, W and PS terms, and
+// the FFT of the CFs after zero-padding by the oversampling factor. Results,
+// including kernel and (nominal) floating point operation rates, are written
+// in CSV or JSON format.
+//
+// The variants of the CF tasks that are executed are chosen by the mapper
+// according to the available processor kinds; to compare the Kokkos Serial and
+// OpenMP backends, run the benchmark with and without OpenMP processors (for
+// example, "-ll:ocpu 1" vs "-ll:ocpu 0"). The backend is reported in the
+// results.
+
+enum {
+  CFBENCH_TASK_ID
+};
+
+#define CF_TABLE_AXES \
+  CF_BASELINE_CLASS, CF_PARALLACTIC_ANGLE, CF_FREQUENCY, CF_W, CF_STOKES_OUT, CF_STOKES_IN
+
+static const char* grid_size_flag = "--grid-size";
+static const char* oversampling_flag = "--oversampling";
+static const char* w_planes_flag = "--w-planes";
+static const char* pa_bins_flag = "--pa-bins";
+static const char* frequencies_flag = "--frequencies";
+static const char* stokes_flag = "--stokes";
+static const char* repeat_flag = "--repeat";
+static const char* format_flag = "--format";
+static const char* output_flag = "--output";
+
+// radius of the CF domain in the image plane (radians)
+static const double image_radius = 0.02;
+
+// maximum W value (wavelengths)
+static const double w_max = 1.0e4;
+
+// Nominal floating point operation counts, per CF element, of the CF
+// computations. These are meant for comparison of CF costs with gridding costs,
+// not as exact counts.
+//
+// PS term: rational approximation of the prolate spheroidal function
+static const double ps_flops = 40.0;
+// W term: square root and complex exponential
+static const double w_flops = 30.0;
+// A term: Zernike polynomial expansion (complex multiply-add per term), and
+// product of Jones elements for a Stokes pair
+static const double a_flops =
+  8.0 * (zernike_index(zernike_max_order::value, zernike_max_order::value) + 1)
+  + 12.0;
+// product: two complex multiplications (W and PS terms) in both the value and
+// weight columns
+static const double product_flops = 2 * 2 * 6.0;
+
+struct BenchArgs {
+  std::vector<size_t> grid_size{32, 64};
+  std::vector<size_t> oversampling{8};
+  std::vector<size_t> w_planes{1, 16};
+  std::vector<size_t> pa_bins{1, 8};
+  std::vector<size_t> frequencies{1};
+  std::vector<size_t> stokes{1, 4};
+  unsigned repeat = 1;
+  bool json = false;
+  std::string output;
+};
+
+struct BenchConfig {
+  size_t grid_size;
+  size_t oversampling;
+  size_t w_planes;
+  size_t pa_bins;
+  size_t frequencies;
+  size_t stokes;
+};
+
+struct BenchResult {
+  std::string name;
+  BenchConfig config;
+  unsigned iteration;
+  size_t kernels;
+  double flops;
+  double seconds;
+};
+
+static void
+usage() {
+  std::cerr
+    << "usage: cfbench [OPTION...]\n"
+    << "  (every option value is a comma-separated list of values to sweep)\n"
+    << "  --grid-size N       CF grid size (image domain)\n"
+    << "  --oversampling N    uv domain oversampling factor\n"
+    << "  --w-planes N        number of W planes\n"
+    << "  --pa-bins N         number of parallactic angle bins\n"
+    << "  --frequencies N     number of frequencies\n"
+    << "  --stokes N          number of Stokes values (1, 2 or 4) for each of\n"
+    << "                      the A term input and output Stokes axes\n"
+    << "  --repeat N          number of iterations of all benchmarks\n"
+    << "  --format FMT        output format, 'csv' (default) or 'json'\n"
+    << "  --output PATH       output file path (default: standard output)\n";
+}
+
+static bool
+get_unsigned(const char* flag, const std::string& arg, size_t& val) {
+  char* end;
+  auto v = std::strtoul(arg.c_str(), &end, 10);
+  if (arg.empty() || *end != '\0' || v == 0) {
+    std::cerr << "Invalid " << flag << " value '" << arg << "'" << std::endl;
+    return false;
+  }
+  val = v;
+  return true;
+}
+
+static bool
+get_list(const char* flag, const char* arg, std::vector<size_t>& vals) {
+  vals.clear();
+  std::istringstream iss(arg);
+  std::string s;
+  bool result = true;
+  while (result && std::getline(iss, s, ',')) {
+    size_t v;
+    result = get_unsigned(flag, s, v);
+    if (result)
+      vals.push_back(v);
+  }
+  return result && vals.size() > 0;
+}
+
+static bool
+get_args(const InputArgs& args, BenchArgs& bench_args) {
+  bool result = true;
+  for (int i = 1; result && i < args.argc; ++i) {
+    std::string flag = args.argv[i];
+    if (flag.substr(0, 2) != "--")
+      continue;
+    if (i == args.argc - 1)
+      break;
+    const char* arg = args.argv[++i];
+    if (flag == grid_size_flag) {
+      result = get_list(grid_size_flag, arg, bench_args.grid_size);
+    } else if (flag == oversampling_flag) {
+      result = get_list(oversampling_flag, arg, bench_args.oversampling);
+    } else if (flag == w_planes_flag) {
+      result = get_list(w_planes_flag, arg, bench_args.w_planes);
+    } else if (flag == pa_bins_flag) {
+      result = get_list(pa_bins_flag, arg, bench_args.pa_bins);
+    } else if (flag == frequencies_flag) {
+      result = get_list(frequencies_flag, arg, bench_args.frequencies);
+    } else if (flag == stokes_flag) {
+      result = get_list(stokes_flag, arg, bench_args.stokes);
+      for (auto& s : bench_args.stokes)
+        result = result && s <= 4 && s != 3;
+    } else if (flag == repeat_flag) {
+      size_t v;
+      result = get_unsigned(repeat_flag, arg, v);
+      bench_args.repeat = v;
+    } else if (flag == format_flag) {
+      bench_args.json = std::strcmp(arg, "json") == 0;
+      result = bench_args.json || std::strcmp(arg, "csv") == 0;
+    } else if (flag == output_flag) {
+      bench_args.output = arg;
+    } else {
+      --i; // not a cfbench flag
+    }
+  }
+  if (!result)
+    usage();
+  return result;
+}
+
+static double
+now() {
+  return Realm::Clock::current_time_in_microseconds() * 1.0e-6;
+}
+
+// wait for completion of all previously issued operations
+static void
+fence(Context ctx, Runtime* rt) {
+  rt->issue_execution_fence(ctx).wait();
+}
+
+// name of the Kokkos backend of the CF task variants selected by the mapper
+static std::string
+kokkos_backend() {
+#ifdef KOKKOS_ENABLE_CUDA
+  {
+    Machine::ProcessorQuery procs(Machine::get_machine());
+    procs.only_kind(Processor::TOC_PROC);
+    if (procs.count() > 0)
+      return "Cuda";
+  }
+#endif
+#ifdef KOKKOS_ENABLE_OPENMP
+  {
+    Machine::ProcessorQuery procs(Machine::get_machine());
+    procs.only_kind(Processor::OMP_PROC);
+    if (procs.count() > 0)
+      return "OpenMP";
+  }
+#endif
+  return "Serial";
+}
+
+static std::vector<typename cf_table_axis<CF_STOKES_OUT>::type>
+stokes_values(size_t n) {
+  switch (n) {
+  case 1:
+    return {cc::Stokes::RR};
+  case 2:
+    return {cc::Stokes::RR, cc::Stokes::LL};
+  default:
+    return {cc::Stokes::RR, cc::Stokes::RL, cc::Stokes::LR, cc::Stokes::LL};
+  }
+}
+
+// Zernike expansion coefficients, up to the maximum order, for all frequencies
+// and circular polarization Stokes values
+static std::vector<ZCoeff>
+zernike_coefficients(
+  const std::vector<typename cf_table_axis<CF_FREQUENCY>::type>& frequencies) {
+
+  std::vector<ZCoeff> result;
+  const unsigned num_terms =
+    zernike_index(zernike_max_order::value, zernike_max_order::value) + 1;
+  for (auto& f : frequencies)
+    for (auto& s : stokes_values(4))
+      for (unsigned i = 0; i < num_terms; ++i) {
+        auto mn = zernike_inverse_index(i);
+        // diagonal (parallel hand) terms dominate, and all terms decrease with
+        // order
+        const float scale = (s == cc::Stokes::RR || s == cc::Stokes::LL)
+          ? 1.0f
+          : 0.1f;
+        result.push_back(
+          ZCoeff{
+            0,
+            f,
+            s,
+            mn.first,
+            mn.second,
+            zc_t(scale / (i + 1), scale / (2 * (i + 1)))});
+      }
+  return result;
+}
+
+static void
+run_benchmarks(
+  Context ctx,
+  Runtime* rt,
+  const BenchConfig& config,
+  unsigned iteration,
+  std::vector<BenchResult>& results) {
+
+  const size_t grid_size = config.grid_size;
+  const double pixels = grid_size * grid_size;
+
+  auto record =
+    [&](const std::string& name, size_t kernels, double flops, double t0) {
+      results.push_back(
+        BenchResult{name, config, iteration, kernels, flops, now() - t0});
+    };
+
+  std::vector<typename cf_table_axis<CF_W>::type> w_values;
+  for (size_t i = 0; i < config.w_planes; ++i)
+    w_values.push_back(
+      (config.w_planes > 1) ? w_max * i / (config.w_planes - 1) : 0.0);
+  std::vector<typename cf_table_axis<CF_PARALLACTIC_ANGLE>::type>
+    parallactic_angles;
+  for (size_t i = 0; i < config.pa_bins; ++i)
+    parallactic_angles.push_back(M_PI * i / config.pa_bins);
+  std::vector<typename cf_table_axis<CF_FREQUENCY>::type> frequencies;
+  for (size_t i = 0; i < config.frequencies; ++i)
+    frequencies.push_back(1.0e9 + 1.0e8 * i);
+  auto stokes = stokes_values(config.stokes);
+  auto zc = zernike_coefficients(frequencies);
+
+  // grid coordinates (not timed)
+  GridCoordinateTable lm_coords(ctx, rt, grid_size, {0.0});
+  lm_coords.compute_coordinates(
+    ctx,
+    rt,
+    cc::LinearCoordinate(2),
+    image_radius);
+  GridCoordinateTable a_coords(ctx, rt, grid_size, parallactic_angles);
+  a_coords.compute_coordinates(ctx, rt, cc::LinearCoordinate(2), 1.0);
+  fence(ctx, rt);
+
+  // PS term
+  PSTermTable
+    ps_tbl(ctx, rt, grid_size, {static_cast<float>(1.0 / image_radius)});
+  double t0 = now();
+  ps_tbl.compute_cfs(ctx, rt, lm_coords);
+  fence(ctx, rt);
+  record("PSTermTable::compute_cfs", 1, ps_flops * pixels, t0);
+
+  // W term
+  WTermTable w_tbl(ctx, rt, grid_size, w_values);
+  t0 = now();
+  w_tbl.compute_cfs(ctx, rt, lm_coords);
+  fence(ctx, rt);
+  record(
+    "WTermTable::compute_cfs",
+    w_values.size(),
+    w_flops * pixels * w_values.size(),
+    t0);
+
+  // A term
+  ATermTable a_tbl(
+    ctx,
+    rt,
+    grid_size,
+    {0},
+    parallactic_angles,
+    frequencies,
+    stokes,
+    stokes);
+  const size_t a_kernels =
+    parallactic_angles.size() * frequencies.size()
+    * stokes.size() * stokes.size();
+  t0 = now();
+  a_tbl.compute_cfs(ctx, rt, a_coords, zc);
+  fence(ctx, rt);
+  record(
+    "ATermTable::compute_cfs",
+    a_kernels,
+    a_flops * pixels * a_kernels,
+    t0);
+  lm_coords.destroy(ctx, rt);
+  a_coords.destroy(ctx, rt);
+
+  // product of A, W and PS terms
+  const size_t kernels = a_kernels * w_values.size();
+  t0 = now();
+  auto cf_tbl =
+    ProductCFTable<CF_TABLE_AXES>::create_and_fill(
+      ctx,
+      rt,
+      ColumnSpacePartition(),
+      a_tbl,
+      w_tbl,
+      ps_tbl);
+  fence(ctx, rt);
+  record(
+    "ProductCFTable::create",
+    kernels,
+    product_flops * pixels * kernels,
+    t0);
+  ps_tbl.destroy(ctx, rt);
+  w_tbl.destroy(ctx, rt);
+  a_tbl.destroy(ctx, rt);
+  cf_tbl.destroy(ctx, rt);
+
+  // FFT of the value and weight arrays, zero-padded by the oversampling
+  // factor; as the cost of the FFT does not depend on the array values, the
+  // padded arrays are simply filled. The first transform plans the FFT, and is
+  // not timed, so that FFTW planning cost is excluded from the timing.
+  {
+    const size_t padded_size = grid_size * config.oversampling;
+    CFTable<CF_TABLE_AXES> padded(
+      ctx,
+      rt,
+      padded_size,
+      CFTableBase::Axis<CF_BASELINE_CLASS>({0}),
+      CFTableBase::Axis<CF_PARALLACTIC_ANGLE>(parallactic_angles),
+      CFTableBase::Axis<CF_FREQUENCY>(frequencies),
+      CFTableBase::Axis<CF_W>(w_values),
+      CFTableBase::Axis<CF_STOKES_OUT>(stokes),
+      CFTableBase::Axis<CF_STOKES_IN>(stokes));
+    auto cols = padded.columns();
+    for (auto& nm
+           : {CFTableBase::CF_VALUE_COLUMN_NAME,
+              CFTableBase::CF_WEIGHT_COLUMN_NAME}) {
+      auto& col = cols.at(nm);
+      rt->fill_field(
+        ctx,
+        col.region,
+        col.region,
+        col.fid,
+        CFTableBase::cf_value_t(1.0f));
+    }
+    padded.apply_fft(ctx, rt, 1, true, true, FFTW_MEASURE, 5.0);
+    fence(ctx, rt);
+    const double n = padded_size * padded_size;
+    t0 = now();
+    padded.apply_fft(ctx, rt, 1, true, true, FFTW_MEASURE, 5.0);
+    fence(ctx, rt);
+    record(
+      "FFT::in_place",
+      2 * kernels,
+      5.0 * n * std::log2(n) * 2 * kernels,
+      t0);
+    padded.destroy(ctx, rt);
+  }
+}
+
+static void
+write_results(
+  std::ostream& os,
+  const BenchArgs& args,
+  const std::string& backend,
+  const std::vector<BenchResult>& results) {
+
+  auto rate =
+    [](double n, double s) {
+      return (s > 0) ? n / s : 0.0;
+    };
+  if (args.json) {
+    os << "{\"backend\": \"" << backend << "\""
+       << ", \"results\": [";
+    const char* sep = "\n";
+    for (auto& r : results) {
+      os << sep
+         << "  {\"name\": \"" << r.name << "\""
+         << ", \"grid_size\": " << r.config.grid_size
+         << ", \"oversampling\": " << r.config.oversampling
+         << ", \"w_planes\": " << r.config.w_planes
+         << ", \"pa_bins\": " << r.config.pa_bins
+         << ", \"frequencies\": " << r.config.frequencies
+         << ", \"stokes_pairs\": " << r.config.stokes * r.config.stokes
+         << ", \"iteration\": " << r.iteration
+         << ", \"kernels\": " << r.kernels
+         << ", \"seconds\": " << r.seconds
+         << ", \"kernels_per_s\": " << rate(r.kernels, r.seconds)
+         << ", \"GFLOP_per_s\": " << rate(r.flops * 1.0e-9, r.seconds)
+         << "}";
+      sep = ",\n";
+    }
+    os << "\n]}" << std::endl;
+  } else {
+    os << "name,backend,grid_size,oversampling,w_planes,pa_bins,frequencies,"
+       << "stokes_pairs,iteration,kernels,seconds,kernels_per_s,GFLOP_per_s"
+       << std::endl;
+    for (auto& r : results)
+      os << "\"" << r.name << "\","
+         << backend << ","
+         << r.config.grid_size << ","
+         << r.config.oversampling << ","
+         << r.config.w_planes << ","
+         << r.config.pa_bins << ","
+         << r.config.frequencies << ","
+         << r.config.stokes * r.config.stokes << ","
+         << r.iteration << ","
+         << r.kernels << ","
+         << r.seconds << ","
+         << rate(r.kernels, r.seconds) << ","
+         << rate(r.flops * 1.0e-9, r.seconds)
+         << std::endl;
+  }
+}
+
+void
+cfbench_task(
+  const Task*,
+  const std::vector<PhysicalRegion>&,
+  Context ctx,
+  Runtime* rt) {
+
+  BenchArgs args;
+  if (!get_args(Runtime::get_input_args(), args))
+    return;
+
+  std::vector<BenchResult> results;
+  for (unsigned i = 0; i < args.repeat; ++i)
+    for (auto& grid_size : args.grid_size)
+      for (auto& oversampling : args.oversampling)
+        for (auto& w_planes : args.w_planes)
+          for (auto& pa_bins : args.pa_bins)
+            for (auto& frequencies : args.frequencies)
+              for (auto& stokes : args.stokes)
+                run_benchmarks(
+                  ctx,
+                  rt,
+                  BenchConfig{
+                    grid_size,
+                    oversampling,
+                    w_planes,
+                    pa_bins,
+                    frequencies,
+                    stokes},
+                  i,
+                  results);
+
+  auto backend = kokkos_backend();
+  if (args.output.empty()) {
+    write_results(std::cout, args, backend, results);
+  } else {
+    std::ofstream ofs(args.output);
+    write_results(ofs, args, backend, results);
+  }
+}
+
+int
+main(int argc, char** argv) {
+
+  hyperion::preregister_all();
+  {
+    TaskVariantRegistrar registrar(CFBENCH_TASK_ID, "cfbench");
+    registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
+    Runtime::preregister_task_variant<cfbench_task>(
+      registrar,
+      "cfbench");
+    Runtime::set_top_level_task_id(CFBENCH_TASK_ID);
+  }
+  synthesis::CFTableBase::preregister_all();
+  synthesis::ProductCFTable<CF_TABLE_AXES>::preregister_tasks();
+  return Runtime::start(argc, argv);
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 2
+// fill-column: 80
+// indent-tabs-mode: nil
+// End:
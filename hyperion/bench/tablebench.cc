@@ -0,0 +1,603 @@
+/*
+ * Copyright 2020 Associated Universities, Inc. Washington DC, USA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <hyperion/hyperion.h>
+#include <hyperion/hdf5.h>
+#include <hyperion/Table.h>
+#include <hyperion/PhysicalTable.h>
+#include <hyperion/TableBuilder.h>
+#include <hyperion/TableReadTask.h>
+#include <hyperion/TableMapper.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include CXX_FILESYSTEM_HEADER
+#include <iostream>
+#include <unordered_set>
+
+#include <casacore/measures/Measures/Stokes.h>
+#include <casacore/ms/MeasurementSets.h>
+
+using namespace hyperion;
+using namespace Legion;
+
+namespace cc = casacore;
+
+// Benchmarks of the table/column layer on a synthetic MeasurementSet
+//
+// A MeasurementSet of configurable size is generated in a working directory,
+// after which the following operations on its MAIN table are timed: creation
+// of the Table (TableBuilder), reading of the MS values (TableReadTask) into
+// HDF5-backed regions, flushing of those regions to the HDF5 file, attachment
+// of the HDF5 columns (with and without zero-copy), row partitioning, column
+// index creation and reindexing. Results are written in CSV or JSON format.
+
+enum {
+  TABLEBENCH_TASK_ID
+};
+
+// maximum length of paths (MS and HDF5)
+#define MAX_PATHLEN 1024
+
+static const char* rows_flag = "--rows";
+static const char* antennas_flag = "--antennas";
+static const char* spws_flag = "--spws";
+static const char* channels_flag = "--channels";
+static const char* correlations_flag = "--correlations";
+static const char* block_rows_flag = "--block-rows";
+static const char* repeat_flag = "--repeat";
+static const char* format_flag = "--format";
+static const char* output_flag = "--output";
+static const char* work_dir_flag = "--work-dir";
+static const char* keep_flag = "--keep";
+
+struct BenchArgs {
+  // minimum number of MAIN table rows; the generated table has a whole number
+  // of integrations, each comprising every baseline in every spectral window
+  size_t rows = 100000;
+  unsigned antennas = 27;
+  unsigned spws = 1;
+  unsigned channels = 64;
+  unsigned correlations = 4;
+  size_t block_rows = 100000;
+  unsigned repeat = 1;
+  bool json = false;
+  CXX_FILESYSTEM_NAMESPACE::path output;
+  CXX_FILESYSTEM_NAMESPACE::path work_dir = ".";
+  bool keep = false;
+};
+
+struct BenchResult {
+  std::string name;
+  unsigned iteration;
+  size_t rows;
+  size_t bytes;
+  double seconds;
+};
+
+static void
+usage() {
+  std::cerr
+    << "usage: tablebench [OPTION...]\n"
+    << "  --rows N          (minimum) number of MAIN table rows\n"
+    << "  --antennas N      number of antennas\n"
+    << "  --spws N          number of spectral windows\n"
+    << "  --channels N      number of channels per spectral window\n"
+    << "  --correlations N  number of correlations (1, 2 or 4)\n"
+    << "  --block-rows N    number of rows per block in row partitions\n"
+    << "  --repeat N        number of iterations of all benchmarks\n"
+    << "  --format FMT      output format, 'csv' (default) or 'json'\n"
+    << "  --output PATH     output file path (default: standard output)\n"
+    << "  --work-dir PATH   directory for generated MS and HDF5 files\n"
+    << "  --keep            do not remove generated files\n";
+}
+
+static bool
+get_unsigned(const char* flag, const char* arg, size_t& val) {
+  char* end;
+  auto v = std::strtoul(arg, &end, 10);
+  if (*end != '\0' || v == 0) {
+    std::cerr << "Invalid " << flag << " value '" << arg << "'" << std::endl;
+    return false;
+  }
+  val = v;
+  return true;
+}
+
+static bool
+get_args(const InputArgs& args, BenchArgs& bench_args) {
+  bool result = true;
+  for (int i = 1; result && i < args.argc; ++i) {
+    std::string flag = args.argv[i];
+    if (flag == keep_flag) {
+      bench_args.keep = true;
+      continue;
+    }
+    if (flag.substr(0, 2) != "--")
+      continue;
+    if (i == args.argc - 1)
+      break;
+    const char* arg = args.argv[++i];
+    size_t v;
+    if (flag == rows_flag) {
+      result = get_unsigned(rows_flag, arg, bench_args.rows);
+    } else if (flag == antennas_flag) {
+      result = get_unsigned(antennas_flag, arg, v) && v > 1;
+      bench_args.antennas = v;
+    } else if (flag == spws_flag) {
+      result = get_unsigned(spws_flag, arg, v);
+      bench_args.spws = v;
+    } else if (flag == channels_flag) {
+      result = get_unsigned(channels_flag, arg, v);
+      bench_args.channels = v;
+    } else if (flag == correlations_flag) {
+      result = get_unsigned(correlations_flag, arg, v) && v <= 4 && v != 3;
+      bench_args.correlations = v;
+    } else if (flag == block_rows_flag) {
+      result = get_unsigned(block_rows_flag, arg, bench_args.block_rows);
+    } else if (flag == repeat_flag) {
+      result = get_unsigned(repeat_flag, arg, v);
+      bench_args.repeat = v;
+    } else if (flag == format_flag) {
+      bench_args.json = std::strcmp(arg, "json") == 0;
+      result = bench_args.json || std::strcmp(arg, "csv") == 0;
+    } else if (flag == output_flag) {
+      bench_args.output = arg;
+    } else if (flag == work_dir_flag) {
+      bench_args.work_dir = arg;
+      result = CXX_FILESYSTEM_NAMESPACE::is_directory(bench_args.work_dir);
+    } else {
+      --i; // not a tablebench flag
+    }
+  }
+  if (!result)
+    usage();
+  return result;
+}
+
+// generate a MeasurementSet, returning the number of MAIN table rows
+static size_t
+generate_ms(const CXX_FILESYSTEM_NAMESPACE::path& path, const BenchArgs& args) {
+
+  const size_t num_baselines = args.antennas * (args.antennas - 1) / 2;
+  const size_t rows_per_time = num_baselines * args.spws;
+  const size_t num_times = (args.rows + rows_per_time - 1) / rows_per_time;
+  const size_t num_rows = num_times * rows_per_time;
+  const cc::IPosition cell_shape(2, args.correlations, args.channels);
+
+  cc::TableDesc td = cc::MS::requiredTableDesc();
+  cc::MS::addColumnToDesc(td, cc::MS::DATA, 2);
+  for (auto& c : {cc::MS::DATA, cc::MS::FLAG})
+    td.rwColumnDesc(cc::MS::columnName(c)).setShape(cell_shape);
+  for (auto& c : {cc::MS::SIGMA, cc::MS::WEIGHT})
+    td.rwColumnDesc(cc::MS::columnName(c))
+      .setShape(cc::IPosition(1, args.correlations));
+  cc::SetupNewTable setup(path.string(), td, cc::Table::New);
+  cc::MeasurementSet ms(setup, num_rows);
+  ms.createDefaultSubtables(cc::Table::New);
+
+  {
+    ms.antenna().addRow(args.antennas);
+    cc::MSAntennaColumns ant(ms.antenna());
+    for (unsigned a = 0; a < args.antennas; ++a) {
+      ant.name().put(a, "A" + std::to_string(a));
+      ant.dishDiameter().put(a, 25.0);
+      cc::Vector<cc::Double> position(3);
+      position(0) = -1601185.0 + 100.0 * a;
+      position(1) = -5041977.0 - 100.0 * a;
+      position(2) = 3554876.0 + 10.0 * a;
+      ant.position().put(a, position);
+      ant.offset().put(a, cc::Vector<cc::Double>(3, 0.0));
+    }
+  }
+  {
+    ms.polarization().addRow();
+    cc::MSPolarizationColumns pol(ms.polarization());
+    cc::Vector<cc::Int> corr_type(args.correlations);
+    cc::Matrix<cc::Int> corr_product(2, args.correlations);
+    for (unsigned c = 0; c < args.correlations; ++c) {
+      corr_type(c) = cc::Stokes::RR + c;
+      corr_product(0, c) = c / 2;
+      corr_product(1, c) = c % 2;
+    }
+    pol.numCorr().put(0, args.correlations);
+    pol.corrType().put(0, corr_type);
+    pol.corrProduct().put(0, corr_product);
+  }
+  {
+    ms.spectralWindow().addRow(args.spws);
+    ms.dataDescription().addRow(args.spws);
+    cc::MSSpWindowColumns spw(ms.spectralWindow());
+    cc::MSDataDescColumns dd(ms.dataDescription());
+    const double width = 1.0e6;
+    for (unsigned s = 0; s < args.spws; ++s) {
+      cc::Vector<cc::Double> freq(args.channels);
+      for (unsigned c = 0; c < args.channels; ++c)
+        freq(c) = 1.0e9 + (s * args.channels + c) * width;
+      spw.numChan().put(s, args.channels);
+      spw.chanFreq().put(s, freq);
+      spw.chanWidth().put(s, cc::Vector<cc::Double>(args.channels, width));
+      spw.effectiveBW().put(s, cc::Vector<cc::Double>(args.channels, width));
+      spw.resolution().put(s, cc::Vector<cc::Double>(args.channels, width));
+      spw.refFrequency().put(s, freq(0));
+      spw.totalBandwidth().put(s, args.channels * width);
+      dd.spectralWindowId().put(s, s);
+      dd.polarizationId().put(s, 0);
+    }
+  }
+  {
+    cc::MSMainColumns main(ms);
+    cc::Matrix<cc::Complex> data(cell_shape);
+    const cc::Matrix<cc::Bool> flag(cell_shape, false);
+    const cc::Vector<cc::Float> weight(args.correlations, 1.0f);
+    cc::Vector<cc::Double> uvw(3);
+    size_t row = 0;
+    for (size_t t = 0; t < num_times; ++t) {
+      const double time = 4.8e9 + 10.0 * t;
+      for (unsigned s = 0; s < args.spws; ++s) {
+        for (unsigned a0 = 0; a0 < args.antennas; ++a0) {
+          for (unsigned a1 = a0 + 1; a1 < args.antennas; ++a1) {
+            main.time().put(row, time);
+            main.timeCentroid().put(row, time);
+            main.interval().put(row, 10.0);
+            main.exposure().put(row, 10.0);
+            main.antenna1().put(row, a0);
+            main.antenna2().put(row, a1);
+            main.dataDescId().put(row, s);
+            uvw(0) = 100.0 * (a1 - a0);
+            uvw(1) = 10.0 * t;
+            uvw(2) = 1.0 * s;
+            main.uvw().put(row, uvw);
+            data = cc::Complex(row % 1000, a0 + a1);
+            main.data().put(row, data);
+            main.flag().put(row, flag);
+            main.weight().put(row, weight);
+            main.sigma().put(row, weight);
+            ++row;
+          }
+        }
+      }
+    }
+  }
+  return num_rows;
+}
+
+static double
+now() {
+  return Realm::Clock::current_time_in_microseconds() * 1.0e-6;
+}
+
+// wait for completion of all previously issued operations
+static void
+fence(Context ctx, Runtime* rt) {
+  rt->issue_execution_fence(ctx).wait();
+}
+
+// total size of the values of selected columns of a table
+static size_t
+columns_size(
+  Context ctx,
+  Runtime* rt,
+  const Table& table,
+  const std::unordered_set<std::string>& columns) {
+
+  size_t result = 0;
+  for (auto& nm_col : table.columns()) {
+#if HAVE_CXX17
+    auto& [nm, col] = nm_col;
+#else // !HAVE_CXX17
+    auto& nm = std::get<0>(nm_col);
+    auto& col = std::get<1>(nm_col);
+#endif // HAVE_CXX17
+    if (columns.count(nm) > 0) {
+      size_t vsz;
+      switch (col.dt) {
+#define VSZ(DT)                                         \
+        case DT:                                        \
+          vsz = sizeof(typename DataType<DT>::ValueType); \
+          break;
+        HYPERION_FOREACH_DATATYPE(VSZ);
+#undef VSZ
+      default:
+        assert(false);
+        vsz = 0;
+        break;
+      }
+      result +=
+        rt->get_index_space_domain(ctx, col.cs.column_is).get_volume() * vsz;
+    }
+  }
+  return result;
+}
+
+static void
+run_benchmarks(
+  Context ctx,
+  Runtime* rt,
+  const BenchArgs& args,
+  unsigned iteration,
+  const CXX_FILESYSTEM_NAMESPACE::path& ms_path,
+  const CXX_FILESYSTEM_NAMESPACE::path& h5_path,
+  size_t num_rows,
+  std::vector<BenchResult>& results) {
+
+  auto record =
+    [&](const std::string& name, size_t bytes, double t0) {
+      results.push_back(
+        BenchResult{name, iteration, num_rows, bytes, now() - t0});
+    };
+
+  // Table creation
+  double t0 = now();
+  auto nm_ics_flds = from_ms<MS_MAIN>(ctx, rt, ms_path, {"*"});
+  Table table =
+    Table::create(
+      ctx,
+      rt,
+      std::move(std::get<1>(nm_ics_flds)),
+      std::move(std::get<2>(nm_ics_flds)));
+  fence(ctx, rt);
+  record("from_ms", 0, t0);
+
+  std::unordered_set<std::string> cnames;
+  for (auto& nm_col : table.columns())
+    cnames.insert(std::get<0>(nm_col));
+  const size_t table_size = columns_size(ctx, rt, table, cnames);
+
+  // HDF5 file, without column values
+  std::unordered_map<std::string, std::string> column_paths;
+  {
+    hid_t file_id =
+      CHECK_H5(H5DatatypeManager::create(h5_path, H5F_ACC_TRUNC));
+    hid_t table_grp_id =
+      CHECK_H5(
+        H5Gcreate(
+          file_id,
+          MSTable<MS_MAIN>::name,
+          H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+    hdf5::write_table(ctx, rt, table_grp_id, table);
+    CHECK_H5(H5Gclose(table_grp_id));
+    column_paths =
+      hdf5::get_table_column_paths(
+        file_id,
+        std::string("/") + MSTable<MS_MAIN>::name,
+        cnames);
+    CHECK_H5(H5Fclose(file_id));
+  }
+
+  // read MS values into the HDF5-backed regions, and flush them to the file
+  {
+    std::unordered_map<std::string, std::tuple<bool, bool, bool>> modes;
+    for (auto& nm_pth : column_paths)
+      modes[std::get<0>(nm_pth)] = {false, true, false};
+    auto ptable = table.attach_columns(ctx, rt, h5_path, column_paths, modes);
+    auto row_part =
+      table
+      .partition_rows(ctx, rt, {args.block_rows})
+      .get_result<ColumnSpacePartition>();
+    auto reqs =
+      TableReadTask::requirements(ctx, rt, ptable, row_part, READ_WRITE);
+#if HAVE_CXX17
+    auto& [treqs, tparts, tdesc] = reqs;
+#else // !HAVE_CXX17
+    auto& treqs = std::get<0>(reqs);
+    auto& tparts = std::get<1>(reqs);
+    auto& tdesc = std::get<2>(reqs);
+#endif // HAVE_CXX17
+    TableReadTask::Args tr_args;
+    fstrcpy(tr_args.table_path, ms_path.string());
+    tr_args.table_desc = tdesc;
+    IndexTaskLauncher read(
+      TableReadTask::TASK_ID,
+      rt->get_index_partition_color_space(row_part.column_ip),
+      TaskArgument(&tr_args, sizeof(tr_args)),
+      ArgumentMap(),
+      Predicate::TRUE_PRED,
+      false,
+      table_mapper);
+    for (auto& rq : treqs)
+      read.add_region_requirement(rq);
+    ptable.unmap_regions(ctx, rt);
+    fence(ctx, rt);
+    t0 = now();
+    rt->execute_index_space(ctx, read).wait_all_results();
+    record("TableReadTask", table_size, t0);
+
+    t0 = now();
+    ptable.detach_columns(ctx, rt, cnames);
+    fence(ctx, rt);
+    record("detach_columns", table_size, t0);
+    for (auto& p : tparts)
+      p.destroy(ctx, rt);
+    row_part.destroy(ctx, rt);
+  }
+
+  // attach the HDF5 columns, read-only and mapped, so that all values are read
+  std::unordered_map<std::string, std::tuple<bool, bool, bool>> modes;
+  for (auto& nm_pth : column_paths)
+    modes[std::get<0>(nm_pth)] = {true, true, true};
+  {
+    t0 = now();
+    auto ptable = table.attach_columns(ctx, rt, h5_path, column_paths, modes);
+    fence(ctx, rt);
+    record("attach_columns", table_size, t0);
+    ptable.detach_columns(ctx, rt, cnames);
+  }
+  t0 = now();
+  auto ptable =
+    table.attach_columns(
+      ctx,
+      rt,
+      h5_path,
+      column_paths,
+      modes,
+      CXX_OPTIONAL_NAMESPACE::nullopt,
+      true);
+  fence(ctx, rt);
+  record("attach_columns_zero_copy", table_size, t0);
+
+  // row partition
+  {
+    t0 = now();
+    auto row_part =
+      table
+      .partition_rows(ctx, rt, {args.block_rows})
+      .get_result<ColumnSpacePartition>();
+    record("partition_rows", 0, t0);
+    row_part.destroy(ctx, rt);
+  }
+
+  // column indexes
+  for (auto& nm :
+         {HYPERION_COLUMN_NAME(MAIN, TIME),
+          HYPERION_COLUMN_NAME(MAIN, ANTENNA1),
+          HYPERION_COLUMN_NAME(MAIN, DATA_DESC_ID)}) {
+    auto& col = table.columns().at(nm);
+    t0 = now();
+    LogicalRegion index = col.create_index(ctx, rt);
+    fence(ctx, rt);
+    record(
+      std::string("create_index(") + nm + ")",
+      columns_size(ctx, rt, table, {nm}),
+      t0);
+    if (index != LogicalRegion::NO_REGION) {
+      auto is = index.get_index_space();
+      auto fs = index.get_field_space();
+      rt->destroy_logical_region(ctx, index);
+      rt->destroy_field_space(ctx, fs);
+      rt->destroy_index_space(ctx, is);
+    }
+  }
+
+  // reindexing by TIME
+  {
+    std::vector<MSTable<MS_MAIN>::Axes> iaxes{MAIN_TIME};
+    t0 = now();
+    auto rtable = table.reindexed(ctx, rt, iaxes, true).get_result<Table>();
+    fence(ctx, rt);
+    record("reindexed(TIME)", table_size, t0);
+    rtable.destroy(ctx, rt);
+  }
+
+  ptable.detach_columns(ctx, rt, cnames);
+  table.destroy(ctx, rt);
+}
+
+static void
+write_results(
+  std::ostream& os,
+  const BenchArgs& args,
+  const std::vector<BenchResult>& results) {
+
+  auto rate =
+    [](double n, double s) {
+      return (s > 0) ? n / s : 0.0;
+    };
+  if (args.json) {
+    os << "{\"antennas\": " << args.antennas
+       << ", \"spws\": " << args.spws
+       << ", \"channels\": " << args.channels
+       << ", \"correlations\": " << args.correlations
+       << ", \"block_rows\": " << args.block_rows
+       << ", \"results\": [";
+    const char* sep = "\n";
+    for (auto& r : results) {
+      os << sep
+         << "  {\"name\": \"" << r.name << "\""
+         << ", \"iteration\": " << r.iteration
+         << ", \"rows\": " << r.rows
+         << ", \"bytes\": " << r.bytes
+         << ", \"seconds\": " << r.seconds
+         << ", \"rows_per_s\": " << rate(r.rows, r.seconds)
+         << ", \"GB_per_s\": " << rate(r.bytes * 1.0e-9, r.seconds)
+         << "}";
+      sep = ",\n";
+    }
+    os << "\n]}" << std::endl;
+  } else {
+    os << "name,iteration,rows,bytes,seconds,rows_per_s,GB_per_s" << std::endl;
+    for (auto& r : results)
+      os << "\"" << r.name << "\","
+         << r.iteration << ","
+         << r.rows << ","
+         << r.bytes << ","
+         << r.seconds << ","
+         << rate(r.rows, r.seconds) << ","
+         << rate(r.bytes * 1.0e-9, r.seconds)
+         << std::endl;
+  }
+}
+
+void
+tablebench_task(
+  const Task*,
+  const std::vector<PhysicalRegion>&,
+  Context ctx,
+  Runtime* rt) {
+
+  BenchArgs args;
+  if (!get_args(Runtime::get_input_args(), args))
+    return;
+
+  auto ms_path = args.work_dir / "tablebench.ms";
+  auto h5_path = args.work_dir / "tablebench.h5";
+  if (ms_path.string().size() >= MAX_PATHLEN) {
+    std::cerr << "Work directory path is too long" << std::endl;
+    return;
+  }
+  CXX_FILESYSTEM_NAMESPACE::remove_all(ms_path);
+  size_t num_rows = generate_ms(ms_path, args);
+
+  std::vector<BenchResult> results;
+  for (unsigned i = 0; i < args.repeat; ++i)
+    run_benchmarks(ctx, rt, args, i, ms_path, h5_path, num_rows, results);
+
+  if (args.output.empty()) {
+    write_results(std::cout, args, results);
+  } else {
+    std::ofstream ofs(args.output);
+    write_results(ofs, args, results);
+  }
+
+  if (!args.keep) {
+    CXX_FILESYSTEM_NAMESPACE::remove_all(ms_path);
+    CXX_FILESYSTEM_NAMESPACE::remove(h5_path);
+  }
+}
+
+int
+main(int argc, char** argv) {
+
+  hyperion::preregister_all();
+  {
+    TaskVariantRegistrar registrar(TABLEBENCH_TASK_ID, "tablebench");
+    registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
+    Runtime::preregister_task_variant<tablebench_task>(
+      registrar,
+      "tablebench");
+    Runtime::set_top_level_task_id(TABLEBENCH_TASK_ID);
+  }
+  return Runtime::start(argc, argv);
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 2
+// fill-column: 80
+// indent-tabs-mode: nil
+// End:
@@ -45,6 +45,30 @@ const constexpr char* ArgsBase::pa_block_desc;
 const constexpr char* ArgsBase::w_planes_tag;
 const constexpr char* ArgsBase::w_planes_desc;
 
+const constexpr char* ArgsBase::grid_size_tag;
+const constexpr char* ArgsBase::grid_size_desc;
+
+const constexpr char* ArgsBase::cell_size_tag;
+const constexpr char* ArgsBase::cell_size_desc;
+
+const constexpr char* ArgsBase::cf_size_tag;
+const constexpr char* ArgsBase::cf_size_desc;
+
+const constexpr char* ArgsBase::cf_oversampling_tag;
+const constexpr char* ArgsBase::cf_oversampling_desc;
+
+const constexpr char* ArgsBase::grid_tiles_tag;
+const constexpr char* ArgsBase::grid_tiles_desc;
+
+const constexpr char* ArgsBase::uv_tile_size_tag;
+const constexpr char* ArgsBase::uv_tile_size_desc;
+
+const constexpr char* ArgsBase::cf_threshold_tag;
+const constexpr char* ArgsBase::cf_threshold_desc;
+
+const constexpr char* ArgsBase::output_path_tag;
+const constexpr char* ArgsBase::output_path_desc;
+
 const constexpr args_t ArgsCompletion<VALUE_ARGS>::val;
 const constexpr args_t ArgsCompletion<STRING_ARGS>::val;
 const constexpr args_t ArgsCompletion<OPT_VALUE_ARGS>::val;
@@ -83,6 +107,22 @@ read_config(const YAML::Node& config) {
       args.pa_block = val;
     else if (key == args.w_planes.tag)
       args.w_planes = val;
+    else if (key == args.grid_size.tag)
+      args.grid_size = val;
+    else if (key == args.cell_size.tag)
+      args.cell_size = val;
+    else if (key == args.cf_size.tag)
+      args.cf_size = val;
+    else if (key == args.cf_oversampling.tag)
+      args.cf_oversampling = val;
+    else if (key == args.grid_tiles.tag)
+      args.grid_tiles = val;
+    else if (key == args.uv_tile_size.tag)
+      args.uv_tile_size = val;
+    else if (key == args.cf_threshold.tag)
+      args.cf_threshold = val;
+    else if (key == args.output_path.tag)
+      args.output_path = val;
     else
       invalid_tags.push_front(key);  
   }
@@ -154,6 +194,22 @@ load_config(
             gridder_args.pa_block = args.pa_block.value();
           if (args.w_planes)
             gridder_args.w_planes = args.w_planes.value();
+          if (args.grid_size)
+            gridder_args.grid_size = args.grid_size.value();
+          if (args.cell_size)
+            gridder_args.cell_size = args.cell_size.value();
+          if (args.cf_size)
+            gridder_args.cf_size = args.cf_size.value();
+          if (args.cf_oversampling)
+            gridder_args.cf_oversampling = args.cf_oversampling.value();
+          if (args.grid_tiles)
+            gridder_args.grid_tiles = args.grid_tiles.value();
+          if (args.uv_tile_size)
+            gridder_args.uv_tile_size = args.uv_tile_size.value();
+          if (args.cf_threshold)
+            gridder_args.cf_threshold = args.cf_threshold.value();
+          if (args.output_path)
+            gridder_args.output_path = args.output_path.value();
         }
       },
       read_result);
@@ -184,6 +240,23 @@ load_config(
         gridder_args.pa_block = read_result.args.pa_block.value();
       if (read_result.args.w_planes)
         gridder_args.w_planes = read_result.args.w_planes.value();
+      if (read_result.args.grid_size)
+        gridder_args.grid_size = read_result.args.grid_size.value();
+      if (read_result.args.cell_size)
+        gridder_args.cell_size = read_result.args.cell_size.value();
+      if (read_result.args.cf_size)
+        gridder_args.cf_size = read_result.args.cf_size.value();
+      if (read_result.args.cf_oversampling)
+        gridder_args.cf_oversampling =
+          read_result.args.cf_oversampling.value();
+      if (read_result.args.grid_tiles)
+        gridder_args.grid_tiles = read_result.args.grid_tiles.value();
+      if (read_result.args.uv_tile_size)
+        gridder_args.uv_tile_size = read_result.args.uv_tile_size.value();
+      if (read_result.args.cf_threshold)
+        gridder_args.cf_threshold = read_result.args.cf_threshold.value();
+      if (read_result.args.output_path)
+        gridder_args.output_path = read_result.args.output_path.value();
     }
 #endif // HAVE_CXX17
   } catch (const YAML::Exception& e) {
@@ -212,6 +285,15 @@ hyperion::gridder::as_args(YAML::Node&& node) {
     node[ArgsBase::pa_step_tag].as<PARALLACTIC_ANGLE_TYPE>();
   size_t pa_block = node[ArgsBase::pa_block_tag].as<size_t>();
   int w_planes = node[ArgsBase::w_planes_tag].as<int>();
+  size_t grid_size = node[ArgsBase::grid_size_tag].as<size_t>();
+  double cell_size = node[ArgsBase::cell_size_tag].as<double>();
+  size_t cf_size = node[ArgsBase::cf_size_tag].as<size_t>();
+  size_t cf_oversampling = node[ArgsBase::cf_oversampling_tag].as<size_t>();
+  bool grid_tiles = node[ArgsBase::grid_tiles_tag].as<bool>();
+  size_t uv_tile_size = node[ArgsBase::uv_tile_size_tag].as<size_t>();
+  double cf_threshold = node[ArgsBase::cf_threshold_tag].as<double>();
+  CXX_FILESYSTEM_NAMESPACE::path output_path =
+    node[ArgsBase::output_path_tag].as<std::string>();
   return
     Args<VALUE_ARGS>(
       h5_path,
@@ -220,7 +302,15 @@ hyperion::gridder::as_args(YAML::Node&& node) {
       min_block,
       pa_step,
       pa_block,
-      w_planes);
+      w_planes,
+      grid_size,
+      cell_size,
+      cf_size,
+      cf_oversampling,
+      grid_tiles,
+      uv_tile_size,
+      cf_threshold,
+      output_path);
 }
 
 bool
@@ -352,6 +442,22 @@ hyperion::gridder::get_args(
         gridder_args.w_planes = val;
       else if (match == gridder_args.min_block.tag)
         gridder_args.min_block = val;
+      else if (match == gridder_args.grid_size.tag)
+        gridder_args.grid_size = val;
+      else if (match == gridder_args.cell_size.tag)
+        gridder_args.cell_size = val;
+      else if (match == gridder_args.cf_size.tag)
+        gridder_args.cf_size = val;
+      else if (match == gridder_args.cf_oversampling.tag)
+        gridder_args.cf_oversampling = val;
+      else if (match == gridder_args.grid_tiles.tag)
+        gridder_args.grid_tiles = val;
+      else if (match == gridder_args.uv_tile_size.tag)
+        gridder_args.uv_tile_size = val;
+      else if (match == gridder_args.cf_threshold.tag)
+        gridder_args.cf_threshold = val;
+      else if (match == gridder_args.output_path.tag)
+        gridder_args.output_path = val;
       else if (match == gridder_args.echo.tag)
         gridder_args.echo = val;
       else if (match == gridder_args.config_path.tag)
@@ -419,6 +525,51 @@ hyperion::gridder::validate_args(const Args<VALUE_ARGS>& args) {
       args.min_block,
       "invalid, value must be at least one");
 
+  if (args.grid_size.value() == 0 || args.grid_size.value() % 2 != 0)
+    arg_error(errs, args.grid_size, "invalid, value must be even and positive");
+
+  if (std::fpclassify(args.cell_size.value()) != FP_NORMAL
+      || args.cell_size.value() < 0)
+    arg_error(errs, args.cell_size, "invalid, value must be positive");
+
+  if (args.cf_oversampling.value() == 0)
+    arg_error(
+      errs,
+      args.cf_oversampling,
+      "invalid, value must be at least one");
+  if (args.cf_size.value() == 0)
+    arg_error(errs, args.cf_size, "invalid, value must be positive");
+  else if (args.cf_oversampling.value() != 0
+           && args.cf_size.value() % (2 * args.cf_oversampling.value()) != 0)
+    arg_error(
+      errs,
+      args.cf_size,
+      std::string("invalid, value must be a multiple of twice the value of '")
+      + args.cf_oversampling.tag + "'");
+
+  if (std::fpclassify(args.cf_threshold.value()) == FP_NAN
+      || args.cf_threshold.value() < 0
+      || args.cf_threshold.value() >= 1)
+    arg_error(
+      errs,
+      args.cf_threshold,
+      "invalid, value must be non-negative and less than one");
+
+  if (args.output_path.value().empty())
+    arg_error(errs, args.output_path, "invalid, value must be non-empty");
+  else if (args.output_path.value() == args.h5_path.value())
+    arg_error(
+      errs,
+      args.output_path,
+      std::string("invalid, value must differ from the value of '")
+      + args.h5_path.tag + "'");
+
+  if (args.uv_tile_size.value() == 0)
+    arg_error(
+      errs,
+      args.uv_tile_size,
+      "invalid, value must be at least one");
+
   if (errs.str().size() > 0)
     return errs.str();
   return CXX_OPTIONAL_NAMESPACE::nullopt;
@@ -342,6 +342,38 @@ struct ArgsBase {
   static const constexpr char* w_planes_desc =
     "number of W-projection planes";
 
+  static const constexpr char* grid_size_tag = "grid_size";
+  static const constexpr char* grid_size_desc =
+    "size of uv-grid in either dimension (number of cells)";
+
+  static const constexpr char* cell_size_tag = "cell_size";
+  static const constexpr char* cell_size_desc =
+    "image cell size (arcseconds)";
+
+  static const constexpr char* cf_size_tag = "cf_size";
+  static const constexpr char* cf_size_desc =
+    "size of convolution function grid in either dimension";
+
+  static const constexpr char* cf_oversampling_tag = "cf_oversampling";
+  static const constexpr char* cf_oversampling_desc =
+    "convolution function oversampling factor";
+
+  static const constexpr char* grid_tiles_tag = "grid_tiles";
+  static const constexpr char* grid_tiles_desc =
+    "accumulate visibilities onto private uv-grid tiles (true/false)";
+
+  static const constexpr char* uv_tile_size_tag = "uv_tile_size";
+  static const constexpr char* uv_tile_size_desc =
+    "size of uv-grid tiles used to group visibilities (number of cells)";
+
+  static const constexpr char* cf_threshold_tag = "cf_threshold";
+  static const constexpr char* cf_threshold_desc =
+    "gridding kernel support threshold, relative to the kernel peak (float)";
+
+  static const constexpr char* output_path_tag = "output";
+  static const constexpr char* output_path_desc =
+    "path to HDF5 file for uv-grid output";
+
   static const std::vector<std::string>&
   tags() {
     static const std::vector<std::string> result{
@@ -351,7 +383,15 @@ struct ArgsBase {
       min_block_tag,
       pa_step_tag,
       pa_block_tag,
-      w_planes_tag
+      w_planes_tag,
+      grid_size_tag,
+      cell_size_tag,
+      cf_size_tag,
+      cf_oversampling_tag,
+      grid_tiles_tag,
+      uv_tile_size_tag,
+      cf_threshold_tag,
+      output_path_tag
     };
     return result;
   }
@@ -367,6 +407,14 @@ struct Args
   ArgType<PARALLACTIC_ANGLE_TYPE, false, G> pa_step;
   ArgType<size_t, false, G> pa_block;
   ArgType<int, false, G> w_planes;
+  ArgType<size_t, false, G> grid_size;
+  ArgType<double, false, G> cell_size;
+  ArgType<size_t, false, G> cf_size;
+  ArgType<size_t, false, G> cf_oversampling;
+  ArgType<bool, false, G> grid_tiles;
+  ArgType<size_t, false, G> uv_tile_size;
+  ArgType<double, false, G> cf_threshold;
+  ArgType<CXX_FILESYSTEM_NAMESPACE::path, false, G> output_path;
 
   Args()
     : h5_path(h5_path_tag, h5_path_desc)
@@ -375,7 +423,15 @@ struct Args
     , min_block(min_block_tag, min_block_desc)
     , pa_step(pa_step_tag, pa_step_desc)
     , pa_block(pa_block_tag, pa_block_desc)
-    , w_planes(w_planes_tag, w_planes_desc) {}
+    , w_planes(w_planes_tag, w_planes_desc)
+    , grid_size(grid_size_tag, grid_size_desc)
+    , cell_size(cell_size_tag, cell_size_desc)
+    , cf_size(cf_size_tag, cf_size_desc)
+    , cf_oversampling(cf_oversampling_tag, cf_oversampling_desc)
+    , grid_tiles(grid_tiles_tag, grid_tiles_desc)
+    , uv_tile_size(uv_tile_size_tag, uv_tile_size_desc)
+    , cf_threshold(cf_threshold_tag, cf_threshold_desc)
+    , output_path(output_path_tag, output_path_desc) {}
 
   Args(
     const typename decltype(h5_path)::type& h5_path_,
@@ -384,14 +440,30 @@ struct Args
     const typename decltype(min_block)::type& min_block_,
     const typename decltype(pa_step)::type& pa_step_,
     const typename decltype(pa_block)::type& pa_block_,
-    const typename decltype(w_planes)::type& w_planes_)
+    const typename decltype(w_planes)::type& w_planes_,
+    const typename decltype(grid_size)::type& grid_size_,
+    const typename decltype(cell_size)::type& cell_size_,
+    const typename decltype(cf_size)::type& cf_size_,
+    const typename decltype(cf_oversampling)::type& cf_oversampling_,
+    const typename decltype(grid_tiles)::type& grid_tiles_,
+    const typename decltype(uv_tile_size)::type& uv_tile_size_,
+    const typename decltype(cf_threshold)::type& cf_threshold_,
+    const typename decltype(output_path)::type& output_path_)
     : h5_path(h5_path_tag, h5_path_desc)
     , config_path(config_path_tag, config_path_desc)
     , echo(echo_tag, echo_desc)
     , min_block(min_block_tag, min_block_desc)
     , pa_step(pa_step_tag, pa_step_desc)
     , pa_block(pa_block_tag, pa_block_desc)
-    , w_planes(w_planes_tag, w_planes_desc) {
+    , w_planes(w_planes_tag, w_planes_desc)
+    , grid_size(grid_size_tag, grid_size_desc)
+    , cell_size(cell_size_tag, cell_size_desc)
+    , cf_size(cf_size_tag, cf_size_desc)
+    , cf_oversampling(cf_oversampling_tag, cf_oversampling_desc)
+    , grid_tiles(grid_tiles_tag, grid_tiles_desc)
+    , uv_tile_size(uv_tile_size_tag, uv_tile_size_desc)
+    , cf_threshold(cf_threshold_tag, cf_threshold_desc)
+    , output_path(output_path_tag, output_path_desc) {
 
     h5_path = h5_path_;
     config_path = config_path_;
@@ -400,6 +472,14 @@ struct Args
     pa_step = pa_step_;
     pa_block = pa_block_;
     w_planes = w_planes_;
+    grid_size = grid_size_;
+    cell_size = cell_size_;
+    cf_size = cf_size_;
+    cf_oversampling = cf_oversampling_;
+    grid_tiles = grid_tiles_;
+    uv_tile_size = uv_tile_size_;
+    cf_threshold = cf_threshold_;
+    output_path = output_path_;
   }
 
   bool
@@ -410,7 +490,15 @@ struct Args
       && min_block
       && pa_step
       && pa_block
-      && w_planes;
+      && w_planes
+      && grid_size
+      && cell_size
+      && cf_size
+      && cf_oversampling
+      && grid_tiles
+      && uv_tile_size
+      && cf_threshold
+      && output_path;
   }
 
   CXX_OPTIONAL_NAMESPACE::optional<Args<ArgsCompletion<G>::val>>
@@ -428,7 +516,15 @@ struct Args
             min_block.value(),
             pa_step.value(),
             pa_block.value(),
-            w_planes.value()));
+            w_planes.value(),
+            grid_size.value(),
+            cell_size.value(),
+            cf_size.value(),
+            cf_oversampling.value(),
+            grid_tiles.value(),
+            uv_tile_size.value(),
+            cf_threshold.value(),
+            output_path.value()));
     return result;
   }
 
@@ -449,6 +545,22 @@ struct Args
       result[pa_block.tag] = pa_block.value();
     if (w_planes)
       result[w_planes.tag] = w_planes.value();
+    if (grid_size)
+      result[grid_size.tag] = grid_size.value();
+    if (cell_size)
+      result[cell_size.tag] = cell_size.value();
+    if (cf_size)
+      result[cf_size.tag] = cf_size.value();
+    if (cf_oversampling)
+      result[cf_oversampling.tag] = cf_oversampling.value();
+    if (grid_tiles)
+      result[grid_tiles.tag] = grid_tiles.value();
+    if (uv_tile_size)
+      result[uv_tile_size.tag] = uv_tile_size.value();
+    if (cf_threshold)
+      result[cf_threshold.tag] = cf_threshold.value();
+    if (output_path)
+      result[output_path.tag] = output_path.value().c_str();
     return result;
   }
 
@@ -462,6 +574,14 @@ struct Args
       , {pa_step_tag, pa_step_desc}
       , {pa_block_tag, pa_block_desc}
       , {w_planes_tag, w_planes_desc}
+      , {grid_size_tag, grid_size_desc}
+      , {cell_size_tag, cell_size_desc}
+      , {cf_size_tag, cf_size_desc}
+      , {cf_oversampling_tag, cf_oversampling_desc}
+      , {grid_tiles_tag, grid_tiles_desc}
+      , {uv_tile_size_tag, uv_tile_size_desc}
+      , {cf_threshold_tag, cf_threshold_desc}
+      , {output_path_tag, output_path_desc}
       };
   }
 };
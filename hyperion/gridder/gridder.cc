@@ -30,21 +30,31 @@
 #include <hyperion/MSFeedTable.h>
 #include <hyperion/MSAntennaTable.h>
 #include <hyperion/MSDataDescriptionTable.h>
+#include <hyperion/MSSpWindowTable.h>
 
 #include <hyperion/gridder/gridder.h>
 #include <hyperion/gridder/args.h>
 #include <hyperion/synthesis/CFTableBase.h>
+#include <hyperion/synthesis/CFPhysicalTable.h>
+#include <hyperion/synthesis/FFT.h>
+#include <hyperion/synthesis/GridCoordinateTable.h>
 #include <hyperion/synthesis/PSTermTable.h>
 #include <hyperion/synthesis/WTermTable.h>
+#include <hyperion/synthesis/ProductCFTable.h>
+#include <hyperion/synthesis/GriddingKernelTable.h>
+
+#include <casacore/casa/BasicSL/Constants.h>
 
 #include <algorithm>
 #include <array>
 #include <experimental/array>
 #include <cmath>
+#include <cstdlib>
 #include CXX_FILESYSTEM_HEADER
 #include <iomanip>
 #include CXX_OPTIONAL_HEADER
 #include <string>
+#include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -64,7 +74,12 @@ namespace cc = casacore;
 enum {
   GRIDDER_TASK_ID,
   CLASSIFY_ANTENNAS_TASK_ID,
+  COMPUTE_UNIQUE_PARALLACTIC_ANGLES_TASK_ID,
   COMPUTE_PARALLACTIC_ANGLES_TASK_ID,
+  COMPUTE_W_MAX_TASK_ID,
+  COMPUTE_GRID_FOOTPRINT_TASK_ID,
+  BIN_VISIBILITIES_TASK_ID,
+  GRID_VISIBILITIES_TASK_ID,
 };
 
 enum {
@@ -83,6 +98,14 @@ default_config() {
     result.pa_step = std::string("360.0");
     result.pa_block = std::string("1000");
     result.w_planes = std::string("1");
+    result.grid_size = std::string("1024");
+    result.cell_size = std::string("1.0");
+    result.cf_size = std::string("128");
+    result.cf_oversampling = std::string("8");
+    result.grid_tiles = std::string("true");
+    result.uv_tile_size = std::string("32");
+    result.cf_threshold = std::string("1.0e-3");
+    result.output_path = std::string("grid.h5");
     computed = true;
   }
   return result;
@@ -138,6 +161,28 @@ LastPointRedop<1>::fold<false>(Point<1>& lhs, Point<1> rhs) {
     __atomic_store_n(&lhs.x, rhs.x, __ATOMIC_RELEASE);
 }
 
+typedef complex<float> grid_value_t;
+const constexpr Legion::FieldID grid_value_fid = 0;
+
+// grid dimensions: correlation, u, v
+const constexpr unsigned grid_rank = 3;
+const constexpr unsigned d_corr = 0;
+const constexpr unsigned d_u = 1;
+const constexpr unsigned d_v = 2;
+
+typedef complex_sum_redop<float> GridSumRedop;
+
+static inline ReductionOpID
+grid_sum_redop() {
+  return OpsManager::reduction_id(OpsManager::COMPLEX_SUM_REDOP);
+}
+
+// axes of the convolution function table used for gridding; note that the
+// product of the PS and W terms has no dependence on any other axis
+#define GRIDDER_CF_TABLE_AXES synthesis::CF_W
+typedef synthesis::GriddingKernelTable<GRIDDER_CF_TABLE_AXES>
+  gridding_kernel_table_t;
+
 #define FEED_AXES FEED_ANTENNA_ID, FEED_FEED_ID, FEED_SPECTRAL_WINDOW_ID
 
 std::tuple<
@@ -311,17 +356,22 @@ AntennaHelper::mount_codes = {
   {"alt-az+nasmyth-l", NASMYTH_L},
   {"ALT-AZ+NASMYTH-L", NASMYTH_L}};
 
+// field id of parallactic angles in the region of values at unique (TIME,
+// ANTENNA) pairs
+const constexpr Legion::FieldID unique_parallactic_angle_fid = 0;
+
+// compute parallactic angles at all (TIME, ANTENNA) pairs in a block of the
+// unique MAIN table TIME values
 void
-compute_parallactic_angles_task(
+compute_unique_parallactic_angles_task(
   const Task* task,
   const std::vector<PhysicalRegion>& regions,
-  Context ctx,
+  Context,
   Runtime* rt) {
 
-  const Table::DescM<4>* tdescs =
-    static_cast<const Table::DescM<4>*>(task->args);
+  const Table::DescM<2>* tdescs =
+    static_cast<const Table::DescM<2>*>(task->args);
 
-  // main table columns
   auto ptcr =
     PhysicalTable::create_many(
       rt,
@@ -335,39 +385,22 @@ compute_parallactic_angles_task(
   auto& [pts, rit, pit] = ptcr;
 #else // !HAVE_CXX17
   auto& pts = std::get<0>(ptcr);
+  auto& rit = std::get<1>(ptcr);
+  auto& pit = std::get<2>(ptcr);
 #endif // HAVE_CXX17
+  assert(std::distance(rit, task->regions.end()) == 2);
+  assert(std::distance(pit, regions.end()) == 2);
+
+  // main table columns
   MSMainTable<MAIN_ROW> main(pts[0]);
   typedef decltype(main)::C MainCols;
-  auto main_antenna1_col = main.antenna1<AffineAccessor>();
-  auto main_antenna1 =
-    main_antenna1_col.accessor<READ_ONLY, CHECK_BOUNDS>();
-  auto main_data_desc_id =
-    main.data_desc_id<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
-  auto main_feed1 =
-    main.feed1<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
-  auto main_time =
-    main.time<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
   auto main_time_meas =
     main.time_meas<AffineAccessor>().meas_accessor<READ_ONLY, CHECK_BOUNDS>(
       rt,
       MainCols::units.at(MainCols::col_t::MS_MAIN_COL_TIME));
-  PhysicalColumnTD<
-    parallactic_angle_dt,
-    main.row_rank,
-    main.row_rank,
-    AffineAccessor> main_parallactic_angle_col(
-      *pts[0].column(parallactic_angle_column_name).value());
-  auto main_parallactic_angle =
-    main_parallactic_angle_col.accessor<WRITE_ONLY, CHECK_BOUNDS>();
-
-  // data description table columns
-  MSDataDescriptionTable data_desc(pts[1]);
-  auto dd_spectral_window_id =
-    data_desc.spectral_window_id<AffineAccessor>()
-    .accessor<READ_ONLY, CHECK_BOUNDS>();
 
   // antenna table columns
-  MSAntennaTable antenna(pts[2]);
+  MSAntennaTable antenna(pts[1]);
   typedef decltype(antenna)::C AntennaCols;
   auto antenna_mount =
     antenna.mount<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
@@ -377,15 +410,34 @@ compute_parallactic_angles_task(
       rt,
       AntennaCols::units.at(AntennaCols::col_t::MS_ANTENNA_COL_POSITION));
 
-  // feed table columns
-  MSFeedTable<FEED_AXES> feed(pts[3]);
-  typedef decltype(feed)::C FeedCols;
-  auto feed_time =
-    feed.time_meas<AffineAccessor>().meas_accessor<READ_ONLY, CHECK_BOUNDS>(
-      rt,
-      FeedCols::units.at(FeedCols::col_t::MS_FEED_COL_TIME));
-  auto feed_receptor_angle =
-    feed.receptor_angle<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  // MAIN table TIME column index
+  const FieldAccessor<
+    READ_ONLY,
+    Column::COLUMN_INDEX_ROWS_TYPE,
+    1,
+    coord_t,
+    AffineAccessor<Column::COLUMN_INDEX_ROWS_TYPE, 1, coord_t>,
+    CHECK_BOUNDS> time_rows(*pit, Column::COLUMN_INDEX_ROWS_FID);
+
+  // parallactic angles at unique (TIME, ANTENNA) pairs
+  const FieldAccessor<
+    WRITE_ONLY,
+    PARALLACTIC_ANGLE_TYPE,
+    2,
+    coord_t,
+    AffineAccessor<PARALLACTIC_ANGLE_TYPE, 2, coord_t>,
+    CHECK_BOUNDS> par_angle(*(pit + 1), unique_parallactic_angle_fid);
+  const Rect<2> pa_rect =
+    rt->get_index_space_domain(task->regions.back().region.get_index_space());
+  if (pa_rect.empty())
+    return;
+
+  // all epochs in this block
+  std::vector<cc::MEpoch> epochs;
+  epochs.reserve(pa_rect.hi[0] - pa_rect.lo[0] + 1);
+  for (coord_t t = pa_rect.lo[0]; t <= pa_rect.hi[0]; ++t)
+    epochs.push_back(
+      main_time_meas.read(Point<MAIN_ROW>(time_rows[t][0].lo)));
 
   cc::MeasFrame ant_frame;
   // Set up the frame for epoch and antenna position. We will
@@ -395,7 +447,7 @@ compute_parallactic_angles_task(
   // Make the HADec pole as expressed in HADec. The pole is the default.
   cc::MDirection ha_dec_pole;
   ha_dec_pole.set(ha_dec_ref);
-  // Set up the machines to convert to AzEl, HADec and LAST
+  // Set up the machines to convert to AzEl and HADec
   cc::MDirection::Convert cvt_ra_dec_to_az_el;
   cvt_ra_dec_to_az_el.set(
     cc::MDirection(),
@@ -404,69 +456,153 @@ compute_parallactic_angles_task(
   cvt_ha_dec_to_az_el.set(
     ha_dec_pole,
     cc::MDirection::Ref(cc::MDirection::AZEL, ant_frame));
-  cc::MEpoch::Convert cvt_utc_to_last;
-  cvt_utc_to_last.set(cc::MEpoch(), cc::MEpoch::Ref(cc::MEpoch::LAST, ant_frame));
 
-  CXX_OPTIONAL_NAMESPACE::optional<double> last_time;
-  CXX_OPTIONAL_NAMESPACE::optional<int> last_antenna;
-  CXX_OPTIONAL_NAMESPACE::optional<AntennaHelper::MountCode> last_mount;
-  double par_angle = 0.0;
+  for (coord_t a = pa_rect.lo[1]; a <= pa_rect.hi[1]; ++a) {
+    auto mount = AntennaHelper::mount_code(antenna_mount[a]);
+    if (mount == AntennaHelper::MountCode::EQUATORIAL) {
+      for (coord_t t = pa_rect.lo[0]; t <= pa_rect.hi[0]; ++t)
+        par_angle[Point<2>(t, a)] = 0.0;
+      continue;
+    }
+    ant_frame.resetPosition(antenna_position.read(a));
+    for (coord_t t = pa_rect.lo[0]; t <= pa_rect.hi[0]; ++t) {
+      ant_frame.resetEpoch(epochs[t - pa_rect.lo[0]]);
+      // Now we can do the conversions using the machines
+      auto ra_dec_in_az_el = cvt_ra_dec_to_az_el();
+      auto ha_dec_pole_in_az_el = cvt_ha_dec_to_az_el();
+      // Get the parallactic angle
+      double pa =
+        ra_dec_in_az_el
+        .getValue()
+        .positionAngle(ha_dec_pole_in_az_el.getValue());
+      switch (mount) {
+      case AntennaHelper::MountCode::ALT_AZ:
+        break;
+      case AntennaHelper::MountCode::NASMYTH_R:
+        // Get the parallactic angle
+        pa += ra_dec_in_az_el.getAngle().getValue()[1];
+        break;
+      case AntennaHelper::MountCode::NASMYTH_L:
+        // Get the parallactic angle
+        pa -= ra_dec_in_az_el.getAngle().getValue()[1];
+        break;
+      default:
+        assert(false);
+        break;
+      }
+      par_angle[Point<2>(t, a)] = pa;
+    }
+  }
+}
+
+// write parallactic angles of MAIN table rows, gathered from the values at
+// unique (TIME, ANTENNA) pairs
+void
+compute_parallactic_angles_task(
+  const Task* task,
+  const std::vector<PhysicalRegion>& regions,
+  Context,
+  Runtime* rt) {
+
+  const Table::DescM<3>* tdescs =
+    static_cast<const Table::DescM<3>*>(task->args);
+
+  // main table columns
+  auto ptcr =
+    PhysicalTable::create_many(
+      rt,
+      *tdescs,
+      task->regions.begin(),
+      task->regions.end(),
+      regions.begin(),
+      regions.end())
+    .value();
+#if HAVE_CXX17
+  auto& [pts, rit, pit] = ptcr;
+#else // !HAVE_CXX17
+  auto& pts = std::get<0>(ptcr);
+  auto& rit = std::get<1>(ptcr);
+  auto& pit = std::get<2>(ptcr);
+#endif // HAVE_CXX17
+  assert(std::distance(rit, task->regions.end()) == 2);
+  assert(std::distance(pit, regions.end()) == 2);
+
+  MSMainTable<MAIN_ROW> main(pts[0]);
+  auto main_antenna1_col = main.antenna1<AffineAccessor>();
+  auto main_antenna1 =
+    main_antenna1_col.accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_data_desc_id =
+    main.data_desc_id<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_feed1 =
+    main.feed1<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_time =
+    main.time<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  PhysicalColumnTD<
+    parallactic_angle_dt,
+    main.row_rank,
+    main.row_rank,
+    AffineAccessor> main_parallactic_angle_col(
+      *pts[0].column(parallactic_angle_column_name).value());
+  auto main_parallactic_angle =
+    main_parallactic_angle_col.accessor<WRITE_ONLY, CHECK_BOUNDS>();
+
+  // data description table columns
+  MSDataDescriptionTable data_desc(pts[1]);
+  auto dd_spectral_window_id =
+    data_desc.spectral_window_id<AffineAccessor>()
+    .accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // feed table columns
+  MSFeedTable<FEED_AXES> feed(pts[2]);
+  auto feed_receptor_angle =
+    feed.receptor_angle<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // MAIN table TIME column index values
+  typedef DataType<HYPERION_TYPE_DOUBLE>::ValueType time_value_t;
+  const FieldAccessor<
+    READ_ONLY,
+    time_value_t,
+    1,
+    coord_t,
+    AffineAccessor<time_value_t, 1, coord_t>,
+    CHECK_BOUNDS> times(*pit, Column::COLUMN_INDEX_VALUE_FID);
+  const Rect<1> times_rect =
+    rt->get_index_space_domain(
+      task->regions[task->regions.size() - 2].region.get_index_space());
+  const time_value_t* times_lo = times.ptr(times_rect.lo);
+  const time_value_t* times_hi = times_lo + times_rect.volume();
+
+  // parallactic angles at unique (TIME, ANTENNA) pairs
+  const FieldAccessor<
+    READ_ONLY,
+    PARALLACTIC_ANGLE_TYPE,
+    2,
+    coord_t,
+    AffineAccessor<PARALLACTIC_ANGLE_TYPE, 2, coord_t>,
+    CHECK_BOUNDS> par_angle(*(pit + 1), unique_parallactic_angle_fid);
+
+  CXX_OPTIONAL_NAMESPACE::optional<time_value_t> last_time;
+  coord_t time_index = 0;
   for (PointInRectIterator<main.row_rank> row(main_antenna1_col.rect());
        row();
        row++) {
-    bool ant_frame_changed = false;
     if (main_time[*row] != last_time.value_or(main_time[*row] + 1)) {
       last_time = main_time[*row];
-      cc::MEpoch epoch = main_time_meas.read(*row);
-      cvt_utc_to_last.setModel(epoch);
-      ant_frame.resetEpoch(epoch);
-      ant_frame_changed = true;
-    }
-    if (main_antenna1[*row] != last_antenna.value_or(main_antenna1[*row] + 1)) {
-      last_antenna = main_antenna1[*row];
-      ant_frame.resetPosition(antenna_position.read(last_antenna.value()));
-      ant_frame_changed = true;
-    }
-    auto mount = AntennaHelper::mount_code(antenna_mount[last_antenna.value()]);
-    if (!last_mount || mount != last_mount.value()) {
-      last_mount = mount;
-      ant_frame_changed = true;
-    }
-    if (mount != AntennaHelper::MountCode::EQUATORIAL) {
-      if (ant_frame_changed) {
-        // Now we can do the conversions using the machines
-        auto ra_dec_in_az_el = cvt_ra_dec_to_az_el();
-        auto ha_dec_pole_in_az_el = cvt_ha_dec_to_az_el();
-        // Get the parallactic angle
-        par_angle =
-          ra_dec_in_az_el
-          .getValue()
-          .positionAngle(ha_dec_pole_in_az_el.getValue());
-        switch (mount) {
-        case AntennaHelper::MountCode::ALT_AZ:
-          break;
-        case AntennaHelper::MountCode::NASMYTH_R:
-          // Get the parallactic angle
-          par_angle += ra_dec_in_az_el.getAngle().getValue()[1];
-          break;
-        case AntennaHelper::MountCode::NASMYTH_L:
-          // Get the parallactic angle
-          par_angle -= ra_dec_in_az_el.getAngle().getValue()[1];
-          break;
-        default:
-          assert(false);
-          break;
-        }
-      }
-    } else {
-      par_angle = 0.0;
+      time_index =
+        std::distance(
+          times_lo,
+          std::lower_bound(times_lo, times_hi, last_time.value()));
+      assert(times_lo + time_index < times_hi);
+      assert(times_lo[time_index] == last_time.value());
     }
     Point<4> ra_idx(
       main_antenna1[*row],
       main_feed1[*row],
       dd_spectral_window_id[main_data_desc_id[*row]],
       0);
-    main_parallactic_angle[*row] = par_angle + feed_receptor_angle[ra_idx];
+    main_parallactic_angle[*row] =
+      par_angle[Point<2>(time_index, main_antenna1[*row])]
+      + feed_receptor_angle[ra_idx];
   }
 }
 
@@ -508,6 +644,164 @@ init_antenna_classes(
   antenna_table.remap_regions(ctx, rt);
 }
 
+// requirements for MAIN table columns in row block index launches: every
+// block's instances are placed in the memory nearest the processor of the
+// block's point task, with the (named) layout "ltag"
+static Column::Requirements
+row_block_requirements(
+  PrivilegeMode privilege = Column::default_requirements.values.privilege,
+  TableMapper::LayoutTag ltag = TableMapper::default_column_layout_tag) {
+
+  Column::Requirements result = Column::default_requirements;
+  result.values.privilege = privilege;
+  result.tag = TableMapper::to_mapping_tag(ltag, 0, TableMapper::numa_affine);
+  return result;
+}
+
+// compute parallactic angles at unique (TIME, ANTENNA) pairs, in blocks of
+// TIME values; returns a region of the parallactic angles indexed by (MAIN
+// TIME column index, ANTENNA), which the caller must eventually destroy
+static LogicalRegion
+init_unique_parallactic_angles(
+  Context ctx,
+  Runtime* rt,
+  size_t block_size,
+  const PhysicalTable& main_table,
+  const PhysicalTable& antenna_table,
+  const LogicalRegion& time_index_lr) {
+
+  const Rect<1> times_rect =
+    rt->get_index_space_domain(time_index_lr.get_index_space());
+  const Rect<1> antennas_rect =
+    rt->get_index_space_domain(
+      antenna_table
+      .column(HYPERION_COLUMN_NAME(ANTENNA, MOUNT)).value()
+      ->region().get_index_space());
+
+  LogicalRegion result;
+  {
+    IndexSpace is =
+      rt->create_index_space(
+        ctx,
+        Rect<2>(
+          {times_rect.lo[0], antennas_rect.lo[0]},
+          {times_rect.hi[0], antennas_rect.hi[0]}));
+    FieldSpace fs = rt->create_field_space(ctx);
+    FieldAllocator fa = rt->create_field_allocator(ctx, fs);
+    fa.allocate_field(
+      sizeof(PARALLACTIC_ANGLE_TYPE),
+      unique_parallactic_angle_fid);
+    result = rt->create_logical_region(ctx, is, fs);
+  }
+
+  // partition the unique parallactic angles by blocks of TIME values, with
+  // block size chosen to give about "block_size" values per block
+  IndexPartition ip;
+  {
+    size_t num_antennas = antennas_rect.volume();
+    size_t num_blocks =
+      rt->select_tunable_value(
+        ctx,
+        Mapping::DefaultMapper::DefaultTunables::DEFAULT_TUNABLE_GLOBAL_CPUS)
+      .get_result<size_t>();
+    num_blocks =
+      min_divisor(
+        times_rect.volume(),
+        std::max(block_size / std::max(num_antennas, size_t(1)), size_t(1)),
+        num_blocks);
+    coord_t times_per_block =
+      (times_rect.volume() + num_blocks - 1) / num_blocks;
+    IndexSpace cs =
+      rt->create_index_space(ctx, Rect<1>(0, num_blocks - 1));
+    Transform<2, 1> transform;
+    transform[0][0] = times_per_block;
+    transform[1][0] = 0;
+    ip =
+      rt->create_partition_by_restriction(
+        ctx,
+        result.get_index_space(),
+        cs,
+        transform,
+        Rect<2>(
+          {times_rect.lo[0], antennas_rect.lo[0]},
+          {times_rect.lo[0] + times_per_block - 1, antennas_rect.hi[0]}));
+  }
+
+  Table::DescM<2> tdescs;
+  IndexTaskLauncher task(
+    COMPUTE_UNIQUE_PARALLACTIC_ANGLES_TASK_ID,
+    rt->get_index_partition_color_space_name(ip),
+    TaskArgument(&tdescs, sizeof(tdescs)),
+    ArgumentMap(),
+    Predicate::TRUE_PRED,
+    false,
+    table_mapper);
+
+  auto main_rq =
+    main_table
+    .requirements(
+      ctx,
+      rt,
+      ColumnSpacePartition(),
+      {{HYPERION_COLUMN_NAME(MAIN, TIME),
+        Column::default_requirements}},
+      CXX_OPTIONAL_NAMESPACE::nullopt);
+#if HAVE_CXX17
+  auto& [main_reqs, main_parts, main_desc] = main_rq;
+#else // !HAVE_CXX17
+  auto& main_reqs = std::get<0>(main_rq);
+  auto& main_parts = std::get<1>(main_rq);
+  auto& main_desc = std::get<2>(main_rq);
+#endif // HAVE_CXX17
+  for (auto& rq : main_reqs)
+    task.add_region_requirement(rq);
+  tdescs[0] = main_desc;
+
+  auto ant_rq =
+    antenna_table
+    .requirements(
+      ctx,
+      rt,
+      ColumnSpacePartition(),
+      {{HYPERION_COLUMN_NAME(ANTENNA, MOUNT),
+        Column::default_requirements},
+       {HYPERION_COLUMN_NAME(ANTENNA, POSITION),
+        Column::default_requirements}},
+      CXX_OPTIONAL_NAMESPACE::nullopt);
+#if HAVE_CXX17
+  auto& [ant_reqs, ant_parts, ant_desc] = ant_rq;
+#else // !HAVE_CXX17
+  auto& ant_reqs = std::get<0>(ant_rq);
+  auto& ant_parts = std::get<1>(ant_rq);
+  auto& ant_desc = std::get<2>(ant_rq);
+#endif // HAVE_CXX17
+  for (auto& rq : ant_reqs)
+    task.add_region_requirement(rq);
+  tdescs[1] = ant_desc;
+  antenna_table.unmap_regions(ctx, rt);
+
+  {
+    RegionRequirement
+      req(time_index_lr, READ_ONLY, EXCLUSIVE, time_index_lr);
+    req.add_field(Column::COLUMN_INDEX_ROWS_FID);
+    task.add_region_requirement(req);
+  }
+  {
+    LogicalPartition lp = rt->get_logical_partition(ctx, result, ip);
+    RegionRequirement req(lp, 0, WRITE_ONLY, EXCLUSIVE, result);
+    req.add_field(unique_parallactic_angle_fid);
+    task.add_region_requirement(req);
+  }
+  rt->execute_index_space(ctx, task);
+
+  antenna_table.remap_regions(ctx, rt);
+  for (std::vector<ColumnSpacePartition>* csps : {&main_parts, &ant_parts})
+    for (auto& csp : *csps)
+      csp.destroy(ctx, rt);
+  rt->destroy_index_space(ctx, rt->get_index_partition_color_space_name(ip));
+  rt->destroy_index_partition(ctx, ip);
+  return result;
+}
 
 // write values to parallactic angle column
 void
@@ -520,9 +814,31 @@ init_parallactic_angles(
   const PhysicalTable& antenna_table,
   const Table& feed_table) {
 
+  // The parallactic angle depends only on (TIME, ANTENNA), and the number of
+  // such pairs is smaller than the number of MAIN table rows by about half the
+  // number of antennas. Compute the angles at all unique pairs first, and then
+  // gather them to the MAIN table rows.
+  main_table.unmap_regions(ctx, rt);
+  LogicalRegion time_index_lr =
+    main_table
+    .column(HYPERION_COLUMN_NAME(MAIN, TIME)).value()
+    ->create_index(ctx, rt);
+  if (time_index_lr == LogicalRegion::NO_REGION) {
+    main_table.remap_regions(ctx, rt);
+    return;
+  }
+  LogicalRegion unique_pa_lr =
+    init_unique_parallactic_angles(
+      ctx,
+      rt,
+      block_size,
+      main_table,
+      antenna_table,
+      time_index_lr);
+
   ColumnSpacePartition partition =
     main_table.partition_rows(ctx, rt, {block_size});
-  Table::DescM<4> tdescs;
+  Table::DescM<3> tdescs;
   IndexTaskLauncher task(
     COMPUTE_PARALLACTIC_ANGLES_TASK_ID,
     rt->get_index_partition_color_space_name(partition.column_ip),
@@ -532,25 +848,17 @@ init_parallactic_angles(
     false,
     table_mapper);
 
-  Column::Requirements pareqs = Column::default_requirements;
-  pareqs.values.privilege = WRITE_ONLY;
   auto main_rq =
     main_table
     .requirements(
       ctx,
       rt,
       partition,
-      {{parallactic_angle_column_name, pareqs},
-       {HYPERION_COLUMN_NAME(MAIN, ANTENNA1),
-        Column::default_requirements},
-       {HYPERION_COLUMN_NAME(MAIN, DATA_DESC_ID),
-        Column::default_requirements},
-       {HYPERION_COLUMN_NAME(MAIN, FEED1),
-        Column::default_requirements},
-       {HYPERION_COLUMN_NAME(MAIN, TIME),
-        Column::default_requirements},
-       {HYPERION_COLUMN_NAME(MAIN, UVW),
-        Column::default_requirements}},
+      {{parallactic_angle_column_name, row_block_requirements(WRITE_ONLY)},
+       {HYPERION_COLUMN_NAME(MAIN, ANTENNA1), row_block_requirements()},
+       {HYPERION_COLUMN_NAME(MAIN, DATA_DESC_ID), row_block_requirements()},
+       {HYPERION_COLUMN_NAME(MAIN, FEED1), row_block_requirements()},
+       {HYPERION_COLUMN_NAME(MAIN, TIME), row_block_requirements()}},
       CXX_OPTIONAL_NAMESPACE::nullopt);
 #if HAVE_CXX17
   auto& [main_reqs, main_parts, main_desc] = main_rq;
@@ -562,7 +870,6 @@ init_parallactic_angles(
   for (auto& rq : main_reqs)
     task.add_region_requirement(rq);
   tdescs[0] = main_desc;
-  main_table.unmap_regions(ctx, rt);
 
   auto dd_rq =
     data_description_table
@@ -585,29 +892,6 @@ init_parallactic_angles(
   tdescs[1] = dd_desc;
   data_description_table.unmap_regions(ctx, rt);
 
-  auto ant_rq =
-    antenna_table
-    .requirements(
-      ctx,
-      rt,
-      ColumnSpacePartition(),
-      {{HYPERION_COLUMN_NAME(ANTENNA, MOUNT),
-        Column::default_requirements},
-       {HYPERION_COLUMN_NAME(ANTENNA, POSITION),
-        Column::default_requirements}},
-      CXX_OPTIONAL_NAMESPACE::nullopt);
-#if HAVE_CXX17
-  auto& [ant_reqs, ant_parts, ant_desc] = ant_rq;
-#else // !HAVE_CXX17
-  auto& ant_reqs = std::get<0>(ant_rq);
-  auto& ant_parts = std::get<1>(ant_rq);
-  auto& ant_desc = std::get<2>(ant_rq);
-#endif // HAVE_CXX17
-  for (auto& rq : ant_reqs)
-    task.add_region_requirement(rq);
-  tdescs[2] = ant_desc;
-  antenna_table.unmap_regions(ctx, rt);
-
   auto feed_rq = feed_table.requirements(ctx, rt);
 #if HAVE_CXX17
   auto& [feed_reqs, feed_parts, feed_desc] = feed_rq;
@@ -618,50 +902,1197 @@ init_parallactic_angles(
 #endif // HAVE_CXX17
   for (auto& rq : feed_reqs)
     task.add_region_requirement(rq);
-  tdescs[3] = feed_desc;
+  tdescs[2] = feed_desc;
+
+  {
+    RegionRequirement
+      req(time_index_lr, READ_ONLY, EXCLUSIVE, time_index_lr);
+    req.add_field(Column::COLUMN_INDEX_VALUE_FID);
+    task.add_region_requirement(req);
+  }
+  {
+    RegionRequirement req(unique_pa_lr, READ_ONLY, EXCLUSIVE, unique_pa_lr);
+    req.add_field(unique_parallactic_angle_fid);
+    task.add_region_requirement(req);
+  }
 
   rt->execute_index_space(ctx, task);
 
-  for (const PhysicalTable* tbp :
-         {&main_table, &data_description_table, &antenna_table})
+  for (const PhysicalTable* tbp : {&main_table, &data_description_table})
     tbp->remap_regions(ctx, rt);
   for (std::vector<ColumnSpacePartition>* csps :
-         {&main_parts, &dd_parts, &ant_parts, &feed_parts})
+         {&main_parts, &dd_parts, &feed_parts})
     for (auto& csp : *csps)
       csp.destroy(ctx, rt);
-}
-
-template <typename gridder::args_t G>
-void
-show_help(const gridder::Args<G>& args) {
-  std::ostringstream oss;
-  oss << "Usage: gridder [LEGION OPTIONS] [GRIDDER OPTIONS]"
-      << std::endl
-      << "  valid GRIDDER OPTIONS (all options have values):"
-      << std::endl;
-  size_t max_tag_len = 0;
-  std::map<std::string, std::string> h = args.help();
-  for (auto& t_d : h)
-    max_tag_len = std::max(std::get<0>(t_d).size(), max_tag_len);
-  for (auto& t_d : h) {
-    auto& tag = std::get<0>(t_d);
-    auto& desc = std::get<1>(t_d);
-    oss << std::setw(max_tag_len + 4) << std::right << tag
-        << std::string(": ") << desc
-        << std::endl;
+  partition.destroy(ctx, rt);
+  for (auto& lr : {time_index_lr, unique_pa_lr}) {
+    rt->destroy_field_space(ctx, lr.get_field_space());
+    rt->destroy_index_space(ctx, lr.get_index_space());
+    rt->destroy_logical_region(ctx, lr);
   }
-  std::cout << oss.str();
 }
 
-void
-gridder_task(
-  const Task*,
-  const std::vector<PhysicalRegion>&,
+// add requirements for the MAIN table columns needed to compute visibility uv
+// coordinates, in row blocks given by "partition", as well as the
+// DATA_DESCRIPTION and SPECTRAL_WINDOW tables, to a task launcher; MAIN table
+// columns in "visibility_columns" are mapped with the polarization axis
+// innermost, separately for every column, as the tasks visit all
+// polarizations of a visibility together
+static std::vector<ColumnSpacePartition>
+add_visibility_requirements(
   Context ctx,
-  Runtime* rt) {
-
-  // process command line arguments
-  //
+  Runtime* rt,
+  IndexTaskLauncher& task,
+  Table::Desc* tdescs,
+  const ColumnSpacePartition& partition,
+  const PhysicalTable& main_table,
+  const std::vector<std::string>& main_columns,
+  const PhysicalTable& data_description_table,
+  const PhysicalTable& spectral_window_table,
+  const std::vector<std::string>& visibility_columns = {}) {
+
+  std::vector<ColumnSpacePartition> result;
+
+  std::vector<
+    std::tuple<
+      std::string,
+      CXX_OPTIONAL_NAMESPACE::optional<Column::Requirements>>> main_colreqs;
+  for (auto& c : main_columns)
+    main_colreqs.emplace_back(c, row_block_requirements());
+  for (auto& c : visibility_columns)
+    main_colreqs.emplace_back(
+      c,
+      row_block_requirements(
+        READ_ONLY,
+        TableMapper::soa_right_layout_tag));
+  auto main_rq =
+    main_table
+    .requirements(
+      ctx,
+      rt,
+      partition,
+      main_colreqs,
+      CXX_OPTIONAL_NAMESPACE::nullopt);
+#if HAVE_CXX17
+  auto& [main_reqs, main_parts, main_desc] = main_rq;
+#else // !HAVE_CXX17
+  auto& main_reqs = std::get<0>(main_rq);
+  auto& main_parts = std::get<1>(main_rq);
+  auto& main_desc = std::get<2>(main_rq);
+#endif // HAVE_CXX17
+  for (auto& rq : main_reqs)
+    task.add_region_requirement(rq);
+  tdescs[0] = main_desc;
+  std::copy(main_parts.begin(), main_parts.end(), std::back_inserter(result));
+
+  auto dd_rq =
+    data_description_table
+    .requirements(
+      ctx,
+      rt,
+      ColumnSpacePartition(),
+      {{HYPERION_COLUMN_NAME(DATA_DESCRIPTION, SPECTRAL_WINDOW_ID),
+        Column::default_requirements}},
+      CXX_OPTIONAL_NAMESPACE::nullopt);
+#if HAVE_CXX17
+  auto& [dd_reqs, dd_parts, dd_desc] = dd_rq;
+#else // !HAVE_CXX17
+  auto& dd_reqs = std::get<0>(dd_rq);
+  auto& dd_parts = std::get<1>(dd_rq);
+  auto& dd_desc = std::get<2>(dd_rq);
+#endif // HAVE_CXX17
+  for (auto& rq : dd_reqs)
+    task.add_region_requirement(rq);
+  tdescs[1] = dd_desc;
+  std::copy(dd_parts.begin(), dd_parts.end(), std::back_inserter(result));
+
+  auto spw_rq =
+    spectral_window_table
+    .requirements(
+      ctx,
+      rt,
+      ColumnSpacePartition(),
+      {{HYPERION_COLUMN_NAME(SPECTRAL_WINDOW, CHAN_FREQ),
+        Column::default_requirements}},
+      CXX_OPTIONAL_NAMESPACE::nullopt);
+#if HAVE_CXX17
+  auto& [spw_reqs, spw_parts, spw_desc] = spw_rq;
+#else // !HAVE_CXX17
+  auto& spw_reqs = std::get<0>(spw_rq);
+  auto& spw_parts = std::get<1>(spw_rq);
+  auto& spw_desc = std::get<2>(spw_rq);
+#endif // HAVE_CXX17
+  for (auto& rq : spw_reqs)
+    task.add_region_requirement(rq);
+  tdescs[2] = spw_desc;
+  std::copy(spw_parts.begin(), spw_parts.end(), std::back_inserter(result));
+
+  return result;
+}
+
+// maximum absolute value of W (in wavelengths) over rows in a block of the
+// MAIN table
+double
+compute_w_max_task(
+  const Task* task,
+  const std::vector<PhysicalRegion>& regions,
+  Context ctx,
+  Runtime* rt) {
+
+  const Table::DescM<3>* tdescs =
+    static_cast<const Table::DescM<3>*>(task->args);
+
+  auto ptcr =
+    PhysicalTable::create_many(
+      rt,
+      *tdescs,
+      task->regions.begin(),
+      task->regions.end(),
+      regions.begin(),
+      regions.end())
+    .value();
+#if HAVE_CXX17
+  auto& [pts, rit, pit] = ptcr;
+#else // !HAVE_CXX17
+  auto& pts = std::get<0>(ptcr);
+#endif // HAVE_CXX17
+
+  // main table columns
+  MSMainTable<MAIN_ROW> main(pts[0]);
+  auto main_data_desc_id_col = main.data_desc_id<AffineAccessor>();
+  auto main_data_desc_id =
+    main_data_desc_id_col.accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_uvw = main.uvw<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // data description table columns
+  MSDataDescriptionTable data_desc(pts[1]);
+  auto dd_spectral_window_id =
+    data_desc.spectral_window_id<AffineAccessor>()
+    .accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // spectral window table columns
+  MSSpWindowTable spw(pts[2]);
+  auto spw_chan_freq_col = spw.chan_freq<AffineAccessor>();
+  auto spw_chan_freq = spw_chan_freq_col.accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // maximum frequency in every spectral window
+  auto chan_freq_rect = spw_chan_freq_col.rect();
+  std::vector<double> max_freq(chan_freq_rect.hi[0] + 1, 0.0);
+  for (PointInRectIterator<2> pir(chan_freq_rect); pir(); pir++)
+    max_freq[pir[0]] = std::max(max_freq[pir[0]], spw_chan_freq[*pir]);
+
+  double result = 0.0;
+  for (PointInRectIterator<main.row_rank> row(main_data_desc_id_col.rect());
+       row();
+       row++) {
+    auto w = std::abs(main_uvw[Point<2>(row[0], 2)]);
+    result =
+      std::max(
+        result,
+        w * max_freq[dd_spectral_window_id[main_data_desc_id[*row]]]);
+  }
+  return result / cc::C::c;
+}
+
+// maximum absolute value of W (in wavelengths) over all rows of the MAIN table
+double
+compute_w_max(
+  Context ctx,
+  Runtime* rt,
+  size_t block_size,
+  const PhysicalTable& main_table,
+  const PhysicalTable& data_description_table,
+  const PhysicalTable& spectral_window_table) {
+
+  ColumnSpacePartition partition =
+    main_table.partition_rows(ctx, rt, {block_size});
+  Table::DescM<3> tdescs;
+  IndexTaskLauncher task(
+    COMPUTE_W_MAX_TASK_ID,
+    rt->get_index_partition_color_space_name(partition.column_ip),
+    TaskArgument(&tdescs, sizeof(tdescs)),
+    ArgumentMap(),
+    Predicate::TRUE_PRED,
+    false,
+    table_mapper);
+  auto parts =
+    add_visibility_requirements(
+      ctx,
+      rt,
+      task,
+      tdescs.data(),
+      partition,
+      main_table,
+      {HYPERION_COLUMN_NAME(MAIN, DATA_DESC_ID),
+       HYPERION_COLUMN_NAME(MAIN, UVW)},
+      data_description_table,
+      spectral_window_table);
+  const std::array<const PhysicalTable*, 3> ptables{
+    &main_table, &data_description_table, &spectral_window_table};
+  for (auto& tbp : ptables)
+    tbp->unmap_regions(ctx, rt);
+  FutureMap fm = rt->execute_index_space(ctx, task);
+  double result = 0.0;
+  for (PointInDomainIterator<1> pid(
+         rt->get_index_partition_color_space(partition.column_ip));
+       pid();
+       pid++)
+    result = std::max(result, fm.get_result<double>(*pid));
+  for (auto& tbp : ptables)
+    tbp->remap_regions(ctx, rt);
+  for (auto& p : parts)
+    p.destroy(ctx, rt);
+  partition.destroy(ctx, rt);
+  return result;
+}
+
+typedef typename synthesis::cf_table_axis<synthesis::CF_W>::type w_value_t;
+
+// index of the value nearest to |w| in a sorted vector of W-projection plane
+// values
+static inline coord_t
+nearest_w_plane(const std::vector<w_value_t>& w_values, double w) {
+  const auto w_abs = std::abs(w);
+  auto w_ub = std::lower_bound(w_values.begin(), w_values.end(), w_abs);
+  if (w_ub == w_values.end()
+      || (w_ub != w_values.begin() && (w_abs - *(w_ub - 1)) < (*w_ub - w_abs)))
+    --w_ub;
+  return std::distance(w_values.begin(), w_ub);
+}
+
+struct GridFootprintTaskArgs {
+  // MAIN, DATA_DESCRIPTION and SPECTRAL_WINDOW tables
+  Table::DescM<3> tdescs;
+  // uv-grid cell size (wavelengths)
+  double uv_cell;
+  // uv-grid size (number of cells)
+  coord_t grid_size;
+  // CF support (number of uv-grid cells)
+  coord_t cf_support;
+};
+
+// bounding box of the uv-grid cells to which visibilities in a block of the
+// MAIN table contribute
+Rect<2>
+compute_grid_footprint_task(
+  const Task* task,
+  const std::vector<PhysicalRegion>& regions,
+  Context ctx,
+  Runtime* rt) {
+
+  const GridFootprintTaskArgs& args =
+    *static_cast<const GridFootprintTaskArgs*>(task->args);
+
+  auto ptcr =
+    PhysicalTable::create_many(
+      rt,
+      args.tdescs,
+      task->regions.begin(),
+      task->regions.end(),
+      regions.begin(),
+      regions.end())
+    .value();
+#if HAVE_CXX17
+  auto& [pts, rit, pit] = ptcr;
+#else // !HAVE_CXX17
+  auto& pts = std::get<0>(ptcr);
+#endif // HAVE_CXX17
+
+  // main table columns
+  MSMainTable<MAIN_ROW> main(pts[0]);
+  auto main_data_desc_id_col = main.data_desc_id<AffineAccessor>();
+  auto main_data_desc_id =
+    main_data_desc_id_col.accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_uvw = main.uvw<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_flag_row =
+    main.flag_row<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // data description table columns
+  MSDataDescriptionTable data_desc(pts[1]);
+  auto dd_spectral_window_id =
+    data_desc.spectral_window_id<AffineAccessor>()
+    .accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // spectral window table columns
+  MSSpWindowTable spw(pts[2]);
+  auto spw_chan_freq_col = spw.chan_freq<AffineAccessor>();
+  auto spw_chan_freq_rect = spw_chan_freq_col.rect();
+  auto spw_chan_freq = spw_chan_freq_col.accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  Rect<2> result = Rect<2>::make_empty();
+  for (PointInRectIterator<main.row_rank> row(main_data_desc_id_col.rect());
+       row();
+       row++) {
+    if (main_flag_row[*row])
+      continue;
+    const auto spw_id = dd_spectral_window_id[main_data_desc_id[*row]];
+    const double u_m = main_uvw[Point<2>(row[0], 0)];
+    const double v_m = main_uvw[Point<2>(row[0], 1)];
+    for (coord_t ch = spw_chan_freq_rect.lo[1];
+         ch <= spw_chan_freq_rect.hi[1];
+         ++ch) {
+      const double scale = spw_chan_freq[Point<2>(spw_id, ch)] / cc::C::c;
+      double uv[2];
+      gridder::grid_coordinates(
+        u_m * scale,
+        v_m * scale,
+        args.uv_cell,
+        args.grid_size,
+        uv);
+      auto cell =
+        gridder::nearest_grid_cell(uv, args.grid_size, args.cf_support);
+      if (cell) {
+        const Point<2> half_support(args.cf_support / 2, args.cf_support / 2);
+        result =
+          result.union_bbox(
+            Rect<2>(cell.value() - half_support, cell.value() + half_support));
+      }
+    }
+  }
+  return result;
+}
+
+// visibility ordering region: the value at every point in a sub-region is the
+// (MAIN row, channel) index of a visibility in the same row block as the
+// sub-region; visibilities are ordered by their bin (W-projection plane,
+// parallactic angle interval, baseline class, uv-tile), and then by MS order
+const constexpr Legion::FieldID vis_order_fid = 0;
+typedef Point<2> vis_order_t;
+
+// visibility bin: W-projection plane, parallactic angle interval, baseline
+// class, uv-tile (u, v)
+typedef std::array<coord_t, 5> vis_bin_t;
+
+struct BinVisibilitiesTaskArgs {
+  // MAIN, DATA_DESCRIPTION, SPECTRAL_WINDOW, ANTENNA and CF tables
+  Table::DescM<5> tdescs;
+  // uv-grid cell size (wavelengths)
+  double uv_cell;
+  // uv-grid size (number of cells)
+  coord_t grid_size;
+  // CF support (number of uv-grid cells)
+  coord_t cf_support;
+  // uv-tile size (number of cells)
+  coord_t uv_tile_size;
+  // parallactic angle interval size
+  PARALLACTIC_ANGLE_TYPE pa_step;
+};
+
+// sort visibilities in a block of the MAIN table by bin
+void
+bin_visibilities_task(
+  const Task* task,
+  const std::vector<PhysicalRegion>& regions,
+  Context ctx,
+  Runtime* rt) {
+
+  const BinVisibilitiesTaskArgs& args =
+    *static_cast<const BinVisibilitiesTaskArgs*>(task->args);
+
+  auto ptcr =
+    PhysicalTable::create_many(
+      rt,
+      args.tdescs,
+      task->regions.begin(),
+      task->regions.end(),
+      regions.begin(),
+      regions.end())
+    .value();
+#if HAVE_CXX17
+  auto& [pts, rit, pit] = ptcr;
+#else // !HAVE_CXX17
+  auto& pts = std::get<0>(ptcr);
+  auto& rit = std::get<1>(ptcr);
+  auto& pit = std::get<2>(ptcr);
+#endif // HAVE_CXX17
+  assert(std::distance(rit, task->regions.end()) == 1);
+  assert(std::distance(pit, regions.end()) == 1);
+
+  // main table columns
+  MSMainTable<MAIN_ROW> main(pts[0]);
+  auto main_data_desc_id =
+    main.data_desc_id<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_uvw = main.uvw<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_flag_row =
+    main.flag_row<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_antenna1 =
+    main.antenna1<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_antenna2 =
+    main.antenna2<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  PhysicalColumnTD<
+    parallactic_angle_dt,
+    main.row_rank,
+    main.row_rank,
+    AffineAccessor> main_parallactic_angle_col(
+      *pts[0].column(parallactic_angle_column_name).value());
+  auto main_parallactic_angle =
+    main_parallactic_angle_col.accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // data description table columns
+  MSDataDescriptionTable data_desc(pts[1]);
+  auto dd_spectral_window_id =
+    data_desc.spectral_window_id<AffineAccessor>()
+    .accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // spectral window table columns
+  MSSpWindowTable spw(pts[2]);
+  auto spw_chan_freq =
+    spw.chan_freq<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // antenna table columns
+  PhysicalColumnTD<antenna_class_dt, 1, 1, AffineAccessor>
+    antenna_class_col(*pts[3].column(antenna_class_column_name).value());
+  auto antenna_class = antenna_class_col.accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // CF table columns
+  synthesis::CFPhysicalTable<GRIDDER_CF_TABLE_AXES> cf(pts[4]);
+  auto cf_w_col = cf.w<AffineAccessor>();
+  auto cf_w = cf_w_col.accessor<READ_ONLY, CHECK_BOUNDS>();
+  std::vector<w_value_t> w_values;
+  for (PointInRectIterator<1> pir(cf_w_col.rect()); pir(); pir++)
+    w_values.push_back(cf_w[*pir]);
+
+  // visibility order
+  const PhysicalRegion& order_pr = *pit;
+  const FieldAccessor<
+    WRITE_DISCARD,
+    vis_order_t,
+    2,
+    coord_t,
+    AffineAccessor<vis_order_t, 2, coord_t>,
+    CHECK_BOUNDS> order(order_pr, vis_order_fid);
+  const Rect<2> order_rect =
+    rt->get_index_space_domain(order_pr.get_logical_region().get_index_space());
+
+  // visibilities that don't contribute to the grid are put into a bin that
+  // sorts after all others
+  const vis_bin_t no_bin{
+    std::numeric_limits<coord_t>::max(),
+    std::numeric_limits<coord_t>::max(),
+    std::numeric_limits<coord_t>::max(),
+    std::numeric_limits<coord_t>::max(),
+    std::numeric_limits<coord_t>::max()};
+  const PAIntervals pa_intervals(0, args.pa_step);
+  std::vector<std::tuple<vis_bin_t, vis_order_t>> bins;
+  bins.reserve(order_rect.volume());
+  for (PointInRectIterator<2> pir(order_rect, false); pir(); pir++) {
+    const Point<main.row_rank> row(pir[0]);
+    const coord_t ch = pir[1];
+    if (main_flag_row[row]) {
+      bins.emplace_back(no_bin, *pir);
+      continue;
+    }
+    const auto spw_id = dd_spectral_window_id[main_data_desc_id[row]];
+    const double scale = spw_chan_freq[Point<2>(spw_id, ch)] / cc::C::c;
+    double uv[2];
+    gridder::grid_coordinates(
+      main_uvw[Point<2>(row[0], 0)] * scale,
+      main_uvw[Point<2>(row[0], 1)] * scale,
+      args.uv_cell,
+      args.grid_size,
+      uv);
+    auto cell = gridder::nearest_grid_cell(uv, args.grid_size, args.cf_support);
+    if (!cell) {
+      bins.emplace_back(no_bin, *pir);
+      continue;
+    }
+    auto c1 = antenna_class[main_antenna1[row]];
+    auto c2 = antenna_class[main_antenna2[row]];
+    bins.emplace_back(
+      vis_bin_t{
+        nearest_w_plane(w_values, main_uvw[Point<2>(row[0], 2)] * scale),
+        static_cast<coord_t>(
+          pa_intervals.find(main_parallactic_angle[row])),
+        (static_cast<coord_t>(std::min(c1, c2)) << 32) | std::max(c1, c2),
+        cell.value()[0] / args.uv_tile_size,
+        cell.value()[1] / args.uv_tile_size},
+      *pir);
+  }
+  // a stable sort retains MS order, which is generally time order, within
+  // every bin
+  std::stable_sort(
+    bins.begin(),
+    bins.end(),
+    [](auto& a, auto& b) {
+      return std::get<0>(a) < std::get<0>(b);
+    });
+  auto b = bins.begin();
+  for (PointInRectIterator<2> pir(order_rect, false); pir(); pir++, b++)
+    order[*pir] = std::get<1>(*b);
+}
+
+struct GridVisibilitiesTaskArgs {
+  // MAIN, DATA_DESCRIPTION, SPECTRAL_WINDOW, gridding kernel directory and
+  // packed gridding kernel tables
+  Table::DescM<5> tdescs;
+  // uv-grid cell size (wavelengths)
+  double uv_cell;
+  // uv-grid size (number of cells)
+  coord_t grid_size;
+  // CF oversampling factor
+  size_t cf_oversampling;
+  // upper bound on gridding kernel support (number of cells)
+  coord_t cf_support;
+  // grid region is a private tile of the uv-grid
+  bool private_tile;
+};
+
+// convolve visibilities in a block of the MAIN table onto the uv-grid
+void
+grid_visibilities_task(
+  const Task* task,
+  const std::vector<PhysicalRegion>& regions,
+  Context ctx,
+  Runtime* rt) {
+
+  const GridVisibilitiesTaskArgs& args =
+    *static_cast<const GridVisibilitiesTaskArgs*>(task->args);
+
+  auto ptcr =
+    PhysicalTable::create_many(
+      rt,
+      args.tdescs,
+      task->regions.begin(),
+      task->regions.end(),
+      regions.begin(),
+      regions.end())
+    .value();
+#if HAVE_CXX17
+  auto& [pts, rit, pit] = ptcr;
+#else // !HAVE_CXX17
+  auto& pts = std::get<0>(ptcr);
+  auto& rit = std::get<1>(ptcr);
+  auto& pit = std::get<2>(ptcr);
+#endif // HAVE_CXX17
+  assert(std::distance(rit, task->regions.end()) == 2);
+  assert(std::distance(pit, regions.end()) == 2);
+
+  // main table columns
+  MSMainTable<MAIN_ROW> main(pts[0]);
+  auto main_data_desc_id =
+    main.data_desc_id<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_uvw = main.uvw<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_data_col = main.data<AffineAccessor>();
+  auto main_data_rect = main_data_col.rect();
+  auto main_data = main_data_col.accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_flag = main.flag<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto main_flag_row =
+    main.flag_row<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  // use WEIGHT_SPECTRUM when it's available, otherwise WEIGHT
+  const bool has_weight_spectrum = main.has_weight_spectrum();
+  CXX_OPTIONAL_NAMESPACE::optional<
+    decltype(
+      main.weight_spectrum<AffineAccessor>()
+      .accessor<READ_ONLY, CHECK_BOUNDS>())> main_weight_spectrum;
+  CXX_OPTIONAL_NAMESPACE::optional<
+    decltype(
+      main.weight<AffineAccessor>()
+      .accessor<READ_ONLY, CHECK_BOUNDS>())> main_weight;
+  if (has_weight_spectrum)
+    main_weight_spectrum =
+      main.weight_spectrum<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+  else
+    main_weight =
+      main.weight<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // data description table columns
+  MSDataDescriptionTable data_desc(pts[1]);
+  auto dd_spectral_window_id =
+    data_desc.spectral_window_id<AffineAccessor>()
+    .accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // spectral window table columns
+  MSSpWindowTable spw(pts[2]);
+  auto spw_chan_freq =
+    spw.chan_freq<AffineAccessor>().accessor<READ_ONLY, CHECK_BOUNDS>();
+
+  // gridding kernel table columns
+  synthesis::CFPhysicalTable<GRIDDER_CF_TABLE_AXES> cf(pts[3]);
+  auto cf_w_col = cf.w<AffineAccessor>();
+  auto cf_w_rect = cf_w_col.rect();
+  auto cf_w = cf_w_col.accessor<READ_ONLY, CHECK_BOUNDS>();
+  std::vector<w_value_t> w_values;
+  for (PointInRectIterator<1> pir(cf_w_rect); pir(); pir++)
+    w_values.push_back(cf_w[*pir]);
+  auto cf_kernel_support =
+    gridding_kernel_table_t::SupportColumn<AffineAccessor>(
+      *cf.column(gridding_kernel_table_t::SUPPORT_COLUMN_NAME).value())
+    .accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto cf_kernel_offset =
+    gridding_kernel_table_t::OffsetColumn<AffineAccessor>(
+      *cf.column(gridding_kernel_table_t::OFFSET_COLUMN_NAME).value())
+    .accessor<READ_ONLY, CHECK_BOUNDS>();
+  auto cf_value =
+    gridding_kernel_table_t::KernelValueColumn<AffineAccessor>(
+      *pts[4].column(synthesis::CFTableBase::CF_VALUE_COLUMN_NAME).value())
+    .accessor<READ_ONLY, CHECK_BOUNDS>();
+  const coord_t cf_oversampling = args.cf_oversampling;
+
+  // visibility order
+  const PhysicalRegion& order_pr = *pit;
+  const FieldAccessor<
+    READ_ONLY,
+    vis_order_t,
+    2,
+    coord_t,
+    AffineAccessor<vis_order_t, 2, coord_t>,
+    CHECK_BOUNDS> order(order_pr, vis_order_fid);
+  const Rect<2> order_rect =
+    rt->get_index_space_domain(order_pr.get_logical_region().get_index_space());
+
+  auto grid_rows =
+    [&](const auto& grid) {
+      for (PointInRectIterator<2> pir(order_rect, false); pir(); pir++) {
+        const vis_order_t vis = order[*pir];
+        const Point<main.row_rank> row(vis[0]);
+        const coord_t ch = vis[1];
+        if (main_flag_row[row])
+          continue;
+        const auto spw_id = dd_spectral_window_id[main_data_desc_id[row]];
+
+        // uvw coordinates in wavelengths
+        const double scale = spw_chan_freq[Point<2>(spw_id, ch)] / cc::C::c;
+        double uv[2];
+        gridder::grid_coordinates(
+          main_uvw[Point<2>(row[0], 0)] * scale,
+          main_uvw[Point<2>(row[0], 1)] * scale,
+          args.uv_cell,
+          args.grid_size,
+          uv);
+        const double w_l = main_uvw[Point<2>(row[0], 2)] * scale;
+
+        // nearest grid point, and the kernel offset from it in units of the
+        // oversampled kernel spacing
+        auto cell =
+          gridder::nearest_grid_cell(uv, args.grid_size, args.cf_support);
+        if (!cell)
+          continue;
+        const Point<2> offset =
+          gridder::subcell_offset(uv, cell.value(), cf_oversampling);
+
+        // nearest W plane; the W term for negative w values is the conjugate
+        // of the W term for the corresponding positive value
+        const coord_t w_i = cf_w_rect.lo[0] + nearest_w_plane(w_values, w_l);
+        const bool conj_cf = w_l < 0;
+
+        // gridding kernel for the W plane
+        const Point<gridding_kernel_table_t::directory_rank> kernel_pt(w_i, 0);
+        const gridding_kernel_table_t::support_t support =
+          cf_kernel_support[kernel_pt];
+        const coord_t kernel_offset = cf_kernel_offset[kernel_pt];
+
+        for (coord_t corr = main_data_rect.lo[2];
+             corr <= main_data_rect.hi[2];
+             ++corr) {
+          const Point<3> vis_pt(row[0], ch, corr);
+          if (main_flag[vis_pt])
+            continue;
+          const float wgt =
+            (has_weight_spectrum
+             ? main_weight_spectrum.value()[vis_pt]
+             : main_weight.value()[Point<2>(row[0], corr)]);
+          const grid_value_t vis = main_data[vis_pt] * wgt;
+          const coord_t grid_corr = corr - main_data_rect.lo[2];
+          gridder::grid_visibility<gridding_kernel_table_t>(
+            cell.value(),
+            offset,
+            support,
+            cf_oversampling,
+            kernel_offset,
+            conj_cf,
+            vis,
+            [&](coord_t i) {
+              return cf_value[i];
+            },
+            [&](coord_t u, coord_t v, const grid_value_t& x) {
+              grid[Point<grid_rank>(grid_corr, u, v)] <<= x;
+            });
+        }
+      }
+    };
+
+  // a private tile is updated by this task alone, and may be accumulated
+  // without atomics; otherwise, updates to the grid may be concurrent with
+  // those of other tasks
+  const PhysicalRegion& grid_pr = *(pit + 1);
+  if (args.private_tile)
+    grid_rows(
+      ReductionAccessor<
+        GridSumRedop,
+        true,
+        grid_rank,
+        coord_t,
+        AffineAccessor<grid_value_t, grid_rank, coord_t>,
+        CHECK_BOUNDS>(grid_pr, grid_value_fid, grid_sum_redop()));
+  else
+    grid_rows(
+      ReductionAccessor<
+        GridSumRedop,
+        false,
+        grid_rank,
+        coord_t,
+        AffineAccessor<grid_value_t, grid_rank, coord_t>,
+        CHECK_BOUNDS>(grid_pr, grid_value_fid, grid_sum_redop()));
+}
+
+// convolve all visibilities onto the uv-grid
+//
+// visibilities in every row block are first sorted by bin, so that the
+// gridding tasks visit visibilities that share a convolution function and
+// uv-tile consecutively; when "private_tiles" is true, every task accumulates
+// its visibilities onto a private tile of the grid that covers the bounding box
+// of the cells to which its visibilities contribute, and the tiles are merged
+// into the grid by the runtime using the reduction operator; otherwise, all
+// tasks reduce directly into the grid; the extent of the contribution of a
+// visibility is bounded by the maximum support of the gridding kernels in
+// "cf_table"
+void
+grid_visibilities(
+  Context ctx,
+  Runtime* rt,
+  size_t block_size,
+  double uv_cell,
+  size_t cf_oversampling,
+  bool private_tiles,
+  size_t uv_tile_size,
+  PARALLACTIC_ANGLE_TYPE pa_step,
+  const PhysicalTable& main_table,
+  const PhysicalTable& data_description_table,
+  const PhysicalTable& spectral_window_table,
+  const PhysicalTable& antenna_table,
+  const gridding_kernel_table_t& cf_table,
+  LogicalRegion grid) {
+
+  ColumnSpacePartition partition =
+    main_table.partition_rows(ctx, rt, {block_size});
+  const Rect<grid_rank> grid_rect =
+    rt->get_index_space_domain(grid.get_index_space());
+  const coord_t grid_size = grid_rect.hi[d_u] + 1;
+
+  const std::array<const PhysicalTable*, 3> ptables{
+    &main_table, &data_description_table, &spectral_window_table};
+
+  // compute the footprint of every row block on the grid, and create a
+  // partition of the grid from the footprints
+  CXX_OPTIONAL_NAMESPACE::optional<IndexPartition> grid_ip;
+  if (private_tiles) {
+    GridFootprintTaskArgs args;
+    args.uv_cell = uv_cell;
+    args.grid_size = grid_size;
+    args.cf_support = cf_table.max_support();
+    IndexTaskLauncher task(
+      COMPUTE_GRID_FOOTPRINT_TASK_ID,
+      rt->get_index_partition_color_space_name(partition.column_ip),
+      TaskArgument(&args, sizeof(args)),
+      ArgumentMap(),
+      Predicate::TRUE_PRED,
+      false,
+      table_mapper);
+    auto parts =
+      add_visibility_requirements(
+        ctx,
+        rt,
+        task,
+        args.tdescs.data(),
+        partition,
+        main_table,
+        {HYPERION_COLUMN_NAME(MAIN, DATA_DESC_ID),
+         HYPERION_COLUMN_NAME(MAIN, UVW),
+         HYPERION_COLUMN_NAME(MAIN, FLAG_ROW)},
+        data_description_table,
+        spectral_window_table);
+    for (auto& tbp : ptables)
+      tbp->unmap_regions(ctx, rt);
+    FutureMap fm = rt->execute_index_space(ctx, task);
+    std::map<DomainPoint, Domain> domains;
+    for (PointInDomainIterator<1> pid(
+           rt->get_index_partition_color_space(partition.column_ip));
+         pid();
+         pid++) {
+      auto footprint = fm.get_result<Rect<2>>(*pid);
+      Rect<grid_rank> tile = grid_rect;
+      tile.lo[d_u] = footprint.lo[0];
+      tile.hi[d_u] = footprint.hi[0];
+      tile.lo[d_v] = footprint.lo[1];
+      tile.hi[d_v] = footprint.hi[1];
+      domains[*pid] = tile;
+    }
+    for (auto& tbp : ptables)
+      tbp->remap_regions(ctx, rt);
+    for (auto& p : parts)
+      p.destroy(ctx, rt);
+    grid_ip =
+      rt->create_partition_by_domain(
+        ctx,
+        grid.get_index_space(),
+        domains,
+        rt->get_index_partition_color_space_name(partition.column_ip),
+        true,
+        LEGION_ALIASED_KIND);
+  }
+
+  // create the visibility order region, with sub-regions that correspond to
+  // the row blocks
+  const Rect<1> rows_rect =
+    rt->get_index_space_domain(main_table.index_column_space_index_space());
+  const Rect<3> data_rect(
+    main_table.column(HYPERION_COLUMN_NAME(MAIN, DATA)).value()->domain());
+  IndexSpace order_is =
+    rt->create_index_space(
+      ctx,
+      Rect<2>(
+        Point<2>(rows_rect.lo[0], data_rect.lo[1]),
+        Point<2>(rows_rect.hi[0], data_rect.hi[1])));
+  FieldSpace order_fs = rt->create_field_space(ctx);
+  {
+    FieldAllocator fa = rt->create_field_allocator(ctx, order_fs);
+    fa.allocate_field(sizeof(vis_order_t), vis_order_fid);
+  }
+  LogicalRegion order_lr = rt->create_logical_region(ctx, order_is, order_fs);
+  IndexPartition order_ip;
+  {
+    std::map<DomainPoint, Domain> domains;
+    for (PointInDomainIterator<1> pid(
+           rt->get_index_partition_color_space(partition.column_ip));
+         pid();
+         pid++) {
+      const Rect<1> block =
+        rt->get_index_space_domain(
+          rt->get_index_subspace(partition.column_ip, *pid));
+      domains[*pid] =
+        Rect<2>(
+          Point<2>(block.lo[0], data_rect.lo[1]),
+          Point<2>(block.hi[0], data_rect.hi[1]));
+    }
+    order_ip =
+      rt->create_partition_by_domain(
+        ctx,
+        order_is,
+        domains,
+        rt->get_index_partition_color_space_name(partition.column_ip),
+        true,
+        LEGION_DISJOINT_COMPLETE_KIND);
+  }
+  LogicalPartition order_lp =
+    rt->get_logical_partition(ctx, order_lr, order_ip);
+
+  // sort visibilities by bin
+  {
+    BinVisibilitiesTaskArgs args;
+    args.uv_cell = uv_cell;
+    args.grid_size = grid_size;
+    args.cf_support = cf_table.max_support();
+    args.uv_tile_size = uv_tile_size;
+    args.pa_step = pa_step;
+    IndexTaskLauncher task(
+      BIN_VISIBILITIES_TASK_ID,
+      rt->get_index_partition_color_space_name(partition.column_ip),
+      TaskArgument(&args, sizeof(args)),
+      ArgumentMap(),
+      Predicate::TRUE_PRED,
+      false,
+      table_mapper);
+    auto parts =
+      add_visibility_requirements(
+        ctx,
+        rt,
+        task,
+        args.tdescs.data(),
+        partition,
+        main_table,
+        {HYPERION_COLUMN_NAME(MAIN, DATA_DESC_ID),
+         HYPERION_COLUMN_NAME(MAIN, UVW),
+         HYPERION_COLUMN_NAME(MAIN, FLAG_ROW),
+         HYPERION_COLUMN_NAME(MAIN, ANTENNA1),
+         HYPERION_COLUMN_NAME(MAIN, ANTENNA2),
+         parallactic_angle_column_name},
+        data_description_table,
+        spectral_window_table);
+    auto antenna_rq =
+      antenna_table
+      .requirements(
+        ctx,
+        rt,
+        ColumnSpacePartition(),
+        {{antenna_class_column_name, Column::default_requirements}},
+        CXX_OPTIONAL_NAMESPACE::nullopt);
+#if HAVE_CXX17
+    auto& [antenna_reqs, antenna_parts, antenna_desc] = antenna_rq;
+#else // !HAVE_CXX17
+    auto& antenna_reqs = std::get<0>(antenna_rq);
+    auto& antenna_parts = std::get<1>(antenna_rq);
+    auto& antenna_desc = std::get<2>(antenna_rq);
+#endif // HAVE_CXX17
+    for (auto& rq : antenna_reqs)
+      task.add_region_requirement(rq);
+    args.tdescs[3] = antenna_desc;
+    std::copy(
+      antenna_parts.begin(),
+      antenna_parts.end(),
+      std::back_inserter(parts));
+    auto cf_rq =
+      cf_table
+      .requirements(
+        ctx,
+        rt,
+        ColumnSpacePartition(),
+        {{synthesis::cf_table_axis<synthesis::CF_W>::name,
+          Column::default_requirements}},
+        CXX_OPTIONAL_NAMESPACE::nullopt);
+#if HAVE_CXX17
+    auto& [cf_reqs, cf_parts, cf_desc] = cf_rq;
+#else // !HAVE_CXX17
+    auto& cf_reqs = std::get<0>(cf_rq);
+    auto& cf_parts = std::get<1>(cf_rq);
+    auto& cf_desc = std::get<2>(cf_rq);
+#endif // HAVE_CXX17
+    for (auto& rq : cf_reqs)
+      task.add_region_requirement(rq);
+    args.tdescs[4] = cf_desc;
+    std::copy(cf_parts.begin(), cf_parts.end(), std::back_inserter(parts));
+    {
+      RegionRequirement req(order_lp, 0, WRITE_DISCARD, EXCLUSIVE, order_lr);
+      req.add_field(vis_order_fid);
+      task.add_region_requirement(req);
+    }
+    antenna_table.unmap_regions(ctx, rt);
+    for (auto& tbp : ptables)
+      tbp->unmap_regions(ctx, rt);
+    rt->execute_index_space(ctx, task);
+    for (auto& tbp : ptables)
+      tbp->remap_regions(ctx, rt);
+    antenna_table.remap_regions(ctx, rt);
+    for (auto& p : parts)
+      p.destroy(ctx, rt);
+  }
+
+  GridVisibilitiesTaskArgs args;
+  args.uv_cell = uv_cell;
+  args.grid_size = grid_size;
+  args.cf_oversampling = cf_oversampling;
+  args.cf_support = cf_table.max_support();
+  args.private_tile = private_tiles;
+  IndexTaskLauncher task(
+    GRID_VISIBILITIES_TASK_ID,
+    rt->get_index_partition_color_space_name(partition.column_ip),
+    TaskArgument(&args, sizeof(args)),
+    ArgumentMap(),
+    Predicate::TRUE_PRED,
+    false,
+    table_mapper);
+
+  std::vector<std::string> visibility_columns{
+    HYPERION_COLUMN_NAME(MAIN, DATA),
+    HYPERION_COLUMN_NAME(MAIN, FLAG)};
+  if (main_table.column(HYPERION_COLUMN_NAME(MAIN, WEIGHT_SPECTRUM)))
+    visibility_columns.push_back(HYPERION_COLUMN_NAME(MAIN, WEIGHT_SPECTRUM));
+  else
+    visibility_columns.push_back(HYPERION_COLUMN_NAME(MAIN, WEIGHT));
+  auto parts =
+    add_visibility_requirements(
+      ctx,
+      rt,
+      task,
+      args.tdescs.data(),
+      partition,
+      main_table,
+      {HYPERION_COLUMN_NAME(MAIN, DATA_DESC_ID),
+       HYPERION_COLUMN_NAME(MAIN, UVW),
+       HYPERION_COLUMN_NAME(MAIN, FLAG_ROW)},
+      data_description_table,
+      spectral_window_table,
+      visibility_columns);
+
+  auto cf_rq =
+    cf_table
+    .requirements(
+      ctx,
+      rt,
+      ColumnSpacePartition(),
+      {{gridding_kernel_table_t::SUPPORT_COLUMN_NAME,
+        Column::default_requirements},
+       {gridding_kernel_table_t::OFFSET_COLUMN_NAME,
+        Column::default_requirements},
+       {synthesis::cf_table_axis<synthesis::CF_W>::name,
+        Column::default_requirements}},
+      CXX_OPTIONAL_NAMESPACE::nullopt);
+#if HAVE_CXX17
+  auto& [cf_reqs, cf_parts, cf_desc] = cf_rq;
+#else // !HAVE_CXX17
+  auto& cf_reqs = std::get<0>(cf_rq);
+  auto& cf_parts = std::get<1>(cf_rq);
+  auto& cf_desc = std::get<2>(cf_rq);
+#endif // HAVE_CXX17
+  for (auto& rq : cf_reqs)
+    task.add_region_requirement(rq);
+  args.tdescs[3] = cf_desc;
+  std::copy(cf_parts.begin(), cf_parts.end(), std::back_inserter(parts));
+  auto kernels_rq =
+    cf_table
+    .kernels()
+    .requirements(
+      ctx,
+      rt,
+      ColumnSpacePartition(),
+      {{synthesis::CFTableBase::CF_VALUE_COLUMN_NAME,
+        Column::default_requirements}},
+      CXX_OPTIONAL_NAMESPACE::nullopt);
+#if HAVE_CXX17
+  auto& [kernels_reqs, kernels_parts, kernels_desc] = kernels_rq;
+#else // !HAVE_CXX17
+  auto& kernels_reqs = std::get<0>(kernels_rq);
+  auto& kernels_parts = std::get<1>(kernels_rq);
+  auto& kernels_desc = std::get<2>(kernels_rq);
+#endif // HAVE_CXX17
+  for (auto& rq : kernels_reqs)
+    task.add_region_requirement(rq);
+  args.tdescs[4] = kernels_desc;
+  std::copy(
+    kernels_parts.begin(),
+    kernels_parts.end(),
+    std::back_inserter(parts));
+
+  {
+    RegionRequirement req(order_lp, 0, READ_ONLY, EXCLUSIVE, order_lr);
+    req.add_field(vis_order_fid);
+    task.add_region_requirement(req);
+  }
+  if (grid_ip) {
+    RegionRequirement
+      req(
+        rt->get_logical_partition(ctx, grid, grid_ip.value()),
+        0,
+        grid_sum_redop(),
+        EXCLUSIVE,
+        grid);
+    req.add_field(grid_value_fid);
+    task.add_region_requirement(req);
+  } else {
+    RegionRequirement req(grid, 0, grid_sum_redop(), EXCLUSIVE, grid);
+    req.add_field(grid_value_fid);
+    task.add_region_requirement(req);
+  }
+
+  for (auto& tbp : ptables)
+    tbp->unmap_regions(ctx, rt);
+  rt->execute_index_space(ctx, task);
+  for (auto& tbp : ptables)
+    tbp->remap_regions(ctx, rt);
+  for (auto& p : parts)
+    p.destroy(ctx, rt);
+  if (grid_ip)
+    rt->destroy_index_partition(ctx, grid_ip.value());
+  rt->destroy_logical_region(ctx, order_lr);
+  rt->destroy_field_space(ctx, order_fs);
+  rt->destroy_index_space(ctx, order_is);
+  partition.destroy(ctx, rt);
+}
+
+// name of the uv-grid dataset in the output file
+static const char grid_dataset_name[] = "/GRID";
+
+// name of the uv-grid cell size (wavelengths) attribute of the uv-grid dataset
+static const char grid_uv_cell_attr_name[] = "uv_cell";
+
+// write the uv-grid to a dataset in a new HDF5 file, with axes (correlation, u,
+// v)
+static void
+write_grid(
+  Context ctx,
+  Runtime* rt,
+  const CXX_FILESYSTEM_NAMESPACE::path& path,
+  double uv_cell,
+  LogicalRegion grid) {
+
+  // create the dataset
+  const Rect<grid_rank> grid_rect =
+    rt->get_index_space_domain(grid.get_index_space());
+  {
+    hid_t h5f = CHECK_H5(H5DatatypeManager::create(path, H5F_ACC_TRUNC));
+    std::array<hsize_t, grid_rank> dims;
+    for (size_t i = 0; i < grid_rank; ++i)
+      dims[i] = grid_rect.hi[i] + 1;
+    hid_t sp = CHECK_H5(H5Screate_simple(grid_rank, dims.data(), NULL));
+    hid_t ds =
+      CHECK_H5(
+        H5Dcreate(
+          h5f,
+          grid_dataset_name,
+          H5DatatypeManager::datatype<HYPERION_TYPE_COMPLEX>(),
+          sp,
+          H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+    hid_t attr_sp = CHECK_H5(H5Screate(H5S_SCALAR));
+    hid_t attr =
+      CHECK_H5(
+        H5Acreate(
+          ds,
+          grid_uv_cell_attr_name,
+          H5T_NATIVE_DOUBLE,
+          attr_sp,
+          H5P_DEFAULT,
+          H5P_DEFAULT));
+    CHECK_H5(H5Awrite(attr, H5T_NATIVE_DOUBLE, &uv_cell));
+    CHECK_H5(H5Aclose(attr));
+    CHECK_H5(H5Sclose(attr_sp));
+    CHECK_H5(H5Dclose(ds));
+    CHECK_H5(H5Sclose(sp));
+    CHECK_H5(H5Fclose(h5f));
+  }
+
+  // attach a region to the dataset, and copy the grid into it
+  LogicalRegion h5_lr =
+    rt->create_logical_region(
+      ctx,
+      grid.get_index_space(),
+      grid.get_field_space());
+  AttachLauncher attach(EXTERNAL_HDF5_FILE, h5_lr, h5_lr);
+  attach.attach_hdf5(
+    path.c_str(),
+    {{grid_value_fid, grid_dataset_name}},
+    LEGION_FILE_READ_WRITE);
+  PhysicalRegion h5_pr = rt->attach_external_resource(ctx, attach);
+  CopyLauncher copy;
+  copy.add_copy_requirements(
+    RegionRequirement(grid, READ_ONLY, EXCLUSIVE, grid),
+    RegionRequirement(h5_lr, WRITE_DISCARD, EXCLUSIVE, h5_lr));
+  copy.add_src_field(0, grid_value_fid);
+  copy.add_dst_field(0, grid_value_fid);
+  rt->issue_copy_operation(ctx, copy);
+  rt->detach_external_resource(ctx, h5_pr, true);
+  rt->destroy_logical_region(ctx, h5_lr);
+}
+
+template <typename gridder::args_t G>
+void
+show_help(const gridder::Args<G>& args) {
+  std::ostringstream oss;
+  oss << "Usage: gridder [LEGION OPTIONS] [GRIDDER OPTIONS]"
+      << std::endl
+      << "  valid GRIDDER OPTIONS (all options have values):"
+      << std::endl;
+  size_t max_tag_len = 0;
+  std::map<std::string, std::string> h = args.help();
+  for (auto& t_d : h)
+    max_tag_len = std::max(std::get<0>(t_d).size(), max_tag_len);
+  for (auto& t_d : h) {
+    auto& tag = std::get<0>(t_d);
+    auto& desc = std::get<1>(t_d);
+    oss << std::setw(max_tag_len + 4) << std::right << tag
+        << std::string(": ") << desc
+        << std::endl;
+  }
+  std::cout << oss.str();
+}
+
+void
+gridder_task(
+  const Task*,
+  const std::vector<PhysicalRegion>&,
+  Context ctx,
+  Runtime* rt) {
+
+  // process command line arguments
+  //
   CXX_OPTIONAL_NAMESPACE::optional<gridder::Args<gridder::VALUE_ARGS>>
     gridder_args;
   {
@@ -751,9 +2182,22 @@ gridder_task(
         CHECK_H5(H5Fclose(h5f));
       });
 
-  // attach table columns to HDF5
+  // attach table columns to HDF5; the MAIN table is wide, so attach only
+  // those columns used by the gridder, and defer attaching the rest
   //
   std::unordered_map<MSTables, PhysicalTable> ptables;
+  const std::unordered_set<std::string> main_projection{
+    HYPERION_COLUMN_NAME(MAIN, ANTENNA1),
+    HYPERION_COLUMN_NAME(MAIN, ANTENNA2),
+    HYPERION_COLUMN_NAME(MAIN, DATA),
+    HYPERION_COLUMN_NAME(MAIN, DATA_DESC_ID),
+    HYPERION_COLUMN_NAME(MAIN, FEED1),
+    HYPERION_COLUMN_NAME(MAIN, FLAG),
+    HYPERION_COLUMN_NAME(MAIN, FLAG_ROW),
+    HYPERION_COLUMN_NAME(MAIN, TIME),
+    HYPERION_COLUMN_NAME(MAIN, UVW),
+    HYPERION_COLUMN_NAME(MAIN, WEIGHT),
+    HYPERION_COLUMN_NAME(MAIN, WEIGHT_SPECTRUM)};
   for (auto& mst_tbpths : tables) {
     auto& mst = std::get<0>(mst_tbpths);
     auto& tb_pths = std::get<1>(mst_tbpths);
@@ -764,9 +2208,20 @@ gridder_task(
       auto& nm = std::get<0>(pth);
       modes[nm] = {true/*read-only*/, true/*restricted*/, false/*mapped*/};
     }
+    CXX_OPTIONAL_NAMESPACE::optional<std::unordered_set<std::string>>
+      projection;
+    if (mst == MS_MAIN)
+      projection = main_projection;
     ptables.emplace(
       mst,
-      tb.attach_columns(ctx, rt, g_args->h5_path.value(), pths, modes));
+      tb.attach_columns(
+        ctx,
+        rt,
+        g_args->h5_path.value(),
+        pths,
+        modes,
+        projection,
+        true/*zero-copy*/));
   }
 
   // re-index some tables
@@ -816,14 +2271,149 @@ gridder_task(
     ptables.at(MS_ANTENNA),
     itables.at(MS_FEED));
 
-  // TODO: the rest goes here
-  synthesis::PSTermTable ps_term(ctx, rt, 30, 30, {0.4f});
-  synthesis::WTermTable w_term(ctx, rt, 30, 30, {0.01, 0.01}, {0.4, 0.25, 0.1});
+  // image and uv-grid cell sizes
+  //
+  const size_t grid_size = g_args->grid_size.value();
+  const size_t cf_size = g_args->cf_size.value();
+  const size_t cf_oversampling = g_args->cf_oversampling.value();
+  const double cell = g_args->cell_size.value() * cc::C::arcsec;
+  const double uv_cell = 1.0 / (grid_size * cell);
 
-  //gridder::compute_cf_task<1>(NULL, {}, ctx, rt);
+  // W-projection plane values, uniformly spaced in |w| (wavelengths)
+  //
+  std::vector<typename synthesis::cf_table_axis<synthesis::CF_W>::type>
+    w_values{0.0};
+  if (g_args->w_planes.value() > 1) {
+    const double w_max =
+      compute_w_max(
+        ctx,
+        rt,
+        g_args->min_block.value(),
+        ptables.at(MS_MAIN),
+        ptables.at(MS_DATA_DESCRIPTION),
+        ptables.at(MS_SPECTRAL_WINDOW));
+    const int n = g_args->w_planes.value();
+    w_values.clear();
+    for (int i = 0; i < n; ++i)
+      w_values.push_back(w_max * i / (n - 1));
+  }
+
+  // FFTW wisdom may be kept in a file named by an environment variable, so that
+  // planning costs are not repeated between runs
+  const auto cf_fft_precision =
+    ((typeid(synthesis::CFTableBase::cf_fp_t) == typeid(float))
+     ? synthesis::FFT::Precision::SINGLE
+     : synthesis::FFT::Precision::DOUBLE);
+  synthesis::FFT::import_wisdom(ctx, rt, cf_fft_precision);
+
+  // compute gridding kernels; CF grid coordinates span the image domain, and
+  // the CFs are zero-padded by the oversampling factor before the FFT, so that
+  // the kernels are oversampled in the uv domain
+  //
+  auto cf_tbl =
+    [&]() {
+      const size_t image_cf_size = cf_size / cf_oversampling;
+      const double cf_radius = grid_size * cell / 2;
+      synthesis::GridCoordinateTable cf_coords(ctx, rt, image_cf_size, {0.0});
+      cf_coords.compute_coordinates(
+        ctx,
+        rt,
+        cc::LinearCoordinate(2),
+        cf_radius);
+      synthesis::PSTermTable
+        ps_tbl(
+          ctx,
+          rt,
+          image_cf_size,
+          {static_cast<float>(2.0 / (grid_size * cell))});
+      ps_tbl.compute_cfs(ctx, rt, cf_coords);
+      synthesis::WTermTable w_tbl(ctx, rt, image_cf_size, w_values);
+      w_tbl.compute_cfs(ctx, rt, cf_coords);
+      cf_coords.destroy(ctx, rt);
+      auto product =
+        synthesis::ProductCFTable<GRIDDER_CF_TABLE_AXES>::create_and_fill(
+          ctx,
+          rt,
+          ColumnSpacePartition(),
+          w_tbl,
+          ps_tbl);
+      ps_tbl.destroy(ctx, rt);
+      w_tbl.destroy(ctx, rt);
+      auto result =
+        gridding_kernel_table_t::create(
+          ctx,
+          rt,
+          product,
+          cf_oversampling,
+          g_args->cf_threshold.value(),
+          FFTW_MEASURE,
+          5.0);
+      product.destroy(ctx, rt);
+      return result;
+    }();
+
+  // create the uv-grid, with one plane per correlation
+  //
+  const coord_t num_corr =
+    Rect<3>(
+      ptables
+      .at(MS_MAIN)
+      .column(HYPERION_COLUMN_NAME(MAIN, DATA)).value()
+      ->domain())
+    .hi[2] + 1;
+  IndexSpace grid_is =
+    rt->create_index_space(
+      ctx,
+      Rect<grid_rank>(
+        Point<grid_rank>(0, 0, 0),
+        Point<grid_rank>(
+          num_corr - 1,
+          static_cast<coord_t>(grid_size) - 1,
+          static_cast<coord_t>(grid_size) - 1)));
+  FieldSpace grid_fs = rt->create_field_space(ctx);
+  {
+    FieldAllocator fa = rt->create_field_allocator(ctx, grid_fs);
+    fa.allocate_field(sizeof(grid_value_t), grid_value_fid);
+  }
+  LogicalRegion grid_lr = rt->create_logical_region(ctx, grid_is, grid_fs);
+  {
+    const grid_value_t zero = GridSumRedop::identity;
+    rt->fill_field(ctx, grid_lr, grid_lr, grid_value_fid, zero);
+  }
+
+  // grid the visibilities
+  //
+  grid_visibilities(
+    ctx,
+    rt,
+    g_args->min_block.value(),
+    uv_cell,
+    cf_oversampling,
+    g_args->grid_tiles.value(),
+    g_args->uv_tile_size.value(),
+    g_args->pa_step.value(),
+    ptables.at(MS_MAIN),
+    ptables.at(MS_DATA_DESCRIPTION),
+    ptables.at(MS_SPECTRAL_WINDOW),
+    ptables.at(MS_ANTENNA),
+    cf_tbl,
+    grid_lr);
+
+  // write the uv-grid
+  //
+  write_grid(ctx, rt, g_args->output_path.value(), uv_cell, grid_lr);
 
   // clean up
   //
+  rt->destroy_logical_region(ctx, grid_lr);
+  rt->destroy_field_space(ctx, grid_fs);
+  rt->destroy_index_space(ctx, grid_is);
+  cf_tbl.destroy(ctx, rt);
+  // wait for all FFTs to complete before exporting wisdom and destroying cached
+  // FFT plans
+  rt->issue_execution_fence(ctx).wait();
+  synthesis::FFT::export_wisdom(ctx, rt, cf_fft_precision);
+  synthesis::FFT::clear_plan_cache(ctx, rt);
   ptables.at(MS_MAIN).remove_columns(ctx, rt, {parallactic_angle_column_name});
   ptables.at(MS_ANTENNA).remove_columns(ctx, rt, {antenna_class_column_name});
 
@@ -864,10 +2454,26 @@ main(int argc, char* argv[]) {
     registrar.add_layout_constraint_set(
       TableMapper::to_mapping_tag(TableMapper::default_column_layout_tag),
       aos_right_layout);
+    TableMapper::add_layouts(registrar);
     Runtime::preregister_task_variant<classify_antennas_task>(
       registrar,
       "classify_antennas_task");
   }
+  {
+    TaskVariantRegistrar registrar(
+      COMPUTE_UNIQUE_PARALLACTIC_ANGLES_TASK_ID,
+      "compute_unique_parallactic_angles_task");
+    registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
+    registrar.set_leaf();
+    registrar.set_idempotent();
+    registrar.add_layout_constraint_set(
+      TableMapper::to_mapping_tag(TableMapper::default_column_layout_tag),
+      aos_right_layout);
+    TableMapper::add_layouts(registrar);
+    Runtime::preregister_task_variant<compute_unique_parallactic_angles_task>(
+      registrar,
+      "compute_unique_parallactic_angles_task");
+  }
   {
     TaskVariantRegistrar registrar(
       COMPUTE_PARALLACTIC_ANGLES_TASK_ID,
@@ -878,14 +2484,74 @@ main(int argc, char* argv[]) {
     registrar.add_layout_constraint_set(
       TableMapper::to_mapping_tag(TableMapper::default_column_layout_tag),
       aos_right_layout);
+    TableMapper::add_layouts(registrar);
     Runtime::preregister_task_variant<compute_parallactic_angles_task>(
       registrar,
       "compute_parallactic_angles_task");
   }
+  {
+    TaskVariantRegistrar registrar(
+      COMPUTE_W_MAX_TASK_ID,
+      "compute_w_max_task");
+    registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
+    registrar.set_leaf();
+    registrar.set_idempotent();
+    registrar.add_layout_constraint_set(
+      TableMapper::to_mapping_tag(TableMapper::default_column_layout_tag),
+      aos_right_layout);
+    TableMapper::add_layouts(registrar);
+    Runtime::preregister_task_variant<double, compute_w_max_task>(
+      registrar,
+      "compute_w_max_task");
+  }
+  {
+    TaskVariantRegistrar registrar(
+      COMPUTE_GRID_FOOTPRINT_TASK_ID,
+      "compute_grid_footprint_task");
+    registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
+    registrar.set_leaf();
+    registrar.set_idempotent();
+    registrar.add_layout_constraint_set(
+      TableMapper::to_mapping_tag(TableMapper::default_column_layout_tag),
+      aos_right_layout);
+    TableMapper::add_layouts(registrar);
+    Runtime::preregister_task_variant<Rect<2>, compute_grid_footprint_task>(
+      registrar,
+      "compute_grid_footprint_task");
+  }
+  {
+    TaskVariantRegistrar registrar(
+      BIN_VISIBILITIES_TASK_ID,
+      "bin_visibilities_task");
+    registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
+    registrar.set_leaf();
+    registrar.set_idempotent();
+    registrar.add_layout_constraint_set(
+      TableMapper::to_mapping_tag(TableMapper::default_column_layout_tag),
+      aos_right_layout);
+    TableMapper::add_layouts(registrar);
+    Runtime::preregister_task_variant<bin_visibilities_task>(
+      registrar,
+      "bin_visibilities_task");
+  }
+  {
+    TaskVariantRegistrar registrar(
+      GRID_VISIBILITIES_TASK_ID,
+      "grid_visibilities_task");
+    registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
+    registrar.set_leaf();
+    registrar.add_layout_constraint_set(
+      TableMapper::to_mapping_tag(TableMapper::default_column_layout_tag),
+      aos_right_layout);
+    TableMapper::add_layouts(registrar);
+    Runtime::preregister_task_variant<grid_visibilities_task>(
+      registrar,
+      "grid_visibilities_task");
+  }
   //Runtime::register_reduction_op<LastPointRedop<1>>(LAST_POINT_REDOP);
   synthesis::CFTableBase::preregister_all();
-  synthesis::PSTermTable::preregister_tasks();
-  synthesis::WTermTable::preregister_tasks();
+  synthesis::ProductCFTable<GRIDDER_CF_TABLE_AXES>::preregister_tasks();
+  gridding_kernel_table_t::preregister_tasks();
   return Runtime::start(argc, argv);
 }
 
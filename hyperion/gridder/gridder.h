@@ -13,8 +13,14 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#ifndef HYPERION_GRIDDER_GRIDDER_H_
+#define HYPERION_GRIDDER_GRIDDER_H_
+
 #include <hyperion/hyperion.h>
 
+#include <cmath>
+#include CXX_OPTIONAL_HEADER
+
 #define PARALLACTIC_ANGLE_TYPE float
 #define PARALLACTIC_360 ((PARALLACTIC_ANGLE_TYPE)360.0)
 
@@ -22,6 +28,103 @@
 #define INVALID_W_PROJ_PLANES_VALUE -2
 #define INVALID_MIN_BLOCK_SIZE_VALUE 0
 
+namespace hyperion {
+namespace gridder {
+
+/**
+ * (fractional) uv-grid coordinates of a point with uv coordinates "u" and "v"
+ * (wavelengths), for a grid with its origin at the center of the grid
+ */
+inline void
+grid_coordinates(
+  double u,
+  double v,
+  double uv_cell,
+  Legion::coord_t grid_size,
+  double uv[2]) {
+
+  const double grid_center = static_cast<double>(grid_size / 2);
+  uv[0] = u / uv_cell + grid_center;
+  uv[1] = v / uv_cell + grid_center;
+}
+
+/**
+ * nearest uv-grid cell to a point with (fractional) grid coordinates "uv",
+ * when all grid cells within the support of a gridding kernel centered on that
+ * cell lie on the grid
+ */
+inline CXX_OPTIONAL_NAMESPACE::optional<Legion::Point<2>>
+nearest_grid_cell(
+  const double uv[2],
+  Legion::coord_t grid_size,
+  Legion::coord_t support) {
+
+  const Legion::Point<2> result(std::lrint(uv[0]), std::lrint(uv[1]));
+  for (size_t i = 0; i < 2; ++i)
+    if (result[i] - support / 2 < 0 || result[i] + support / 2 >= grid_size)
+      return CXX_OPTIONAL_NAMESPACE::nullopt;
+  return result;
+}
+
+/**
+ * offset of a point with (fractional) grid coordinates "uv" from the grid cell
+ * "cell", in units of the oversampled kernel spacing
+ */
+inline Legion::Point<2>
+subcell_offset(
+  const double uv[2],
+  const Legion::Point<2>& cell,
+  Legion::coord_t oversampling) {
+
+  return
+    Legion::Point<2>(
+      std::lrint((uv[0] - cell[0]) * oversampling),
+      std::lrint((uv[1] - cell[1]) * oversampling));
+}
+
+/**
+ * convolve a single (weighted) visibility onto the uv-grid
+ *
+ * Kernel values are those of a packed gridding kernel of a
+ * synthesis::GriddingKernelTable type KT, starting at "kernel_offset";
+ * "kernel(i)" returns the kernel value at index "i" of the packed kernel
+ * values, and "grid(u, v, x)" accumulates the value "x" onto the grid cell
+ * (u, v). When "conj" is true, the kernel values are conjugated.
+ */
+template <typename KT, typename V, typename KernelF, typename GridF>
+inline void
+grid_visibility(
+  const Legion::Point<2>& cell,
+  const Legion::Point<2>& offset,
+  typename KT::support_t support,
+  Legion::coord_t oversampling,
+  Legion::coord_t kernel_offset,
+  bool conj,
+  const V& vis,
+  const KernelF& kernel,
+  const GridF& grid) {
+
+  const Legion::coord_t kernel_size = KT::box_size(support, oversampling);
+  for (Legion::coord_t du = -support / 2; du <= support / 2; ++du) {
+    const Legion::coord_t kernel_row =
+      kernel_offset
+      + KT::box_index(support, oversampling, du, offset[0]) * kernel_size;
+    for (Legion::coord_t dv = -support / 2; dv <= support / 2; ++dv) {
+      const Legion::coord_t kernel_col =
+        KT::box_index(support, oversampling, dv, offset[1]);
+      V cfv = kernel(kernel_row + kernel_col);
+      if (conj)
+        cfv = V(cfv.real(), -cfv.imag());
+      grid(cell[0] + du, cell[1] + dv, cfv * vis);
+    }
+  }
+}
+
+} // end namespace gridder
+} // end namespace hyperion
+
+#endif // HYPERION_GRIDDER_GRIDDER_H_
+
 // Local Variables:
 // mode: c++
 // c-basic-offset: 2
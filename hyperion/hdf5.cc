@@ -28,6 +28,12 @@
 #include <numeric>
 #include CXX_OPTIONAL_HEADER
 #include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace hyperion::hdf5;
 using namespace hyperion;
@@ -650,12 +656,52 @@ hyperion::hdf5::write_measure(
 }
 #endif //HYPERION_USE_CASACORE
 
+// HDF5 limits the size of a dataset chunk to 4GB
+static const hsize_t max_chunk_bytes = (hsize_t(1) << 32) - 1;
+
+static hid_t
+column_dataset_creation_plist(
+  unsigned rank,
+  const hsize_t* dims,
+  hid_t dt,
+  const ColumnDatasetOptions& options) {
+
+  if (options.chunk_rows == 0 || rank == 0)
+    return H5P_DEFAULT;
+  hsize_t chunk_dims[rank];
+  hsize_t row_bytes = H5Tget_size(dt);
+  for (unsigned i = 0; i < rank; ++i) {
+    // chunk dimensions must be positive, so zero-sized datasets must remain
+    // contiguous
+    if (dims[i] == 0)
+      return H5P_DEFAULT;
+    chunk_dims[i] = dims[i];
+    if (i > 0)
+      row_bytes *= dims[i];
+  }
+  chunk_dims[0] =
+    std::max(
+      std::min(
+        std::min(static_cast<hsize_t>(options.chunk_rows), dims[0]),
+        max_chunk_bytes / row_bytes),
+      static_cast<hsize_t>(1));
+
+  hid_t result = CHECK_H5(H5Pcreate(H5P_DATASET_CREATE));
+  CHECK_H5(H5Pset_chunk(result, rank, chunk_dims));
+  if (options.shuffle)
+    CHECK_H5(H5Pset_shuffle(result));
+  if (options.deflate > 0)
+    CHECK_H5(H5Pset_deflate(result, std::min(options.deflate, 9u)));
+  return result;
+}
+
 void
 hyperion::hdf5::write_column(
   Runtime* rt,
   hid_t col_grp_id,
   const std::string& cs_name,
-  const PhysicalColumn& column) {
+  const PhysicalColumn& column,
+  const ColumnDatasetOptions& options) {
 
   auto axes =
     ColumnSpace::from_axis_vector(ColumnSpace::axes(column.metadata()));
@@ -692,6 +738,7 @@ hyperion::hdf5::write_column(
         break;
     }
 
+    hid_t dcpl = column_dataset_creation_plist(rank, dims, dt, options);
     hid_t col_id =
       CHECK_H5(
         H5Dcreate(
@@ -699,7 +746,9 @@ hyperion::hdf5::write_column(
           HYPERION_COLUMN_DS,
           dt,
           ds,
-          H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+          H5P_DEFAULT, dcpl, H5P_DEFAULT));
+    if (dcpl != H5P_DEFAULT)
+      CHECK_H5(H5Pclose(dcpl));
     CHECK_H5(H5Sclose(ds));
     CHECK_H5(H5Dclose(col_id));
 
@@ -795,7 +844,8 @@ hyperion::hdf5::write_column(
   Runtime* rt,
   hid_t col_grp_id,
   const std::string& column_space_name,
-  const Column& column) {
+  const Column& column,
+  const ColumnDatasetOptions& options) {
 
   std::vector<int> axes;
   {
@@ -843,6 +893,7 @@ hyperion::hdf5::write_column(
         break;
     }
 
+    hid_t dcpl = column_dataset_creation_plist(rank, dims, dt, options);
     hid_t col_id =
       CHECK_H5(
         H5Dcreate(
@@ -850,7 +901,9 @@ hyperion::hdf5::write_column(
           HYPERION_COLUMN_DS,
           dt,
           ds,
-          H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+          H5P_DEFAULT, dcpl, H5P_DEFAULT));
+    if (dcpl != H5P_DEFAULT)
+      CHECK_H5(H5Pclose(dcpl));
     CHECK_H5(H5Sclose(ds));
     CHECK_H5(H5Dclose(col_id));
 
@@ -1038,13 +1091,58 @@ remove_column_space_groups(
   return 0;
 }
 
+static void
+write_chunk_rows(
+  hid_t table_grp_id,
+  const ColumnDatasetOptions& options) {
+
+  htri_t rc =
+    CHECK_H5(H5Aexists(table_grp_id, HYPERION_ATTRIBUTE_CHUNK_ROWS));
+  if (rc > 0)
+    CHECK_H5(H5Adelete(table_grp_id, HYPERION_ATTRIBUTE_CHUNK_ROWS));
+  if (options.chunk_rows > 0) {
+    hid_t ds = CHECK_H5(H5Screate(H5S_SCALAR));
+    hid_t attr_id =
+      CHECK_H5(
+        H5Acreate(
+          table_grp_id,
+          HYPERION_ATTRIBUTE_CHUNK_ROWS,
+          H5T_NATIVE_HSIZE,
+          ds,
+          H5P_DEFAULT, H5P_DEFAULT));
+    hsize_t chunk_rows = options.chunk_rows;
+    CHECK_H5(H5Awrite(attr_id, H5T_NATIVE_HSIZE, &chunk_rows));
+    CHECK_H5(H5Aclose(attr_id));
+    CHECK_H5(H5Sclose(ds));
+  }
+}
+
+CXX_OPTIONAL_NAMESPACE::optional<size_t>
+hyperion::hdf5::read_chunk_rows(hid_t table_grp_id) {
+
+  CXX_OPTIONAL_NAMESPACE::optional<size_t> result;
+  htri_t rc =
+    CHECK_H5(H5Aexists(table_grp_id, HYPERION_ATTRIBUTE_CHUNK_ROWS));
+  if (rc > 0) {
+    hid_t attr_id =
+      CHECK_H5(
+        H5Aopen(table_grp_id, HYPERION_ATTRIBUTE_CHUNK_ROWS, H5P_DEFAULT));
+    hsize_t chunk_rows;
+    CHECK_H5(H5Aread(attr_id, H5T_NATIVE_HSIZE, &chunk_rows));
+    CHECK_H5(H5Aclose(attr_id));
+    result = chunk_rows;
+  }
+  return result;
+}
+
 static void
 write_table_columns(
   Context ctx,
   Runtime* rt,
   hid_t table_grp_id,
   hid_t table_axes_dt,
-  const std::unordered_map<std::string, Column>& columns) {
+  const std::unordered_map<std::string, Column>& columns,
+  const ColumnDatasetOptions& options) {
 
   if (columns.size() == 0)
     return;
@@ -1091,7 +1189,7 @@ write_table_columns(
             table_grp_id,
             colname.c_str(),
             H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
-      write_column(ctx, rt, col_grp_id, cs_nm, columns.at(colname));
+      write_column(ctx, rt, col_grp_id, cs_nm, columns.at(colname), options);
       CHECK_H5(H5Gclose(col_grp_id));
     }
   }
@@ -1102,7 +1200,8 @@ write_table_columns(
   Runtime* rt,
   hid_t table_grp_id,
   hid_t table_axes_dt,
-  const PhysicalTable& table) {
+  const PhysicalTable& table,
+  const ColumnDatasetOptions& options) {
 
   auto columns = table.columns();
   std::map<ColumnSpace, std::set<std::string>> column_groups;
@@ -1153,7 +1252,7 @@ write_table_columns(
             table_grp_id,
             colname.c_str(),
             H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
-      write_column(rt, col_grp_id, cs_nm, *columns.at(colname));
+      write_column(rt, col_grp_id, cs_nm, *columns.at(colname), options);
       CHECK_H5(H5Gclose(col_grp_id));
     }
   }
@@ -1163,7 +1262,8 @@ void
 hyperion::hdf5::write_table(
   Runtime* rt,
   hid_t table_grp_id,
-  const PhysicalTable& table) {
+  const PhysicalTable& table,
+  const ColumnDatasetOptions& options) {
 
   if (table.columns().size() == 0)
     return;
@@ -1239,7 +1339,9 @@ hyperion::hdf5::write_table(
   // FIXME: awaiting Table keywords support...
   // write_keywords(rt, table_grp_id, table.m_kws);
 
-  write_table_columns(rt, table_grp_id, table_axes_dt, table);
+  write_chunk_rows(table_grp_id, options);
+
+  write_table_columns(rt, table_grp_id, table_axes_dt, table, options);
 }
 
 void
@@ -1248,7 +1350,8 @@ hyperion::hdf5::write_table(
   Runtime* rt,
   hid_t table_grp_id,
   const Table& table,
-  const std::unordered_set<std::string>& columns) {
+  const std::unordered_set<std::string>& columns,
+  const ColumnDatasetOptions& options) {
 
   auto tbl_columns = table.columns();
 
@@ -1333,7 +1436,15 @@ hyperion::hdf5::write_table(
       selected_columns[col] = tbl_columns.at(col);
   }
 
-  write_table_columns(ctx, rt, table_grp_id, table_axes_dt, selected_columns);
+  write_chunk_rows(table_grp_id, options);
+
+  write_table_columns(
+    ctx,
+    rt,
+    table_grp_id,
+    table_axes_dt,
+    selected_columns,
+    options);
 }
 
 void
@@ -1341,7 +1452,8 @@ hyperion::hdf5::write_table(
   Context ctx,
   Runtime* rt,
   hid_t table_grp_id,
-  const Table& table) {
+  const Table& table,
+  const ColumnDatasetOptions& options) {
 
   auto tbl_columns = table.columns();
 
@@ -1349,7 +1461,7 @@ hyperion::hdf5::write_table(
   for (auto& nm_col : tbl_columns)
     columns.insert(std::get<0>(nm_col));
 
-  write_table(ctx, rt, table_grp_id, table, columns);
+  write_table(ctx, rt, table_grp_id, table, columns, options);
 }
 
 static herr_t
@@ -2084,17 +2196,15 @@ hyperion::hdf5::attach_keywords(
   return rt->attach_external_resource(ctx, kws_attach);
 }
 
-CXX_OPTIONAL_NAMESPACE::optional<PhysicalRegion>
-hyperion::hdf5::attach_table_columns(
-  Context ctx,
-  Runtime* rt,
-  const CXX_FILESYSTEM_NAMESPACE::path& file_path,
+// column region and field paths for a selection of columns, all of which must
+// share a single ColumnSpace
+static CXX_OPTIONAL_NAMESPACE::optional<
+  std::tuple<LogicalRegion, std::map<FieldID, std::string>>>
+selected_column_paths(
   const std::string& root_path,
   const Table& table,
   const std::unordered_set<std::string>& columns,
-  const std::unordered_map<std::string, std::string>& column_paths,
-  bool read_only,
-  bool mapped) {
+  const std::unordered_map<std::string, std::string>& column_paths) {
 
   auto table_columns = table.columns();
   CXX_OPTIONAL_NAMESPACE::optional<ColumnSpace> cs;
@@ -2121,7 +2231,21 @@ hyperion::hdf5::attach_table_columns(
   }
   if (paths.size() == 0)
     return CXX_OPTIONAL_NAMESPACE::nullopt;
-  AttachLauncher attach(EXTERNAL_HDF5_FILE, lr, lr, true, mapped);
+  return std::make_tuple(lr, paths);
+}
+
+static PhysicalRegion
+attach_column_paths(
+  Context ctx,
+  Runtime* rt,
+  const CXX_FILESYSTEM_NAMESPACE::path& file_path,
+  const LogicalRegion& lr,
+  const LogicalRegion& parent,
+  const std::map<FieldID, std::string>& paths,
+  bool read_only,
+  bool mapped) {
+
+  AttachLauncher attach(EXTERNAL_HDF5_FILE, lr, parent, true, mapped);
   std::map<FieldID, const char*> field_map;
   for (auto& fid_p : paths)
     field_map[std::get<0>(fid_p)] = std::get<1>(fid_p).c_str();
@@ -2132,6 +2256,266 @@ hyperion::hdf5::attach_table_columns(
   return rt->attach_external_resource(ctx, attach);
 }
 
+CXX_OPTIONAL_NAMESPACE::optional<PhysicalRegion>
+hyperion::hdf5::attach_table_columns(
+  Context ctx,
+  Runtime* rt,
+  const CXX_FILESYSTEM_NAMESPACE::path& file_path,
+  const std::string& root_path,
+  const Table& table,
+  const std::unordered_set<std::string>& columns,
+  const std::unordered_map<std::string, std::string>& column_paths,
+  bool read_only,
+  bool mapped) {
+
+  auto lr_paths =
+    selected_column_paths(root_path, table, columns, column_paths);
+  if (!lr_paths)
+    return CXX_OPTIONAL_NAMESPACE::nullopt;
+  auto& lr = std::get<0>(lr_paths.value());
+  return
+    attach_column_paths(
+      ctx,
+      rt,
+      file_path,
+      lr,
+      lr,
+      std::get<1>(lr_paths.value()),
+      read_only,
+      mapped);
+}
+
+std::tuple<
+  IndexPartition,
+  std::vector<std::tuple<LogicalRegion, PhysicalRegion>>>
+hyperion::hdf5::attach_table_columns(
+  Context ctx,
+  Runtime* rt,
+  const CXX_FILESYSTEM_NAMESPACE::path& file_path,
+  const std::string& root_path,
+  const Table& table,
+  const std::unordered_set<std::string>& columns,
+  const std::unordered_map<std::string, std::string>& column_paths,
+  const std::vector<Rect<1>>& rows,
+  bool read_only,
+  bool mapped) {
+
+  // the row ranges must be sorted and non-overlapping (as are the values of
+  // select_rows()), as the partition by the ranges is disjoint
+  if (std::adjacent_find(
+        rows.begin(),
+        rows.end(),
+        [](const Rect<1>& r0, const Rect<1>& r1) {
+          return r0.hi[0] >= r1.lo[0];
+        }) != rows.end())
+    throw std::invalid_argument("Row ranges are unsorted or overlapping");
+
+  std::vector<std::tuple<LogicalRegion, PhysicalRegion>> result;
+  auto lr_paths =
+    selected_column_paths(root_path, table, columns, column_paths);
+  if (!lr_paths || rows.size() == 0)
+    return std::make_tuple(IndexPartition::NO_PART, result);
+  auto& lr = std::get<0>(lr_paths.value());
+  auto& paths = std::get<1>(lr_paths.value());
+
+  // partition the column region by the row ranges, spanning the full extent of
+  // the column in all other axes
+  const Domain bounds = rt->get_index_space_domain(lr.get_index_space());
+  std::map<DomainPoint, Domain> domains;
+  for (size_t i = 0; i < rows.size(); ++i) {
+    DomainPoint lo = bounds.lo();
+    DomainPoint hi = bounds.hi();
+    lo[0] = std::max(lo[0], rows[i].lo[0]);
+    hi[0] = std::min(hi[0], rows[i].hi[0]);
+    domains[Point<1>(i)] = Domain(lo, hi);
+  }
+  IndexSpace cs = rt->create_index_space(ctx, Rect<1>(0, rows.size() - 1));
+  IndexPartition ip =
+    rt->create_partition_by_domain(
+      ctx,
+      lr.get_index_space(),
+      domains,
+      cs,
+      true,
+      LEGION_DISJOINT_KIND);
+  LogicalPartition lp = rt->get_logical_partition(ctx, lr, ip);
+  for (size_t i = 0; i < rows.size(); ++i) {
+    LogicalRegion sublr = rt->get_logical_subregion_by_color(ctx, lp, i);
+    if (!rt->get_index_space_domain(sublr.get_index_space()).empty())
+      result.emplace_back(
+        sublr,
+        attach_column_paths(
+          ctx,
+          rt,
+          file_path,
+          sublr,
+          lr,
+          paths,
+          read_only,
+          mapped));
+  }
+  return std::make_tuple(ip, result);
+}
+
+std::vector<Rect<1>>
+hyperion::hdf5::select_rows(
+  hid_t loc_id,
+  const std::string& dataset_path,
+  const std::function<bool(int)>& predicate,
+  size_t block_size) {
+
+  std::vector<Rect<1>> result;
+  hid_t ds = CHECK_H5(H5Dopen(loc_id, dataset_path.c_str(), H5P_DEFAULT));
+  hid_t spc = CHECK_H5(H5Dget_space(ds));
+  [[maybe_unused]] int rank = CHECK_H5(H5Sget_simple_extent_ndims(spc));
+  assert(rank == 1);
+  hsize_t num_rows;
+  CHECK_H5(H5Sget_simple_extent_dims(spc, &num_rows, NULL));
+  block_size = std::max(std::min(block_size, size_t(num_rows)), size_t(1));
+  std::vector<int> values(block_size);
+  hsize_t blk = block_size;
+  hid_t mem_spc = CHECK_H5(H5Screate_simple(1, &blk, NULL));
+  CXX_OPTIONAL_NAMESPACE::optional<coord_t> run_start;
+  for (hsize_t start = 0; start < num_rows; start += block_size) {
+    hsize_t count = std::min(num_rows - start, hsize_t(block_size));
+    CHECK_H5(
+      H5Sselect_hyperslab(spc, H5S_SELECT_SET, &start, NULL, &count, NULL));
+    hsize_t zero = 0;
+    CHECK_H5(
+      H5Sselect_hyperslab(
+        mem_spc,
+        H5S_SELECT_SET,
+        &zero,
+        NULL,
+        &count,
+        NULL));
+    CHECK_H5(
+      H5Dread(ds, H5T_NATIVE_INT, mem_spc, spc, H5P_DEFAULT, values.data()));
+    for (hsize_t i = 0; i < count; ++i) {
+      coord_t row = start + i;
+      if (predicate(values[i])) {
+        if (!run_start)
+          run_start = row;
+      } else if (run_start) {
+        result.emplace_back(run_start.value(), row - 1);
+        run_start = CXX_OPTIONAL_NAMESPACE::nullopt;
+      }
+    }
+  }
+  if (run_start)
+    result.emplace_back(run_start.value(), coord_t(num_rows) - 1);
+  CHECK_H5(H5Sclose(mem_spc));
+  CHECK_H5(H5Sclose(spc));
+  CHECK_H5(H5Dclose(ds));
+  return result;
+}
+
+CXX_OPTIONAL_NAMESPACE::optional<std::vector<Rect<1>>>
+hyperion::hdf5::select_rows(
+  const CXX_FILESYSTEM_NAMESPACE::path& file_path,
+  const std::string& dataset_path,
+  const std::function<bool(int)>& predicate,
+  size_t block_size) {
+
+  CXX_OPTIONAL_NAMESPACE::optional<std::vector<Rect<1>>> result;
+  hid_t file_id = H5Fopen(file_path.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  if (file_id >= 0) {
+    result = select_rows(file_id, dataset_path, predicate, block_size);
+    CHECK_H5(H5Fclose(file_id));
+  }
+  return result;
+}
+
+std::shared_ptr<FileMap>
+hyperion::hdf5::FileMap::open(
+  const CXX_FILESYSTEM_NAMESPACE::path& file_path) {
+
+  std::shared_ptr<FileMap> result;
+  int fd = ::open(file_path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* addr = ::mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (addr != MAP_FAILED)
+        result.reset(new FileMap(addr, st.st_size));
+    }
+    // the mapping remains valid after the file is closed
+    ::close(fd);
+  }
+  return result;
+}
+
+hyperion::hdf5::FileMap::~FileMap() {
+  ::munmap(m_addr, m_size);
+}
+
+CXX_OPTIONAL_NAMESPACE::optional<PhysicalRegion>
+hyperion::hdf5::attach_mapped_dataset(
+  Context ctx,
+  Runtime* rt,
+  const FileMap& file_map,
+  hid_t loc_id,
+  const std::string& dataset_path,
+  const LogicalRegion& lr,
+  const LogicalRegion& parent,
+  FieldID fid,
+  hyperion::TypeTag dt,
+  Memory memory,
+  bool restricted,
+  bool mapped) {
+
+  hid_t mem_type;
+  switch (dt) {
+#define DT(T)   case T: mem_type = H5DatatypeManager::datatype<T>(); break;
+    HYPERION_FOREACH_DATATYPE(DT)
+#undef DT
+  default:
+    assert(false);
+    mem_type = -1;
+    break;
+  }
+
+  CXX_OPTIONAL_NAMESPACE::optional<size_t> offset;
+  const Domain dom = rt->get_index_space_domain(lr.get_index_space());
+  hid_t ds = CHECK_H5(H5Dopen(loc_id, dataset_path.c_str(), H5P_DEFAULT));
+  hid_t dcpl = CHECK_H5(H5Dget_create_plist(ds));
+  hid_t spc = CHECK_H5(H5Dget_space(ds));
+  hid_t ds_type = CHECK_H5(H5Dget_type(ds));
+  haddr_t addr = H5Dget_offset(ds);
+  if (H5Pget_layout(dcpl) == H5D_CONTIGUOUS
+      && addr != HADDR_UNDEF
+      && H5Tequal(ds_type, mem_type) > 0
+      && dom.dense()
+      && H5Sget_simple_extent_ndims(spc) == dom.get_dim()) {
+    // the dataset must cover exactly the region bounds, starting at the origin
+    std::vector<hsize_t> dims(dom.get_dim());
+    CHECK_H5(H5Sget_simple_extent_dims(spc, dims.data(), NULL));
+    bool match = true;
+    for (int i = 0; match && i < dom.get_dim(); ++i)
+      match = dom.lo()[i] == 0 && dom.hi()[i] + 1 == coord_t(dims[i]);
+    size_t elt_size = H5Tget_size(ds_type);
+    if (match
+        && addr % std::min(elt_size, sizeof(double)) == 0
+        && addr + dom.get_volume() * elt_size <= file_map.size())
+      offset = addr;
+  }
+  CHECK_H5(H5Tclose(ds_type));
+  CHECK_H5(H5Sclose(spc));
+  CHECK_H5(H5Pclose(dcpl));
+  CHECK_H5(H5Dclose(ds));
+  if (!offset)
+    return CXX_OPTIONAL_NAMESPACE::nullopt;
+
+  AttachLauncher attach(EXTERNAL_INSTANCE, lr, parent, restricted, mapped);
+  // the mapping is read-only, but Legion requires a non-const base pointer
+  attach.attach_array_soa(
+    const_cast<char*>(file_map.data()) + offset.value(),
+    false,
+    {fid},
+    memory);
+  return rt->attach_external_resource(ctx, attach);
+}
+
 template <typename F>
 std::map<PhysicalRegion, std::unordered_map<std::string, Column>>
 attach_selected_table_columns(
@@ -2169,8 +2553,8 @@ attach_selected_table_columns(
         table,
         colnames,
         column_paths,
-        mapped,
-        read_only);
+        read_only,
+        mapped);
     if (opr)
       result[opr.value()] = cols;
   }
@@ -31,6 +31,8 @@
 #include <cstring>
 #include <exception>
 #include CXX_FILESYSTEM_HEADER
+#include <functional>
+#include <memory>
 #include CXX_OPTIONAL_HEADER
 #include <string>
 #include <unordered_set>
@@ -57,6 +59,7 @@ namespace hdf5 {
 #define HYPERION_ATTRIBUTE_DS HYPERION_NAMESPACE_PREFIX "ds"
 #define HYPERION_ATTRIBUTE_DS_PREFIX HYPERION_ATTRIBUTE_DS HYPERION_NAME_SEP
 #define HYPERION_ATTRIBUTE_FID HYPERION_NAMESPACE_PREFIX "fid"
+#define HYPERION_ATTRIBUTE_CHUNK_ROWS HYPERION_NAMESPACE_PREFIX "chunk_rows"
 #define HYPERION_COLUMN_DS HYPERION_NAMESPACE_PREFIX "col"
 #define HYPERION_COLUMN_SPACE_GROUP HYPERION_NAMESPACE_PREFIX "colsp"
 #define HYPERION_COLUMN_SPACE_GROUP_PREFIX HYPERION_COLUMN_SPACE_GROUP HYPERION_NAME_SEP
@@ -90,6 +93,18 @@ namespace hdf5 {
 
 // FIXME: HDF5 call error handling
 
+// Storage layout options for column datasets. The default value produces
+// contiguous, unfiltered datasets. When chunk_rows is non-zero, column datasets
+// are chunked with chunk_rows elements along the row (first) axis and the full
+// extent along all other axes, so that a chunk matches a block of a row-wise
+// ColumnSpacePartition with the same block size. Compression filters are only
+// applied to chunked datasets.
+struct HYPERION_EXPORT ColumnDatasetOptions {
+  size_t chunk_rows = 0; // rows per chunk (0: contiguous)
+  unsigned deflate = 0; // deflate compression level, 1-9 (0: none)
+  bool shuffle = false; // apply shuffle filter before compression
+};
+
 template <typename SERDEZ>
 void
 write_index_tree_to_attr(
@@ -282,7 +297,8 @@ write_column(
   Legion::Runtime* rt,
   hid_t col_grp_id,
   const std::string& cs_name,
-  const PhysicalColumn& column);
+  const PhysicalColumn& column,
+  const ColumnDatasetOptions& options = ColumnDatasetOptions());
 
 HYPERION_EXPORT void
 write_column(
@@ -290,7 +306,8 @@ write_column(
   Legion::Runtime* rt,
   hid_t col_grp_id,
   const std::string& cs_name,
-  const Column& column);
+  const Column& column,
+  const ColumnDatasetOptions& options = ColumnDatasetOptions());
 
 HYPERION_EXPORT void
 write_columnspace(
@@ -312,7 +329,8 @@ HYPERION_EXPORT void
 write_table(
   Legion::Runtime* rt,
   hid_t table_grp_id,
-  const PhysicalTable& table);
+  const PhysicalTable& table,
+  const ColumnDatasetOptions& options = ColumnDatasetOptions());
 
 HYPERION_EXPORT void
 write_table(
@@ -320,14 +338,22 @@ write_table(
   Legion::Runtime* rt,
   hid_t table_grp_id,
   const Table& table,
-  const std::unordered_set<std::string>& columns);
+  const std::unordered_set<std::string>& columns,
+  const ColumnDatasetOptions& options = ColumnDatasetOptions());
 
 HYPERION_EXPORT void
 write_table(
   Legion::Context ctx,
   Legion::Runtime* rt,
   hid_t table_grp_id,
-  const Table& table);
+  const Table& table,
+  const ColumnDatasetOptions& options = ColumnDatasetOptions());
+
+// rows per chunk of a table's column datasets, as recorded by write_table();
+// readers may use this as the block size of a row-wise table partition in
+// order to align sub-regions with dataset chunks
+HYPERION_EXPORT CXX_OPTIONAL_NAMESPACE::optional<size_t>
+read_chunk_rows(hid_t table_grp_id);
 
 HYPERION_EXPORT hyperion::Keywords::kw_desc_t
 init_keywords(hid_t loc_id);
@@ -400,6 +426,108 @@ attach_table_columns(
   bool read_only,
   bool mapped);
 
+// attach columns over only the given ranges of rows (i.e, of the first axis of
+// the column regions), with one attachment per range; the ranges must be sorted
+// and non-overlapping, like the values of select_rows(), otherwise
+// std::invalid_argument is thrown; values are the
+// partition of the column region by the ranges, and the sub-regions of the
+// column region corresponding to the ranges together with their attachments,
+// which are backed by hyperslab reads of the column datasets; after detaching
+// all the sub-regions, the caller must destroy the partition and its color
+// space
+HYPERION_EXPORT std::tuple<
+  Legion::IndexPartition,
+  std::vector<std::tuple<Legion::LogicalRegion, Legion::PhysicalRegion>>>
+attach_table_columns(
+  Legion::Context ctx,
+  Legion::Runtime* rt,
+  const CXX_FILESYSTEM_NAMESPACE::path& file_path,
+  const std::string& root_path,
+  const Table& table,
+  const std::unordered_set<std::string>& columns,
+  const std::unordered_map<std::string, std::string>& column_paths,
+  const std::vector<Legion::Rect<1>>& rows,
+  bool read_only,
+  bool mapped);
+
+// compute the (sorted, disjoint and maximal) ranges of rows at which the
+// values of a one-dimensional, integer-valued column dataset, like
+// DATA_DESC_ID, FIELD_ID or SCAN_NUMBER, satisfy a predicate; the dataset is
+// read directly in blocks of "block_size" rows
+HYPERION_EXPORT std::vector<Legion::Rect<1>>
+select_rows(
+  hid_t loc_id,
+  const std::string& dataset_path,
+  const std::function<bool(int)>& predicate,
+  size_t block_size = 1 << 20);
+
+// as above, for a dataset in a file; value is empty when the file cannot be
+// opened
+HYPERION_EXPORT CXX_OPTIONAL_NAMESPACE::optional<std::vector<Legion::Rect<1>>>
+select_rows(
+  const CXX_FILESYSTEM_NAMESPACE::path& file_path,
+  const std::string& dataset_path,
+  const std::function<bool(int)>& predicate,
+  size_t block_size = 1 << 20);
+
+// read-only memory map of an entire file, for zero-copy attachment of
+// contiguous datasets; the mapping is released upon destruction, which must
+// follow the detachment of all regions attached to it
+class HYPERION_EXPORT FileMap {
+public:
+
+  // value is null when the file cannot be mapped
+  static std::shared_ptr<FileMap>
+  open(const CXX_FILESYSTEM_NAMESPACE::path& file_path);
+
+  FileMap(const FileMap&) = delete;
+
+  FileMap&
+  operator=(const FileMap&) = delete;
+
+  ~FileMap();
+
+  const char*
+  data() const {
+    return static_cast<const char*>(m_addr);
+  }
+
+  size_t
+  size() const {
+    return m_size;
+  }
+
+private:
+
+  FileMap(void* addr, size_t size)
+    : m_addr(addr)
+    , m_size(size) {}
+
+  void* m_addr;
+
+  size_t m_size;
+};
+
+// attach a field of a region directly to the data of a dataset in a mapped
+// file, without copying; this is only possible when the dataset storage is
+// contiguous and allocated, the dataset datatype is the in-memory datatype of
+// the field, and the dataset extent is that of the region, otherwise the value
+// is empty
+HYPERION_EXPORT CXX_OPTIONAL_NAMESPACE::optional<Legion::PhysicalRegion>
+attach_mapped_dataset(
+  Legion::Context ctx,
+  Legion::Runtime* rt,
+  const FileMap& file_map,
+  hid_t loc_id,
+  const std::string& dataset_path,
+  const Legion::LogicalRegion& lr,
+  const Legion::LogicalRegion& parent,
+  Legion::FieldID fid,
+  hyperion::TypeTag dt,
+  Legion::Memory memory,
+  bool restricted,
+  bool mapped);
+
 HYPERION_EXPORT std::map<
   Legion::PhysicalRegion,
   std::unordered_map<std::string, Column>>
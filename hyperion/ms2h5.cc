@@ -18,11 +18,13 @@
 #include <hyperion/Table.h>
 #include <hyperion/PhysicalTable.h>
 #include <hyperion/TableReadTask.h>
+#include <hyperion/TableMapper.h>
 
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include CXX_FILESYSTEM_HEADER
 #include <unordered_set>
 
@@ -34,6 +36,7 @@ enum {
   READ_TABLE_FROM_MS_TASK_ID,
   READ_MS_TABLE_COLUMNS_TASK_ID,
   CREATE_H5_TASK_ID,
+  WRITE_H5_BLOCK_TASK_ID,
 };
 
 enum {
@@ -46,6 +49,9 @@ enum {
 #define ROW_BLOCK_SZ 100000
 // maximum number of tables
 #define MAX_TABLES 100
+// maximum number of row blocks in flight when streaming: one block being read
+// from the MS while the previous block is written to the HDF5 file
+#define STREAM_BLOCKS_IN_FLIGHT 2
 
 template <PrivilegeMode MODE>
 using NameAccessor =
@@ -56,18 +62,69 @@ using NameAccessor =
   coord_t,
   AffineAccessor<hyperion::string, 1, coord_t>>;
 
+// command line flag to select streaming mode, with a memory budget argument (in
+// MiB)
+static const char* stream_mem_flag = "--stream-mem";
+
+// command line flags to select chunked and compressed column datasets
+static const char* chunk_rows_flag = "--chunk-rows";
+static const char* deflate_flag = "--deflate";
+static const char* shuffle_flag = "--shuffle";
+
 void
 get_args(
   const InputArgs& args,
   CXX_FILESYSTEM_NAMESPACE::path& ms_path,
   std::vector<std::string>& tables,
-  CXX_FILESYSTEM_NAMESPACE::path& h5_path) {
+  CXX_FILESYSTEM_NAMESPACE::path& h5_path,
+  CXX_OPTIONAL_NAMESPACE::optional<size_t>& stream_mem,
+  hdf5::ColumnDatasetOptions& dataset_options) {
 
   ms_path.clear();
   tables.clear();
   h5_path.clear();
+  stream_mem.reset();
+  dataset_options = hdf5::ColumnDatasetOptions();
   for (int i = 1; i < args.argc; ++i) {
-    if (*args.argv[i] != '-') {
+    if (std::strcmp(args.argv[i], stream_mem_flag) == 0) {
+      if (i < args.argc - 1) {
+        char* end;
+        auto mem = std::strtoul(args.argv[i + 1], &end, 10);
+        if (*end == '\0' && mem > 0)
+          stream_mem = mem;
+        else
+          std::cerr << "Invalid " << stream_mem_flag << " value '"
+                    << args.argv[i + 1] << "': streaming disabled"
+                    << std::endl;
+        ++i;
+      }
+    } else if (std::strcmp(args.argv[i], chunk_rows_flag) == 0) {
+      if (i < args.argc - 1) {
+        char* end;
+        auto rows = std::strtoul(args.argv[i + 1], &end, 10);
+        if (*end == '\0' && rows > 0)
+          dataset_options.chunk_rows = rows;
+        else
+          std::cerr << "Invalid " << chunk_rows_flag << " value '"
+                    << args.argv[i + 1] << "': ignored"
+                    << std::endl;
+        ++i;
+      }
+    } else if (std::strcmp(args.argv[i], deflate_flag) == 0) {
+      if (i < args.argc - 1) {
+        char* end;
+        auto level = std::strtoul(args.argv[i + 1], &end, 10);
+        if (*end == '\0' && level > 0 && level <= 9)
+          dataset_options.deflate = level;
+        else
+          std::cerr << "Invalid " << deflate_flag << " value '"
+                    << args.argv[i + 1] << "': compression disabled"
+                    << std::endl;
+        ++i;
+      }
+    } else if (std::strcmp(args.argv[i], shuffle_flag) == 0) {
+      dataset_options.shuffle = true;
+    } else if (*args.argv[i] != '-') {
       if (ms_path.empty()) {
         std::string d = args.argv[i];
         while (d.size() > 0 && d.back() == '/')
@@ -83,6 +140,12 @@ get_args(
     }
   }
 
+  // filters can only be applied to chunked datasets; default chunk size
+  // matches the row blocks used for reading the MS
+  if (dataset_options.chunk_rows == 0
+      && (dataset_options.deflate > 0 || dataset_options.shuffle))
+    dataset_options.chunk_rows = ROW_BLOCK_SZ;
+
   bool inc =
     std::any_of(
       tables.begin(),
@@ -210,6 +273,7 @@ read_ms_table_columns_task(
 struct CreateH5Args {
   char h5_path[MAX_PATHLEN];
   unsigned n_tables;
+  hdf5::ColumnDatasetOptions dataset_options;
   Table::DescM<50> desc;
 };
 
@@ -320,7 +384,7 @@ create_h5_task(
           root_grp_id,
           names[i].val,
           H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
-    hdf5::write_table(rt, table_grp_id, tables[i]);
+    hdf5::write_table(rt, table_grp_id, tables[i], args->dataset_options);
     CHECK_H5(H5Gclose(table_grp_id));
     auto cols = tables[i].columns();
     std::unordered_set<std::string> cnames;
@@ -336,6 +400,158 @@ create_h5_task(
   return create_h5_result_t{column_maps};
 }
 
+struct WriteH5BlockTaskArgs {
+  char h5_path[MAX_PATHLEN];
+  char table_name[MAX_PATHLEN];
+  Table::Desc desc;
+};
+
+const char* write_h5_block_task_name = "write_h5_block";
+
+template <hyperion::TypeTag DT, int DIM>
+static void
+write_column_block(hid_t col_id, const PhysicalColumn& column) {
+
+  PhysicalColumnTD<DT, 1, DIM, AffineAccessor> col(column);
+  Rect<DIM> rect = col.rect();
+  if (rect.empty())
+    return;
+  auto values = col.template accessor<READ_ONLY>();
+
+  hsize_t start[DIM];
+  hsize_t count[DIM];
+  for (size_t i = 0; i < DIM; ++i) {
+    start[i] = rect.lo[i];
+    count[i] = rect.hi[i] - rect.lo[i] + 1;
+  }
+  hid_t file_space = CHECK_H5(H5Dget_space(col_id));
+  CHECK_H5(
+    H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL));
+  hid_t mem_space = CHECK_H5(H5Screate_simple(DIM, count, NULL));
+  // the task layout constraint ensures that values in the block are contiguous
+  // in row-major order, matching the dataset hyperslab
+  CHECK_H5(
+    H5Dwrite(
+      col_id,
+      H5DatatypeManager::datatype<DT>(),
+      mem_space,
+      file_space,
+      H5P_DEFAULT,
+      values.ptr(rect.lo)));
+  CHECK_H5(H5Sclose(mem_space));
+  CHECK_H5(H5Sclose(file_space));
+}
+
+template <int DIM>
+static void
+write_column_block(hid_t col_id, const PhysicalColumn& column) {
+
+  switch (column.dt()) {
+#define WRITE_COL(DT)                               \
+    case DT:                                        \
+      write_column_block<DT, DIM>(col_id, column);  \
+      break;
+    HYPERION_FOREACH_DATATYPE(WRITE_COL);
+#undef WRITE_COL
+    default:
+      assert(false);
+      break;
+  }
+}
+
+// write values in a block of rows to the (pre-existing) column datasets of a
+// table in an HDF5 file
+void
+write_h5_block_task(
+  const Task* task,
+  const std::vector<PhysicalRegion>& regions,
+  Context ctx,
+  Runtime* rt) {
+
+  const WriteH5BlockTaskArgs* args =
+    static_cast<const WriteH5BlockTaskArgs*>(task->args);
+
+  auto ptcr =
+    PhysicalTable::create(
+      rt,
+      args->desc,
+      task->regions.begin(),
+      task->regions.end(),
+      regions.begin(),
+      regions.end())
+    .value();
+#if HAVE_CXX17
+  auto& [table, rit, pit] = ptcr;
+#else // !HAVE_CXX17
+  auto& table = std::get<0>(ptcr);
+  auto& rit = std::get<1>(ptcr);
+  auto& pit = std::get<2>(ptcr);
+#endif // HAVE_CXX17
+  assert(rit == task->regions.end());
+  assert(pit == regions.end());
+
+  std::unordered_set<std::string> cnames;
+  for (auto& nm_col : table.columns())
+    if (std::get<0>(nm_col) != "")
+      cnames.insert(std::get<0>(nm_col));
+
+  hid_t file_id = CHECK_H5(H5Fopen(args->h5_path, H5F_ACC_RDWR, H5P_DEFAULT));
+  auto col_paths =
+    hdf5::get_table_column_paths(
+      file_id,
+      std::string("/") + args->table_name,
+      cnames);
+  for (auto& nm_path : col_paths) {
+#if HAVE_CXX17
+    auto& [nm, path] = nm_path;
+#else // !HAVE_CXX17
+    auto& nm = std::get<0>(nm_path);
+    auto& path = std::get<1>(nm_path);
+#endif // HAVE_CXX17
+    auto column = table.column(nm).value();
+    hid_t col_id = CHECK_H5(H5Dopen(file_id, path.c_str(), H5P_DEFAULT));
+    switch (column->domain().get_dim()) {
+#define WRITE_COLUMN(D)                        \
+    case D:                                    \
+      write_column_block<D>(col_id, *column);  \
+      break;
+#if LEGION_MAX_DIM >= 1
+      WRITE_COLUMN(1);
+#endif
+#if LEGION_MAX_DIM >= 2
+      WRITE_COLUMN(2);
+#endif
+#if LEGION_MAX_DIM >= 3
+      WRITE_COLUMN(3);
+#endif
+#if LEGION_MAX_DIM >= 4
+      WRITE_COLUMN(4);
+#endif
+#undef WRITE_COLUMN
+    default:
+      assert(false);
+      break;
+    }
+    CHECK_H5(H5Dclose(col_id));
+  }
+  CHECK_H5(H5Fclose(file_id));
+}
+
+// size of values of a given type
+static size_t
+value_size(hyperion::TypeTag dt) {
+  switch (dt) {
+#define VALUE_SIZE(DT)                                \
+  case DT:                                            \
+    return sizeof(typename DataType<DT>::ValueType);
+    HYPERION_FOREACH_DATATYPE(VALUE_SIZE);
+#undef VALUE_SIZE
+  default:
+    assert(false);
+    return 0;
+  }
+}
+
 class TopLevelTask {
 public:
 
@@ -347,7 +563,16 @@ public:
     runtime->print_once(
       context,
       stderr,
-      "usage: ms2h5 [OPTION...] MS [TABLE...] OUTPUT\n");
+      "usage: ms2h5 [OPTION...] MS [TABLE...] OUTPUT\n"
+      "  --stream-mem MB  stream table rows from MS to OUTPUT in blocks "
+      "sized for MB MiB\n"
+      "                   of column values; MB is a target, not a limit, as "
+      "memory\n"
+      "                   holding written blocks is reclaimed by the runtime "
+      "lazily\n"
+      "  --chunk-rows N   store column datasets in chunks of N rows\n"
+      "  --deflate LEVEL  compress column datasets at deflate LEVEL (1-9)\n"
+      "  --shuffle        apply shuffle filter to column datasets\n");
   }
 
   static bool
@@ -503,7 +728,9 @@ public:
     CXX_FILESYSTEM_NAMESPACE::path ms;
     std::vector<std::string> table_args;
     CXX_FILESYSTEM_NAMESPACE::path h5;
-    get_args(args, ms, table_args, h5);
+    CXX_OPTIONAL_NAMESPACE::optional<size_t> stream_mem;
+    hdf5::ColumnDatasetOptions dataset_options;
+    get_args(args, ms, table_args, h5, stream_mem, dataset_options);
 
     if (!args_ok(ms, table_args, h5, ctx, rt))
       return;
@@ -571,6 +798,7 @@ public:
       CreateH5Args create_args;
       fstrcpy(create_args.h5_path, h5.c_str());
       create_args.n_tables = tables.size();
+      create_args.dataset_options = dataset_options;
       TaskLauncher write(
         CREATE_H5_TASK_ID,
         TaskArgument(&create_args, sizeof(create_args)));
@@ -601,6 +829,42 @@ public:
         rt->execute_task(ctx, write).get_result<create_h5_result_t>().maps;
     }
 
+    if (stream_mem)
+      stream_tables(
+        ctx,
+        rt,
+        ms,
+        h5,
+        table_names,
+        tables,
+        stream_mem.value(),
+        dataset_options.chunk_rows);
+    else
+      attach_and_read_tables(ctx, rt, ms, h5, table_names, tables, column_paths);
+
+    for (auto& t : tables)
+      t.destroy(ctx, rt);
+
+    auto fs = table_info_lr.get_field_space();
+    auto is = table_info_lr.get_index_space();
+    rt->destroy_logical_region(ctx, table_info_lr);
+    rt->destroy_field_space(ctx, fs);
+    rt->destroy_index_space(ctx, is);
+  }
+
+  // attach HDF5 datasets to the table columns, and read all MS values into the
+  // attached regions
+  static void
+  attach_and_read_tables(
+    Context ctx,
+    Runtime* rt,
+    const CXX_FILESYSTEM_NAMESPACE::path& ms,
+    const CXX_FILESYSTEM_NAMESPACE::path& h5,
+    const std::vector<std::string>& table_names,
+    const std::vector<Table>& tables,
+    const std::vector<std::unordered_map<std::string, std::string>>&
+      column_paths) {
+
     // Attach HDF5 columns
     std::vector<PhysicalTable> ptables;
     for (size_t i = 0; i < tables.size(); ++i) {
@@ -641,15 +905,169 @@ public:
       rd_args.desc = tdesc;
       rt->execute_task(ctx, task);
     }
+  }
 
-    for (auto& t : tables)
-      t.destroy(ctx, rt);
+  // read MS values into the table columns one block of rows at a time, writing
+  // each block to the HDF5 datasets after it has been read; the size of the row
+  // blocks is chosen so that the values in STREAM_BLOCKS_IN_FLIGHT blocks fit
+  // within the memory budget "stream_mem" (MiB), and is rounded to a multiple
+  // of the dataset chunk size "chunk_rows" (when non-zero); the budget is not
+  // enforced, since instances holding written blocks are only released when the
+  // runtime collects them, after the blocks have been filled with zeros
+  static void
+  stream_tables(
+    Context ctx,
+    Runtime* rt,
+    const CXX_FILESYSTEM_NAMESPACE::path& ms,
+    const CXX_FILESYSTEM_NAMESPACE::path& h5,
+    const std::vector<std::string>& table_names,
+    const std::vector<Table>& tables,
+    size_t stream_mem,
+    size_t chunk_rows) {
 
-    auto fs = table_info_lr.get_field_space();
-    auto is = table_info_lr.get_index_space();
-    rt->destroy_logical_region(ctx, table_info_lr);
-    rt->destroy_field_space(ctx, fs);
-    rt->destroy_index_space(ctx, is);
+    const size_t budget = stream_mem * (1 << 20);
+    for (size_t i = 0; i < tables.size(); ++i) {
+      auto& table = tables[i];
+
+      // size of column values per row
+      size_t num_rows =
+        rt->get_index_space_domain(
+          ctx,
+          table.index_column_space(ctx, rt).column_is)
+        .get_volume();
+      size_t table_size = 0;
+      for (auto& nm_col : table.columns()) {
+#if HAVE_CXX17
+        auto& [nm, col] = nm_col;
+#else // !HAVE_CXX17
+        auto& nm = std::get<0>(nm_col);
+        auto& col = std::get<1>(nm_col);
+#endif // HAVE_CXX17
+        if (nm != "")
+          table_size +=
+            rt->get_index_space_domain(ctx, col.cs.column_is).get_volume()
+            * value_size(col.dt);
+      }
+      const size_t row_size = std::max(table_size / num_rows, (size_t)1);
+      size_t block_size =
+        std::max(budget / (STREAM_BLOCKS_IN_FLIGHT * row_size), (size_t)1);
+      if (chunk_rows > 0)
+        block_size = std::max(block_size / chunk_rows, (size_t)1) * chunk_rows;
+
+      auto row_part =
+        table
+        .partition_rows(ctx, rt, {block_size})
+        .get_result<ColumnSpacePartition>();
+      auto rd_reqs =
+        TableReadTask::requirements(ctx, rt, table, row_part, WRITE_ONLY);
+#if HAVE_CXX17
+      auto& [rd_treqs, rd_tparts, rd_tdesc] = rd_reqs;
+#else // !HAVE_CXX17
+      auto& rd_treqs = std::get<0>(rd_reqs);
+      auto& rd_tparts = std::get<1>(rd_reqs);
+      auto& rd_tdesc = std::get<2>(rd_reqs);
+#endif // HAVE_CXX17
+      auto wr_reqs =
+        table.requirements(
+          ctx,
+          rt,
+          row_part,
+          {},
+          Column::default_requirements_mapped);
+#if HAVE_CXX17
+      auto& [wr_treqs, wr_tparts, wr_tdesc] = wr_reqs;
+#else // !HAVE_CXX17
+      auto& wr_treqs = std::get<0>(wr_reqs);
+      auto& wr_tparts = std::get<1>(wr_reqs);
+      auto& wr_tdesc = std::get<2>(wr_reqs);
+#endif // HAVE_CXX17
+
+      TableReadTask::Args rd_args;
+      std::string tpath = ms;
+      if (table_names[i] != "MAIN")
+        tpath += std::string("/") + table_names[i];
+      fstrcpy(rd_args.table_path, tpath);
+      rd_args.table_desc = rd_tdesc;
+      WriteH5BlockTaskArgs wr_args;
+      fstrcpy(wr_args.h5_path, h5.c_str());
+      fstrcpy(wr_args.table_name, table_names[i]);
+      wr_args.desc = wr_tdesc;
+
+      // zero-valued buffer for fills of column value fields
+      std::vector<char> zeros;
+      for (auto& nm_col : table.columns())
+        if (std::get<0>(nm_col) != "")
+          zeros.resize(
+            std::max(zeros.size(), value_size(std::get<1>(nm_col).dt)));
+
+      std::deque<Future> writes;
+      Future prev_write;
+      for (PointInDomainIterator<1> pid(
+             rt->get_index_partition_color_space(row_part.column_ip));
+           pid();
+           pid++) {
+        // bound the number of blocks in flight
+        if (writes.size() == STREAM_BLOCKS_IN_FLIGHT) {
+          writes.front().get_void_result();
+          writes.pop_front();
+        }
+        const Domain block(Rect<1>(pid[0], pid[0]));
+
+        IndexTaskLauncher read(
+          TableReadTask::TASK_ID,
+          block,
+          TaskArgument(&rd_args, sizeof(rd_args)),
+          ArgumentMap(),
+          Predicate::TRUE_PRED,
+          false,
+          table_mapper);
+        for (auto& rq : rd_treqs)
+          read.add_region_requirement(rq);
+        rt->execute_index_space(ctx, read);
+
+        // writes to the HDF5 file are serialized by their dependence on the
+        // previous write
+        IndexTaskLauncher write(
+          WRITE_H5_BLOCK_TASK_ID,
+          block,
+          TaskArgument(&wr_args, sizeof(wr_args)),
+          ArgumentMap(),
+          Predicate::TRUE_PRED,
+          false,
+          table_mapper);
+        for (auto& rq : wr_treqs)
+          write.add_region_requirement(rq);
+        if (prev_write.exists())
+          write.add_future(prev_write);
+        prev_write = rt->execute_index_space(ctx, write).get_future(*pid);
+        writes.push_back(prev_write);
+
+        // fill the block values with zeros to allow the runtime to reclaim the
+        // instances holding the values that were just written (fills are
+        // applied lazily, and need no instances)
+        for (auto& rq : wr_treqs) {
+          if (rq.handle_type != LEGION_PARTITION_PROJECTION)
+            continue;
+          auto lr = rt->get_logical_subregion_by_color(ctx, rq.partition, *pid);
+          for (auto& fid : rq.privilege_fields)
+            rt->fill_field(
+              ctx,
+              lr,
+              rq.parent,
+              fid,
+              zeros.data(),
+              rt->get_field_size(ctx, lr.get_field_space(), fid));
+        }
+      }
+      for (auto& w : writes)
+        w.get_void_result();
+
+      for (auto& p : rd_tparts)
+        p.destroy(ctx, rt);
+      for (auto& p : wr_tparts)
+        p.destroy(ctx, rt);
+      row_part.destroy(ctx, rt);
+    }
   }
 
   static void
@@ -692,6 +1110,19 @@ main(int argc, char** argv) {
       registrar,
       create_h5_task_name);
   }
+  {
+    // write_h5_block_task
+    TaskVariantRegistrar
+      registrar(WRITE_H5_BLOCK_TASK_ID, write_h5_block_task_name);
+    registrar.add_constraint(ProcessorConstraint(Processor::IO_PROC));
+    registrar.set_leaf();
+    registrar.add_layout_constraint_set(
+      TableMapper::to_mapping_tag(TableMapper::default_column_layout_tag),
+      soa_right_layout);
+    Runtime::preregister_task_variant<write_h5_block_task>(
+      registrar,
+      write_h5_block_task_name);
+  }
   Runtime::set_top_level_task_id(TopLevelTask::TASK_ID);
   return Runtime::start(argc, argv);
 }
@@ -266,7 +266,8 @@ ATermIlluminationFunction::compute_fft(
   Runtime* rt,
   const ColumnSpacePartition& partition,
   unsigned fftw_flags,
-  double fftw_timelimit) const {
+  double fftw_timelimit,
+  FFT::Mode fft_mode) const {
 
   // READ_WRITE privileges on values and weights
   auto rw_colreqs = Column::default_requirements;
@@ -299,6 +300,7 @@ ATermIlluminationFunction::compute_fft(
   args.rotate_out = true;
   args.seconds = fftw_timelimit;
   args.flags = fftw_flags;
+  args.mode = fft_mode;
   for (auto& fid : {CFTableBase::CF_VALUE_FID/*, CFTableBase::CF_WEIGHT_FID*/}) {
     // FFT::in_place needs a simple RegionRequirement: find the requirement for
     // the column, copy it, and ensure the copy includes just the desired field
@@ -367,7 +369,8 @@ ATermIlluminationFunction::compute_jones(
   const ATermZernikeModel& zmodel,
   const ColumnSpacePartition& partition,
   unsigned fftw_flags,
-  double fftw_timelimit) const {
+  double fftw_timelimit,
+  FFT::Mode fft_mode) const {
 
   // add "ept" columns to gc table
   compute_epts(ctx, rt, gc, partition);
@@ -376,7 +379,7 @@ ATermIlluminationFunction::compute_jones(
   compute_aifs(ctx, rt, zmodel, gc, partition);
 
   // FFT on the values region
-  compute_fft(ctx, rt, partition, fftw_flags, fftw_timelimit);
+  compute_fft(ctx, rt, partition, fftw_flags, fftw_timelimit, fft_mode);
 }
 
 #define USE_KOKKOS_VARIANT(V, T)                \
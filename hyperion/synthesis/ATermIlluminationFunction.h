@@ -23,6 +23,7 @@
   CF_BASELINE_CLASS, CF_PARALLACTIC_ANGLE, CF_FREQUENCY, CF_STOKES
 
 #include <hyperion/synthesis/ATermZernikeModel.h>
+#include <hyperion/synthesis/FFT.h>
 #include <hyperion/synthesis/GridCoordinateTable.h>
 
 #include <fftw3.h>
@@ -228,6 +229,7 @@ public:
    * @param fftw_flags FFTW planner flags, ignored by CUDA implementation
    * @param fftw_timelimit FFTW planner time limit (seconds),
    *                       ignored by CUDA implementation
+   * @param fft_mode FFT execution mode, ignored by CUDA implementation
    */
   void
   compute_jones(
@@ -237,7 +239,8 @@ public:
     const ATermZernikeModel& zmodel,
     const ColumnSpacePartition& partition = ColumnSpacePartition(),
     unsigned fftw_flags = FFTW_MEASURE,
-    double fftw_timelimit = 5.0) const;
+    double fftw_timelimit = 5.0,
+    FFT::Mode fft_mode = FFT::Mode::AUTO) const;
 
 protected:
 
@@ -256,7 +259,8 @@ protected:
     Legion::Runtime* rt,
     const ColumnSpacePartition& partition,
     unsigned fftw_flags,
-    double fftw_timelimit) const;
+    double fftw_timelimit,
+    FFT::Mode fft_mode) const;
 
 public:
 
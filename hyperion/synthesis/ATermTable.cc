@@ -467,6 +467,7 @@ ATermTable::preregister_tasks() {
   //
   {
     compute_cfs_task_id = Runtime::generate_static_task_id();
+    Instrumentation::register_task(compute_cfs_task_id, compute_cfs_task_name);
 
 #if defined(KOKKOS_ENABLE_SERIAL) && defined(USE_KOKKOS_SERIAL_CFS_TASK)
     {
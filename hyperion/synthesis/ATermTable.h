@@ -30,6 +30,7 @@
 #include <hyperion/synthesis/ATermIlluminationFunction.h>
 #include <hyperion/synthesis/GridCoordinateTable.h>
 #include <hyperion/synthesis/FFT.h>
+#include <hyperion/Instrumentation.h>
 
 #include <fftw3.h>
 #ifdef HYPERION_USE_CUDA
@@ -104,6 +105,9 @@ public:
     Legion::Context ctx,
     Legion::Runtime* rt) {
 
+    Instrumentation::Scope scope(task);
+    scope.add_region_bytes(rt, task->regions);
+
     const ComputeCFsTaskArgs& args =
       *static_cast<const ComputeCFsTaskArgs*>(task->args);
 
@@ -24,6 +24,16 @@
 namespace hyperion {
 namespace synthesis {
 
+/**
+ * image domain convolution functions, with one (grid_size x grid_size) plane
+ * per index point
+ *
+ * Planes are stored at full size regardless of the CF support, as they are
+ * multiplied together (see ProductCFTable) and transformed to the uv domain by
+ * FFTs over the full plane. Support-sized, packed storage is that of the
+ * uv-domain kernels in a GriddingKernelTable, which are what the gridder
+ * reads.
+ */
 template <cf_table_axes_t ...AXES>
 class CFTable
   : public CFTableBase {
@@ -25,10 +25,6 @@
 
 #include <cstring>
 
-#ifdef HYPERION_USE_OPENMP
-# include <omp.h>
-#endif
-
 using namespace hyperion::synthesis;
 using namespace hyperion;
 using namespace Legion;
@@ -318,6 +314,7 @@ CFTableBase::apply_fft(
   args.rotate_out = rotate_out;
   args.seconds = seconds;
   args.flags = flags;
+  args.mode = FFT::Mode::AUTO;
 
   auto cols = columns();
   auto part =
@@ -500,16 +497,6 @@ CFTableBase::show_values_task(
 void
 CFTableBase::preregister_all() {
 
-#ifdef HYPERION_USE_OPENMP
-  {
-    [[maybe_unused]] auto rc = fftwf_init_threads();
-    assert(rc != 0);
-    std::cout << "omp_get_max_threads() -> " << omp_get_max_threads()
-              << std::endl;
-    fftwf_plan_with_nthreads(omp_get_max_threads());
-  }
-#endif
-
   AxesRegistrar::register_axes<cf_table_axes_t>();
   {
     // init_index_column_task
@@ -14,9 +14,18 @@
  * limitations under the License.
  */
 #include <hyperion/synthesis/FFT.h>
+#include <hyperion/Instrumentation.h>
 #include <hyperion/utility.h>
 #include <mappers/default_mapper.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <limits>
+#include <tuple>
+
+#ifdef HYPERION_USE_OPENMP
+# include <omp.h>
+#endif
 
 using namespace hyperion;
 using namespace hyperion::synthesis;
@@ -31,6 +40,9 @@ const constexpr char* FFT::in_place_task_name;
 const constexpr char* FFT::create_plan_task_name;
 const constexpr char* FFT::execute_fft_task_name;
 const constexpr char* FFT::destroy_plan_task_name;
+const constexpr char* FFT::execute_cached_plan_task_name;
+const constexpr char* FFT::wisdom_env_var;
+const constexpr size_t FFT::multithreaded_min_size;
 const constexpr char* FFT::rotate_arrays_task_name;
 #endif
 
@@ -38,6 +50,7 @@ TaskID FFT::in_place_task_id;
 TaskID FFT::create_plan_task_id;
 TaskID FFT::execute_fft_task_id;
 TaskID FFT::destroy_plan_task_id;
+TaskID FFT::execute_cached_plan_task_id;
 TaskID FFT::rotate_arrays_task_id;
 
 struct Params {
@@ -146,6 +159,506 @@ get_params(
   }
 }
 
+/**
+ * rotation (to lower indexes) of an array axis of length n, as done by fftshift
+ * (forward) or ifftshift (inverse): the two differ only for odd n
+ */
+static long
+rotation_shift(long n, bool inverse) {
+  return inverse ? n / 2 : (n + 1) / 2;
+}
+
+/**
+ * rotate 1d array in place
+ */
+template <typename T>
+static void
+rotate_1d_array(T* array, long n0, bool inverse) {
+
+  std::rotate(array, array + rotation_shift(n0, inverse), array + n0);
+}
+
+/**
+ * rotate 2d array in place
+ */
+template <typename T>
+static void
+rotate_2d_array(T* array, long n0, long n1, bool inverse) {
+
+  // rotate every row, and then rotate the sequence of rows, which is simply a
+  // rotation of the flattened array
+  for (long i = 0; i < n0; ++i)
+    rotate_1d_array(array + i * n1, n1, inverse);
+  std::rotate(
+    array,
+    array + rotation_shift(n0, inverse) * n1,
+    array + n0 * n1);
+}
+
+/**
+ * rotate 3d array in place
+ */
+template <typename T>
+static void
+rotate_3d_array(T* array, long n0, long n1, long n2, bool inverse) {
+
+  for (long i = 0; i < n0; ++i)
+    rotate_2d_array(array + i * n1 * n2, n1, n2, inverse);
+  std::rotate(
+    array,
+    array + rotation_shift(n0, inverse) * n1 * n2,
+    array + n0 * n1 * n2);
+}
+
+template <typename T, int N>
+static void
+rotate_arrays(
+  Context ctx,
+  Runtime* rt,
+  const FFT::Desc& desc,
+  bool inverse,
+  const RegionRequirement& req,
+  const PhysicalRegion& region) {
+
+  // N.B: we're assuming that the array axes of the region are not partitioned
+  const FieldAccessor<
+    LEGION_READ_WRITE,
+    T,
+    N,
+    coord_t,
+    AffineAccessor<T, N, coord_t>,
+    HYPERION_CHECK_BOUNDS> acc(region, *req.privilege_fields.begin());
+
+  assert(0 < desc.rank && desc.rank <= 3);
+  Point<N> array_pt;
+  for (size_t i = 0; i < N; ++i)
+    array_pt[i] = -1;
+  Rect<N> rect(rt->get_index_space_domain(req.region.get_index_space()));
+  std::vector<ptrdiff_t> array_dim;
+  for (size_t i = desc.rank; i > 0; --i)
+    array_dim.push_back(rect.hi[N - i] - rect.lo[N - i] + 1);
+  for (PointInRectIterator<N> pir(rect, false); pir(); pir++) {
+    // each of the iterator values in the outer N - desc.rank dimensions names
+    // a single array to rotate
+    if (!prefixes_match<N>(array_pt, *pir, N - desc.rank)) {
+      // save the indices for the current array
+      for (size_t i = 0; i < N; ++i)
+        array_pt[i] = (*pir)[i];
+      switch (desc.rank) {
+      case 1: {
+        rotate_1d_array(acc.ptr(*pir), array_dim[0], inverse);
+        break;
+      }
+      case 2: {
+        rotate_2d_array(acc.ptr(*pir), array_dim[0], array_dim[1], inverse);
+        break;
+      }
+      case 3: {
+        rotate_3d_array(
+          acc.ptr(*pir),
+          array_dim[0],
+          array_dim[1],
+          array_dim[2],
+          inverse);
+        break;
+      }
+      default:
+        assert(false);
+        break;
+      }
+    }
+  }
+}
+
+/**
+ * rotate array half^n-sections in field of a region, as by fftshift, or by
+ * ifftshift when "inverse" is true
+ */
+static void
+rotate_region(
+  Context ctx,
+  Runtime* rt,
+  const FFT::Desc& desc,
+  bool inverse,
+  const RegionRequirement& req,
+  const PhysicalRegion& region) {
+
+  assert(desc.transform == FFT::Type::C2C);
+  switch (req.region.get_dim()) {
+#define ROTATE_ARRAYS(N)                                \
+  case N:                                               \
+    switch (desc.precision) {                           \
+    case FFT::Precision::SINGLE:                        \
+      ::rotate_arrays<complex<float>, N>(               \
+        ctx, rt, desc, inverse, req, region);           \
+      break;                                            \
+    case FFT::Precision::DOUBLE:                        \
+      ::rotate_arrays<complex<double>, N>(              \
+        ctx, rt, desc, inverse, req, region);           \
+      break;                                            \
+    }                                                   \
+    break;
+  HYPERION_FOREACH_N(ROTATE_ARRAYS);
+#undef ROTATE_ARRAYS
+  default:
+    assert(false);
+    break;
+  }
+}
+
+/**
+ * number of threads for FFTW plans created by the calling task
+ */
+static int
+fft_threads() {
+#ifdef HYPERION_USE_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+/**
+ * key for plan cache
+ */
+struct PlanKey {
+  int sign;
+  unsigned flags;
+  int nthreads;
+  std::vector<int> n;
+  std::vector<int> nembed;
+  int dist;
+  int stride;
+  int howmany;
+
+  bool
+  operator<(const PlanKey& rhs) const {
+    return
+      std::tie(sign, flags, nthreads, n, nembed, dist, stride, howmany)
+      < std::tie(
+        rhs.sign,
+        rhs.flags,
+        rhs.nthreads,
+        rhs.n,
+        rhs.nembed,
+        rhs.dist,
+        rhs.stride,
+        rhs.howmany);
+  }
+};
+
+/**
+ * FFTW interface, by array element precision
+ */
+template <typename T>
+struct fftw_api {};
+
+template <>
+struct fftw_api<float> {
+  typedef fftwf_plan plan_t;
+  typedef fftwf_complex complex_t;
+
+  static Mutex&
+  mutex() {
+    return fftwf_mutex;
+  }
+
+  static std::map<PlanKey, plan_t>&
+  cache() {
+    static std::map<PlanKey, plan_t> result;
+    return result;
+  }
+
+  static bool
+  is_aligned(void* buffer) {
+    return fftwf_alignment_of(static_cast<float*>(buffer)) == 0;
+  }
+
+  static plan_t
+  plan(const PlanKey& key, complex_t* buffer) {
+    return
+      fftwf_plan_many_dft(
+        key.n.size(), key.n.data(), key.howmany,
+        buffer, key.nembed.data(), key.stride, key.dist,
+        buffer, key.nembed.data(), key.stride, key.dist,
+        key.sign,
+        key.flags);
+  }
+
+  static void
+  execute(plan_t plan, void* buffer) {
+    auto b = static_cast<complex_t*>(buffer);
+    fftwf_execute_dft(plan, b, b);
+  }
+
+  static void
+  set_timelimit(double seconds) {
+    fftwf_set_timelimit(seconds);
+  }
+
+  static void
+  plan_with_nthreads(int nthreads) {
+#ifdef HYPERION_USE_OPENMP
+    fftwf_plan_with_nthreads(nthreads);
+#else
+    assert(nthreads == 1);
+#endif
+  }
+
+  static complex_t*
+  alloc(size_t n) {
+    return fftwf_alloc_complex(n);
+  }
+
+  static void
+  free(complex_t* buffer) {
+    fftwf_free(buffer);
+  }
+
+  static void
+  destroy(plan_t plan) {
+    fftwf_destroy_plan(plan);
+  }
+
+  static bool
+  import_wisdom(const char* path) {
+    return fftwf_import_wisdom_from_filename(path) != 0;
+  }
+
+  static bool
+  export_wisdom(const char* path) {
+    return fftwf_export_wisdom_to_filename(path) != 0;
+  }
+};
+
+template <>
+struct fftw_api<double> {
+  typedef fftw_plan plan_t;
+  typedef fftw_complex complex_t;
+
+  static Mutex&
+  mutex() {
+    return fftw_mutex;
+  }
+
+  static std::map<PlanKey, plan_t>&
+  cache() {
+    static std::map<PlanKey, plan_t> result;
+    return result;
+  }
+
+  static bool
+  is_aligned(void* buffer) {
+    return fftw_alignment_of(static_cast<double*>(buffer)) == 0;
+  }
+
+  static plan_t
+  plan(const PlanKey& key, complex_t* buffer) {
+    return
+      fftw_plan_many_dft(
+        key.n.size(), key.n.data(), key.howmany,
+        buffer, key.nembed.data(), key.stride, key.dist,
+        buffer, key.nembed.data(), key.stride, key.dist,
+        key.sign,
+        key.flags);
+  }
+
+  static void
+  execute(plan_t plan, void* buffer) {
+    auto b = static_cast<complex_t*>(buffer);
+    fftw_execute_dft(plan, b, b);
+  }
+
+  static void
+  set_timelimit(double seconds) {
+    fftw_set_timelimit(seconds);
+  }
+
+  static void
+  plan_with_nthreads(int nthreads) {
+#ifdef HYPERION_USE_OPENMP
+    fftw_plan_with_nthreads(nthreads);
+#else
+    assert(nthreads == 1);
+#endif
+  }
+
+  static complex_t*
+  alloc(size_t n) {
+    return fftw_alloc_complex(n);
+  }
+
+  static void
+  free(complex_t* buffer) {
+    fftw_free(buffer);
+  }
+
+  static void
+  destroy(plan_t plan) {
+    fftw_destroy_plan(plan);
+  }
+
+  static bool
+  import_wisdom(const char* path) {
+    return fftw_import_wisdom_from_filename(path) != 0;
+  }
+
+  static bool
+  export_wisdom(const char* path) {
+    return fftw_export_wisdom_to_filename(path) != 0;
+  }
+};
+
+/**
+ * get a plan from the plan cache, creating it if necessary
+ *
+ * Returns NULL if no plan can be created (as when FFTW_WISDOM_ONLY is
+ * requested and FFTW has no wisdom for the plan). The plan is created with a
+ * scratch array, as the FFTW planner may overwrite the array; since cached
+ * plans are executed on arbitrary arrays, plans for arrays that lack SIMD
+ * alignment are created with the FFTW_UNALIGNED flag.
+ */
+template <typename T>
+static typename fftw_api<T>::plan_t
+get_cached_plan(
+  Context ctx,
+  Runtime* rt,
+  const FFT::Args& args,
+  const Params& params,
+  bool aligned,
+  int nthreads) {
+
+  typedef fftw_api<T> api;
+
+  PlanKey key{
+    args.desc.sign,
+    args.flags | (aligned ? 0 : (unsigned)FFTW_UNALIGNED),
+    nthreads,
+    params.n,
+    params.nembed,
+    params.dist,
+    params.stride,
+    params.howmany};
+
+  api::mutex().lock(ctx, rt);
+  auto& cache = api::cache();
+  typename api::plan_t result;
+  auto cached = cache.find(key);
+  if (cached != cache.end()) {
+    result = cached->second;
+  } else {
+    if (args.seconds >= 0)
+      api::set_timelimit(args.seconds);
+    api::plan_with_nthreads(nthreads);
+    // extent of the array elements accessed by the transform
+    size_t array_span = 1;
+    for (auto& e : key.nembed)
+      array_span *= e;
+    size_t span =
+      (key.howmany - 1) * static_cast<size_t>(key.dist)
+      + (array_span - 1) * static_cast<size_t>(std::max(key.stride, 1))
+      + 1;
+    auto buff = api::alloc(span);
+    result = api::plan(key, buff);
+    api::free(buff);
+    if (result != NULL)
+      cache[key] = result;
+  }
+  api::mutex().unlock();
+  return result;
+}
+
+/**
+ * fill array values in the field of a region with NaN
+ */
+template <typename T, int N>
+static void
+fill_nan(
+  Runtime* rt,
+  const RegionRequirement& req,
+  const PhysicalRegion& region,
+  const FieldID& fid) {
+
+  const FieldAccessor<
+    LEGION_READ_WRITE,
+    complex<T>,
+    N,
+    coord_t,
+    AffineAccessor<complex<T>, N, coord_t>,
+    HYPERION_CHECK_BOUNDS> acc(region, fid);
+  const complex<T> nan(
+    std::numeric_limits<T>::quiet_NaN(),
+    std::numeric_limits<T>::quiet_NaN());
+  for (PointInDomainIterator<N> pid(
+         rt->get_index_space_domain(req.region.get_index_space()));
+       pid();
+       pid++)
+    acc[*pid] = nan;
+}
+
+/**
+ * execute FFT on field of a region using a cached plan, with array rotations
+ * before and after the transform as requested by args
+ */
+template <typename T>
+static int
+execute_cached_plan(
+  Context ctx,
+  Runtime* rt,
+  const FFT::Args& args,
+  const RegionRequirement& req,
+  const PhysicalRegion& region) {
+
+  typedef fftw_api<T> api;
+
+  auto params =
+    get_params<complex<T>>(rt, req, region, args.fid, args.desc.rank);
+  size_t array_size = 1;
+  for (auto& n : params.n)
+    array_size *= n;
+  bool multithreaded =
+    params.howmany > 1
+    && (args.mode == FFT::Mode::MULTITHREADED
+        || (args.mode == FFT::Mode::AUTO
+            && array_size >= FFT::multithreaded_min_size));
+  auto buffer = static_cast<complex<T>*>(params.buffer);
+  const int num_arrays = params.howmany;
+  bool aligned = api::is_aligned(buffer);
+  if (multithreaded) {
+    // a plan for a single array, which is executed on every array in turn;
+    // when the first two arrays are aligned, all of them are aligned
+    aligned = aligned && api::is_aligned(buffer + params.dist);
+    params.howmany = 1;
+  }
+  auto plan =
+    get_cached_plan<T>(ctx, rt, args, params, aligned, fft_threads());
+  if (plan != NULL) {
+    if (args.rotate_in)
+      rotate_region(ctx, rt, args.desc, true, req, region);
+    if (multithreaded) {
+      for (int i = 0; i < num_arrays; ++i)
+        api::execute(plan, buffer + i * params.dist);
+    } else {
+      api::execute(plan, buffer);
+    }
+    if (args.rotate_out)
+      rotate_region(ctx, rt, args.desc, false, req, region);
+    return 0;
+  }
+  switch (req.region.get_dim()) {
+#define FILL_NAN(N)                                 \
+  case N:                                           \
+    fill_nan<T, N>(rt, req, region, args.fid);      \
+    break;
+  HYPERION_FOREACH_N(FILL_NAN);
+#undef FILL_NAN
+  default:
+    assert(false);
+    break;
+  }
+  return 1;
+}
+
 /**
  * coordinate the computation of an FFT through sub-tasks that create a plan,
  * execute the plan, and finally destroy the plan
@@ -156,13 +669,25 @@ in_place(
   const std::vector<PhysicalRegion>& regions,
   Context ctx,
   Runtime* rt,
-  bool enable_inlined_planner_subtasks) {
+  bool enable_inlined_planner_subtasks,
+  bool use_plan_cache) {
 
   auto same_req = task->regions[0];
   same_req.tag = Mapping::DefaultMapper::MappingTags::SAME_ADDRESS_SPACE;
 
-  // create the FFT plan
   const FFT::Args& args = *static_cast<const FFT::Args*>(task->args);
+
+  if (use_plan_cache) {
+    // execute_cached_plan_task does the rotations, if any
+    TaskLauncher executor(
+      FFT::execute_cached_plan_task_id,
+      TaskArgument(&args, sizeof(args)));
+    executor.add_region_requirement(same_req);
+    rt->execute_task(ctx, executor);
+    return;
+  }
+
+  // create the FFT plan
   TaskLauncher
     plan_creator(FFT::create_plan_task_id, TaskArgument(&args, sizeof(args)));
   plan_creator.add_region_requirement(same_req);
@@ -171,9 +696,10 @@ in_place(
 
   // if args.rotate_in is true, then rotate the array half-sections
   if (args.rotate_in) {
+    FFT::RotateArgs rotate_args{args.desc, true};
     TaskLauncher rotator(
       FFT::rotate_arrays_task_id,
-      TaskArgument(&args.desc, sizeof(args.desc)));
+      TaskArgument(&rotate_args, sizeof(rotate_args)));
     rotator.add_region_requirement(task->regions[0]);
     rt->execute_task(ctx, rotator);
   }
@@ -199,9 +725,10 @@ in_place(
 
   // if args.rotate_out is true, then rotate the array half-sections
   if (args.rotate_out) {
+    FFT::RotateArgs rotate_args{args.desc, false};
     TaskLauncher rotator(
       FFT::rotate_arrays_task_id,
-      TaskArgument(&args.desc, sizeof(args.desc)));
+      TaskArgument(&rotate_args, sizeof(rotate_args)));
     rotator.add_region_requirement(task->regions[0]);
     rt->execute_task(ctx, rotator);
   }
@@ -214,7 +741,7 @@ FFT::fftw_in_place(
   Context ctx,
   Runtime* rt) {
 
-  in_place(task, regions, ctx, rt, false);
+  in_place(task, regions, ctx, rt, false, true);
 }
 
 #ifdef HYPERION_USE_CUDA
@@ -225,7 +752,7 @@ FFT::cufft_in_place(
   Context ctx,
   Runtime* rt) {
 
-  in_place(task, regions, ctx, rt, false);
+  in_place(task, regions, ctx, rt, false, false);
 }
 #endif
 
@@ -236,6 +763,8 @@ FFT::fftw_create_plan(
   Context ctx,
   Runtime* rt) {
 
+  Instrumentation::Scope scope(task);
+
   const Args& args = *static_cast<const Args*>(task->args);
 
   assert(args.desc.transform == Type::C2C);
@@ -253,6 +782,9 @@ FFT::fftw_create_plan(
     fftwf_mutex.lock(ctx, rt);
     if (args.seconds >= 0)
       fftwf_set_timelimit(args.seconds);
+#ifdef HYPERION_USE_OPENMP
+    fftwf_plan_with_nthreads(fft_threads());
+#endif
     // when creating a plan, if FFTW does not yet have wisdom for that plan, it
     // will overwrite the array; thus when necessary, create a similar plan
     // initially with a different buffer
@@ -296,6 +828,9 @@ FFT::fftw_create_plan(
     fftw_mutex.lock(ctx, rt);
     if (args.seconds >= 0)
       fftw_set_timelimit(args.seconds);
+#ifdef HYPERION_USE_OPENMP
+    fftw_plan_with_nthreads(fft_threads());
+#endif
     // when creating a plan, if FFTW does not yet have wisdom for that plan, it
     // will overwrite the array; thus when necessary, create a similar plan
     // initially with a different buffer
@@ -339,6 +874,8 @@ FFT::cufft_create_plan(
   Context ctx,
   Runtime* rt) {
 
+  Instrumentation::Scope scope(task);
+
   const Args& args = *static_cast<const Args*>(task->args);
 
   assert(args.desc.transform == Type::C2C);
@@ -393,6 +930,9 @@ FFT::fftw_execute(
   Context ctx,
   Runtime* rt) {
 
+  Instrumentation::Scope scope(task);
+  scope.add_region_bytes(rt, task->regions);
+
   auto plan = task->futures[0].get_result<Plan>();
   int result;
   if (plan.desc.precision == Precision::SINGLE) {
@@ -433,6 +973,9 @@ FFT::cufft_execute(
   Context ctx,
   Runtime* rt) {
 
+  Instrumentation::Scope scope(task);
+  scope.add_region_bytes(rt, task->regions);
+
   auto plan = task->futures[0].get_result<Plan>();
   int result;
   if (plan.handle.cufft != 0) {
@@ -496,123 +1039,109 @@ FFT::cufft_destroy_plan(
 }
 #endif
 
-template <typename T>
-void
-rotate_1d_array(T* array, long n0, T* scratch) {
+int
+FFT::fftw_execute_cached_plan(
+  const Task* task,
+  const std::vector<PhysicalRegion>& regions,
+  Context ctx,
+  Runtime* rt) {
 
-  const long shift = n0 / 2 + 1;
+  Instrumentation::Scope scope(task);
+  scope.add_region_bytes(rt, task->regions);
 
-  for (long i = 0; i < n0; ++i)
-    scratch[i] = array[(i + shift) % n0];
-  for (long i = 0; i < n0; ++i)
-    array[i] = scratch[i];
+  const Args& args = *static_cast<const Args*>(task->args);
+
+  assert(args.desc.transform == Type::C2C);
+  if (args.desc.precision == Precision::SINGLE)
+    return
+      execute_cached_plan<float>(ctx, rt, args, task->regions[0], regions[0]);
+  else
+    return
+      execute_cached_plan<double>(ctx, rt, args, task->regions[0], regions[0]);
 }
 
 template <typename T>
+static void
+clear_cache(Context ctx, Runtime* rt) {
+  typedef fftw_api<T> api;
+  api::mutex().lock(ctx, rt);
+  for (auto& key_plan : api::cache())
+    api::destroy(std::get<1>(key_plan));
+  api::cache().clear();
+  api::mutex().unlock();
+}
+
 void
-rotate_2d_array(T* array, long n0, long n1, T* scratch) {
+FFT::clear_plan_cache(Context ctx, Runtime* rt) {
+  clear_cache<float>(ctx, rt);
+  clear_cache<double>(ctx, rt);
+}
 
-  std::array<long, 2> shift{n0 / 2 + 1, n1 / 2 + 1};
+template <typename T>
+static size_t
+cache_size(Context ctx, Runtime* rt) {
+  typedef fftw_api<T> api;
+  api::mutex().lock(ctx, rt);
+  size_t result = api::cache().size();
+  api::mutex().unlock();
+  return result;
+}
 
-  for (long i = 0; i < n0; ++i) {
-    auto i1 = (i + shift[0]) % n0;
-    for (long j = 0; j < n1; ++j)
-      scratch[i * n1 + j] = array[i1 * n1 + (j + shift[1]) % n1];
-  }
-  for (long i = 0; i < n0; ++i)
-    for (long j = 0; j < n1; ++j)
-      array[i * n1 + j] = scratch[i * n1 + j];
+size_t
+FFT::num_cached_plans(Context ctx, Runtime* rt) {
+  return cache_size<float>(ctx, rt) + cache_size<double>(ctx, rt);
 }
 
-template <typename T>
-void
-rotate_3d_array(T* array, long n0, long n1, long n2, T* scratch) {
-
-  std::array<long, 3>
-    shift{n0 / 2 + 1, n1 / 2 + 1, n2 / 2 + 1};
-
-  for (long i = 0; i < n0; ++i) {
-    auto i1 = (i + shift[0]) % n0;
-    for (long j = 0; j < n1; ++j) {
-      auto j1 = (j + shift[1]) % n1;
-      for (long k = 0; k < n2; ++k)
-        scratch[(i * n1 + j) * n2 + k] =
-          array[(i1 * n1 + j1) * n2 + (k + shift[2]) % n2];
-    }
+bool
+FFT::import_wisdom(
+  Context ctx,
+  Runtime* rt,
+  Precision precision,
+  const std::string& path) {
+
+  bool result;
+  if (precision == Precision::SINGLE) {
+    fftwf_mutex.lock(ctx, rt);
+    result = fftw_api<float>::import_wisdom(path.c_str());
+    fftwf_mutex.unlock();
+  } else {
+    fftw_mutex.lock(ctx, rt);
+    result = fftw_api<double>::import_wisdom(path.c_str());
+    fftw_mutex.unlock();
   }
-  for (long i = 0; i < n0; ++i)
-    for (long j = 0; j < n1; ++j)
-      for (long k = 0; k < n2; ++k)
-        array[(i * n1 + j) * n2 + k] = scratch[(i * n1 + j) * n2 + k];
+  return result;
 }
 
-template <typename T, int N>
-static void
-rotate_arrays(
+bool
+FFT::export_wisdom(
   Context ctx,
   Runtime* rt,
-  const FFT::Desc& desc,
-  const RegionRequirement& req,
-  const PhysicalRegion& region) {
-
-  // N.B: we're assuming that the array axes of the region are not partitioned
-  const FieldAccessor<
-    LEGION_READ_WRITE,
-    T,
-    N,
-    coord_t,
-    AffineAccessor<T, N, coord_t>,
-    HYPERION_CHECK_BOUNDS> acc(region, *req.privilege_fields.begin());
+  Precision precision,
+  const std::string& path) {
 
-  assert(0 < desc.rank && desc.rank <= 3);
-  Point<N> array_pt;
-  for (size_t i = 0; i < N; ++i)
-    array_pt[i] = -1;
-  Rect<N> rect(rt->get_index_space_domain(req.region.get_index_space()));
-  std::vector<ptrdiff_t> array_dim;
-  size_t array_size = 1;
-  for (size_t i = desc.rank; i > 0; --i) {
-    array_dim.push_back(rect.hi[N - i] - rect.lo[N - i] + 1);
-    array_size *= static_cast<size_t>(array_dim.back());
+  bool result;
+  if (precision == Precision::SINGLE) {
+    fftwf_mutex.lock(ctx, rt);
+    result = fftw_api<float>::export_wisdom(path.c_str());
+    fftwf_mutex.unlock();
+  } else {
+    fftw_mutex.lock(ctx, rt);
+    result = fftw_api<double>::export_wisdom(path.c_str());
+    fftw_mutex.unlock();
   }
+  return result;
+}
 
-  // TODO: c++20: use make_unique_for_overwrite
-  auto scratch = std::make_unique<T[]>(array_size);
-  for (PointInRectIterator<N> pir(rect, false); pir(); pir++) {
-    // each of the iterator values in the outer N - desc.rank dimensions names
-    // a single array to rotate
-    if (!prefixes_match<N>(array_pt, *pir, N - desc.rank)) {
-      // save the indices for the current array
-      for (size_t i = 0; i < N; ++i)
-        array_pt[i] = pir[i];
-      switch (desc.rank) {
-      case 1: {
-        rotate_1d_array(acc.ptr(*pir), array_dim[0], scratch.get());
-        break;
-      }
-      case 2: {
-        rotate_2d_array(
-          acc.ptr(*pir),
-          array_dim[0],
-          array_dim[1],
-          scratch.get());
-        break;
-      }
-      case 3: {
-        rotate_3d_array(
-          acc.ptr(*pir),
-          array_dim[0],
-          array_dim[1],
-          array_dim[2],
-          scratch.get());
-        break;
-      }
-      default:
-        assert(false);
-        break;
-      }
-    }
-  }
+bool
+FFT::import_wisdom(Context ctx, Runtime* rt, Precision precision) {
+  const char* path = std::getenv(wisdom_env_var);
+  return path != nullptr && import_wisdom(ctx, rt, precision, path);
+}
+
+bool
+FFT::export_wisdom(Context ctx, Runtime* rt, Precision precision) {
+  const char* path = std::getenv(wisdom_env_var);
+  return path != nullptr && export_wisdom(ctx, rt, precision, path);
 }
 
 void
@@ -622,34 +1151,31 @@ FFT::rotate_arrays_task(
   Context ctx,
   Runtime* rt) {
 
-  const Desc& desc = *static_cast<const Desc*>(task->args);
+  Instrumentation::Scope scope(task);
+  scope.add_region_bytes(rt, task->regions);
 
-  assert(desc.transform == FFT::Type::C2C);
-  switch (task->regions[0].region.get_dim()) {
-#define ROTATE_ARRAYS(N)                                \
-  case N:                                               \
-    switch (desc.precision) {                           \
-    case FFT::Precision::SINGLE:                        \
-      ::rotate_arrays<complex<float>, N>(               \
-        ctx, rt, desc, task->regions[0], regions[0]);   \
-      break;                                            \
-    case FFT::Precision::DOUBLE:                        \
-      ::rotate_arrays<complex<double>, N>(              \
-        ctx, rt, desc, task->regions[0], regions[0]);   \
-      break;                                            \
-    }                                                   \
-    break;
-  HYPERION_FOREACH_N(ROTATE_ARRAYS);
-#undef ROTATE_ARRAYS
-  default:
-    assert(false);
-    break;
-  }
+  const RotateArgs& args = *static_cast<const RotateArgs*>(task->args);
+  rotate_region(
+    ctx,
+    rt,
+    args.desc,
+    args.inverse,
+    task->regions[0],
+    regions[0]);
 }
 
 void
 FFT::preregister_tasks() {
 
+#ifdef HYPERION_USE_OPENMP
+  {
+    [[maybe_unused]] auto rcf = fftwf_init_threads();
+    assert(rcf != 0);
+    [[maybe_unused]] auto rc = fftw_init_threads();
+    assert(rc != 0);
+  }
+#endif
+
   LayoutConstraintRegistrar
     fftw_constraints(FieldSpace::NO_SPACE, "FFT::fftw_constraints");
   add_soa_right_ordering_constraint(fftw_constraints);
@@ -704,6 +1230,9 @@ FFT::preregister_tasks() {
   //
   {
     create_plan_task_id = Runtime::generate_static_task_id();
+    Instrumentation::register_task(
+      create_plan_task_id,
+      create_plan_task_name);
     // fftw variant
     //
     // FIXME: remove assumption that FFTW is using OpenMP
@@ -736,6 +1265,9 @@ FFT::preregister_tasks() {
   //
   {
     execute_fft_task_id = Runtime::generate_static_task_id();
+    Instrumentation::register_task(
+      execute_fft_task_id,
+      execute_fft_task_name);
     // fftw variant
     //
     // FIXME: remove assumption that FFTW is using OpenMP
@@ -798,10 +1330,35 @@ FFT::preregister_tasks() {
 #endif
   }
   //
+  // execute_cached_plan_task
+  //
+  {
+    execute_cached_plan_task_id = Runtime::generate_static_task_id();
+    Instrumentation::register_task(
+      execute_cached_plan_task_id,
+      execute_cached_plan_task_name);
+    // fftw variant only
+    //
+    // FIXME: remove assumption that FFTW is using OpenMP
+    {
+      TaskVariantRegistrar
+        registrar(execute_cached_plan_task_id, execute_cached_plan_task_name);
+      registrar.add_constraint(ProcessorConstraint(Processor::OMP_PROC));
+      registrar.set_leaf();
+      registrar.add_layout_constraint_set(0, fftw_layout_id);
+      Runtime::preregister_task_variant<int, fftw_execute_cached_plan>(
+        registrar,
+        execute_cached_plan_task_name);
+    }
+  }
+  //
   // rotate_arrays_task
   //
   {
     rotate_arrays_task_id = Runtime::generate_static_task_id();
+    Instrumentation::register_task(
+      rotate_arrays_task_id,
+      rotate_arrays_task_name);
 
     // have only a CPU variant at this time
     {
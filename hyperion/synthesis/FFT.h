@@ -21,6 +21,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <string>
 
 #include <fftw3.h>
 #ifdef HYPERION_USE_CUDA
@@ -104,6 +105,27 @@ public:
     DOUBLE
   };
 
+  /**
+   * FFT execution mode for cached plans
+   *
+   * In BATCHED mode, all arrays in a region are transformed by a single plan
+   * using the FFTW "howmany" interface, with FFTW threads dividing the arrays
+   * among them. In MULTITHREADED mode, arrays are transformed one at a time,
+   * each by a multithreaded plan. AUTO selects MULTITHREADED for arrays of at
+   * least multithreaded_min_size elements, and BATCHED otherwise.
+   */
+  enum class Mode {
+    AUTO,
+    BATCHED,
+    MULTITHREADED
+  };
+
+  /**
+   * minimum array size (number of elements) for MULTITHREADED mode selection
+   * by Mode::AUTO
+   */
+  static const constexpr size_t multithreaded_min_size = 1 << 20;
+
   /**
    * FFT logical descriptor
    */
@@ -135,12 +157,15 @@ public:
   struct Args {
     Desc desc; /**< FFT descriptor */
     Legion::FieldID fid; /**< field in region */
-    /** true iff array half^n-sections should be rotated before FFT */
+    /** true iff array half^n-sections should be rotated before FFT, as by
+     * ifftshift */
     bool rotate_in;
-    /** true iff array half^n-sections should be rotated after FFT */
+    /** true iff array half^n-sections should be rotated after FFT, as by
+     * fftshift */
     bool rotate_out;
     unsigned flags; /**< FFTW planner flags */
     double seconds; /**< FFTW planner time limit */
+    Mode mode; /**< execution mode (FFTW only) */
   };
 
   /**
@@ -171,6 +196,11 @@ public:
 
   /**
    * task for creating an FFT plan
+   *
+   * The plan creation, execution and destruction tasks are used by
+   * in_place_task for cuFFT transforms. For FFTW transforms, in_place_task uses
+   * execute_cached_plan_task instead, but the FFTW variants of these tasks are
+   * kept as the uncached reference for the plan cache.
    */
   static const constexpr char* create_plan_task_name =
     "FFT::create_plan_task";
@@ -239,7 +269,108 @@ public:
 #endif
 
   /**
-   * task for rotatiing array values
+   * task for executing an FFT using a cached plan
+   *
+   * Plans are cached per process, keyed by the transform geometry, precision,
+   * sign and planner flags. Cached plans are executed on the array in the
+   * task's region using the FFTW new-array execute functions, so that the
+   * planner is invoked only once for any given geometry. Array rotations
+   * requested by the Args value are done in place by this task, before and
+   * after the transform.
+   */
+  static const constexpr char* execute_cached_plan_task_name =
+    "FFT::execute_cached_plan_task";
+  static Legion::TaskID execute_cached_plan_task_id;
+
+  static int
+  fftw_execute_cached_plan(
+    const Legion::Task* task,
+    const std::vector<Legion::PhysicalRegion>& regions,
+    Legion::Context ctx,
+    Legion::Runtime* rt);
+
+  /**
+   * destroy all plans in the plan cache of the calling process
+   */
+  static void
+  clear_plan_cache(Legion::Context ctx, Legion::Runtime* rt);
+
+  /**
+   * number of plans in the plan cache of the calling process
+   */
+  static size_t
+  num_cached_plans(Legion::Context ctx, Legion::Runtime* rt);
+
+  /**
+   * environment variable that names the FFTW wisdom file of import_wisdom() and
+   * export_wisdom() when no file path is given
+   */
+  static const constexpr char* wisdom_env_var = "HYPERION_FFTW_WISDOM";
+
+  /**
+   * import FFTW wisdom for the given precision from a file into the calling
+   * process
+   *
+   * @return true, iff wisdom was successfully imported
+   */
+  static bool
+  import_wisdom(
+    Legion::Context ctx,
+    Legion::Runtime* rt,
+    Precision precision,
+    const std::string& path);
+
+  /**
+   * export FFTW wisdom for the given precision of the calling process to a
+   * file
+   *
+   * @return true, iff wisdom was successfully exported
+   */
+  static bool
+  export_wisdom(
+    Legion::Context ctx,
+    Legion::Runtime* rt,
+    Precision precision,
+    const std::string& path);
+
+  /**
+   * import FFTW wisdom for the given precision from the file named by the
+   * wisdom_env_var environment variable, if it is set
+   *
+   * @return true, iff wisdom was successfully imported
+   */
+  static bool
+  import_wisdom(
+    Legion::Context ctx,
+    Legion::Runtime* rt,
+    Precision precision);
+
+  /**
+   * export FFTW wisdom for the given precision to the file named by the
+   * wisdom_env_var environment variable, if it is set
+   *
+   * @return true, iff wisdom was successfully exported
+   */
+  static bool
+  export_wisdom(
+    Legion::Context ctx,
+    Legion::Runtime* rt,
+    Precision precision);
+
+  /**
+   * rotate_arrays_task arguments
+   */
+  struct RotateArgs {
+    Desc desc; /**< FFT descriptor */
+    /** true for the inverse rotation (as ifftshift), false for the forward
+     * rotation (as fftshift) */
+    bool inverse;
+  };
+
+  /**
+   * task for rotating array values
+   *
+   * The task argument is a RotateArgs value.
    */
   static const constexpr char* rotate_arrays_task_name =
     "FFT::rotate_arrays_task";
@@ -0,0 +1,929 @@
+/*
+ * Copyright 2020 Associated Universities, Inc. Washington DC, USA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HYPERION_SYNTHESIS_GRIDDING_KERNEL_TABLE_H_
+#define HYPERION_SYNTHESIS_GRIDDING_KERNEL_TABLE_H_
+
+#include <hyperion/synthesis/CFTable.h>
+#include <hyperion/PhysicalTableGuard.h>
+#include <hyperion/TableMapper.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace hyperion {
+namespace synthesis {
+
+/**
+ * oversampled uv-domain gridding kernels, with storage sized to the support of
+ * every kernel
+ *
+ * A GriddingKernelTable is created from a CFTable of image domain convolution
+ * functions (typically a ProductCFTable). Every CF is zero-padded by the
+ * oversampling factor, transformed to the uv domain, truncated to its support,
+ * and normalized by the sum of its weights. The table itself is a directory of
+ * kernels, indexed by the same axes as the CFTable, with a SUPPORT column (the
+ * kernel support, in grid cells) and an OFFSET column (the position of the
+ * first kernel value in the packed kernel columns). The packed kernel values
+ * and weights are columns of a second table, returned by kernels().
+ *
+ * Every kernel is stored as a square, row-major box of oversampled values that
+ * covers the kernel support for all sub-cell offsets; see box_size() and
+ * box_index().
+ */
+template <cf_table_axes_t...Axes>
+class HYPERION_EXPORT GriddingKernelTable
+  : public hyperion::Table {
+public:
+
+  static const constexpr unsigned index_rank = sizeof...(Axes);
+
+  // the SUPPORT and OFFSET columns have a degenerate, trailing ORDER0 axis, so
+  // that their ColumnSpace is distinct from that of the index column when the
+  // table has only one index axis
+  static const constexpr unsigned directory_rank = index_rank + 1;
+
+  typedef CFPhysicalTable<Axes...> cf_physical_table_t;
+
+  typedef int support_t;
+  static const constexpr Legion::FieldID SUPPORT_FID = 44;
+  static const constexpr char* SUPPORT_COLUMN_NAME = "SUPPORT";
+
+  // hyperion has no 64-bit integer column type, so offsets are limited to
+  // 32 bits; create() fails when the packed kernels exceed that range
+  typedef unsigned offset_t;
+  static const constexpr Legion::FieldID OFFSET_FID = 54;
+  static const constexpr char* OFFSET_COLUMN_NAME = "OFFSET";
+
+  template <
+    template <typename, int, typename> typename A = Legion::GenericAccessor,
+    typename COORD_T = Legion::coord_t>
+  using SupportColumn =
+    PhysicalColumnTD<
+      ValueType<support_t>::DataType,
+      index_rank,
+      directory_rank,
+      A,
+      COORD_T>;
+
+  template <
+    template <typename, int, typename> typename A = Legion::GenericAccessor,
+    typename COORD_T = Legion::coord_t>
+  using OffsetColumn =
+    PhysicalColumnTD<
+      ValueType<offset_t>::DataType,
+      index_rank,
+      directory_rank,
+      A,
+      COORD_T>;
+
+  template <
+    template <typename, int, typename> typename A = Legion::GenericAccessor,
+    typename COORD_T = Legion::coord_t>
+  using KernelValueColumn =
+    PhysicalColumnTD<
+      ValueType<CFTableBase::cf_value_t>::DataType,
+      1,
+      1,
+      A,
+      COORD_T>;
+
+  template <
+    template <typename, int, typename> typename A = Legion::GenericAccessor,
+    typename COORD_T = Legion::coord_t>
+  using KernelWeightColumn =
+    PhysicalColumnTD<
+      ValueType<CFTableBase::cf_weight_t>::DataType,
+      1,
+      1,
+      A,
+      COORD_T>;
+
+  GriddingKernelTable()
+    : m_max_support(0) {}
+
+protected:
+
+  GriddingKernelTable(
+    hyperion::Table&& directory,
+    hyperion::Table&& kernels,
+    support_t max_support)
+    : hyperion::Table(std::move(directory))
+    , m_kernels(std::move(kernels))
+    , m_max_support(max_support) {}
+
+public:
+
+  /**
+   * table of packed kernel values and weights
+   *
+   * The table has a single index axis, CF_ORDER0, and CFTableBase::VALUE and
+   * CFTableBase::WEIGHT columns.
+   */
+  const hyperion::Table&
+  kernels() const {
+    return m_kernels;
+  }
+
+  /**
+   * maximum support of all kernels in the table (in grid cells)
+   *
+   * This is the actual bound on the extent of the grid footprint of any
+   * kernel, and is normally much smaller than the size of the CFs from which
+   * the kernels were created.
+   */
+  support_t
+  max_support() const {
+    return m_max_support;
+  }
+
+  void
+  destroy(Legion::Context ctx, Legion::Runtime* rt) {
+    m_kernels.destroy(ctx, rt);
+    hyperion::Table::destroy(ctx, rt);
+  }
+
+  /**
+   * margin of a kernel box, in oversampled samples, that accommodates all
+   * sub-cell offsets
+   */
+  static Legion::coord_t
+  box_margin(Legion::coord_t oversampling) {
+    return (oversampling + 1) / 2;
+  }
+
+  /**
+   * half-width of the box of a kernel, in oversampled samples
+   */
+  static Legion::coord_t
+  box_half_width(support_t support, Legion::coord_t oversampling) {
+    return (support / 2) * oversampling + box_margin(oversampling);
+  }
+
+  /**
+   * width of the box of a kernel, in oversampled samples
+   */
+  static Legion::coord_t
+  box_size(support_t support, Legion::coord_t oversampling) {
+    return 2 * box_half_width(support, oversampling) + 1;
+  }
+
+  /**
+   * index along one box axis of the kernel value for the grid cell offset "d"
+   * (in [-support/2, support/2]) and sub-cell offset "o" (in oversampled
+   * samples)
+   */
+  static Legion::coord_t
+  box_index(
+    support_t support,
+    Legion::coord_t oversampling,
+    Legion::coord_t d,
+    Legion::coord_t o) {
+    return d * oversampling - o + box_half_width(support, oversampling);
+  }
+
+  /**
+   * create a GriddingKernelTable from a CFTable
+   *
+   * @param cfs image domain convolution functions
+   * @param oversampling uv domain oversampling factor
+   * @param threshold kernel support is the region in which kernel values have
+   * magnitude not less than "threshold" times the peak magnitude
+   * @param flags FFTW planner flags
+   * @param seconds FFTW planner time limit
+   */
+  static GriddingKernelTable
+  create(
+    Legion::Context ctx,
+    Legion::Runtime* rt,
+    const CFTable<Axes...>& cfs,
+    size_t oversampling,
+    float threshold,
+    unsigned flags,
+    double seconds) {
+
+    assert(oversampling > 0);
+    PhysicalTableGuard<cf_physical_table_t> pt(
+      ctx,
+      rt,
+      cf_physical_table_t(
+        cfs.map_inline(
+          ctx,
+          rt,
+          {{CFTableBase::CF_VALUE_COLUMN_NAME, Column::default_requirements},
+           {CFTableBase::CF_WEIGHT_COLUMN_NAME,
+            CXX_OPTIONAL_NAMESPACE::nullopt}},
+          Column::default_requirements_mapped)));
+    return
+      create_from_axes(
+        ctx,
+        rt,
+        cfs,
+        pt->grid_size(),
+        oversampling,
+        threshold,
+        flags,
+        seconds,
+        index_axis<Axes>(*pt)...);
+  }
+
+  static Legion::TaskID pad_task_id;
+  static const constexpr char* pad_task_name =
+    "GriddingKernelTable::pad_task";
+
+  static Legion::TaskID measure_support_task_id;
+  static const constexpr char* measure_support_task_name =
+    "GriddingKernelTable::measure_support_task";
+
+  static Legion::TaskID pack_task_id;
+  static const constexpr char* pack_task_name =
+    "GriddingKernelTable::pack_task";
+
+  struct PadTaskArgs {
+    Table::Desc cfs;
+    Table::Desc padded;
+  };
+
+  struct MeasureSupportTaskArgs {
+    Table::Desc padded;
+    Table::Desc directory;
+    Legion::coord_t oversampling;
+    float threshold;
+  };
+
+  struct PackTaskArgs {
+    Table::Desc padded;
+    Table::Desc directory;
+    Table::Desc kernels;
+    Legion::coord_t oversampling;
+  };
+
+  /**
+   * copy CF values and weights into the center of a zero-filled, larger CF
+   * array
+   *
+   * NaN values and weights, which mark points outside of the CF domain, are
+   * replaced by zero
+   */
+  static void
+  pad_task(
+    const Legion::Task* task,
+    const std::vector<Legion::PhysicalRegion>& regions,
+    Legion::Context ctx,
+    Legion::Runtime* rt) {
+
+    typedef CFTable<Axes...> cf_table_t;
+    const PadTaskArgs& args = *static_cast<const PadTaskArgs*>(task->args);
+    std::vector<Table::Desc> tdesc{args.cfs, args.padded};
+    auto pts =
+      PhysicalTable::create_all_unsafe(rt, tdesc, task->regions, regions);
+
+    cf_physical_table_t cfs(pts[0]);
+    cf_physical_table_t padded(pts[1]);
+    auto cfs_value_col = cfs.template value<Legion::AffineAccessor>();
+    auto cfs_rect = cfs_value_col.rect();
+    auto cfs_value = cfs_value_col.template accessor<LEGION_READ_ONLY>();
+    auto cfs_weight =
+      cfs.template weight<Legion::AffineAccessor>()
+      .template accessor<LEGION_READ_ONLY>();
+    auto padded_value_col = padded.template value<Legion::AffineAccessor>();
+    auto padded_rect = padded_value_col.rect();
+    auto padded_value = padded_value_col.template accessor<LEGION_WRITE_ONLY>();
+    auto padded_weight =
+      padded.template weight<Legion::AffineAccessor>()
+      .template accessor<LEGION_WRITE_ONLY>();
+
+    auto is_nan =
+      [](const auto& v) {
+        return std::isnan(v.real()) || std::isnan(v.imag());
+      };
+    const Legion::coord_t shift =
+      static_cast<Legion::coord_t>(padded.grid_size() / 2)
+      - static_cast<Legion::coord_t>(cfs.grid_size() / 2);
+    for (Legion::PointInRectIterator<cf_table_t::cf_rank> pir(
+           padded_rect,
+           false);
+         pir();
+         pir++) {
+      auto pt = *pir;
+      pt[cf_table_t::d_x] -= shift;
+      pt[cf_table_t::d_y] -= shift;
+      CFTableBase::cf_value_t v(0);
+      CFTableBase::cf_weight_t w(0);
+      if (cfs_rect.contains(pt)) {
+        v = cfs_value[pt];
+        if (is_nan(v))
+          v = CFTableBase::cf_value_t(0);
+        w = cfs_weight[pt];
+        if (is_nan(w))
+          w = CFTableBase::cf_weight_t(0);
+      }
+      padded_value[*pir] = v;
+      padded_weight[*pir] = w;
+    }
+  }
+
+  /**
+   * measure the support of every kernel
+   *
+   * The support is the smallest odd number of grid cells that covers all
+   * kernel values with magnitude not less than the threshold fraction of the
+   * peak magnitude, bounded by the size of the CF before oversampling.
+   */
+  static void
+  measure_support_task(
+    const Legion::Task* task,
+    const std::vector<Legion::PhysicalRegion>& regions,
+    Legion::Context ctx,
+    Legion::Runtime* rt) {
+
+    typedef CFTable<Axes...> cf_table_t;
+    const MeasureSupportTaskArgs& args =
+      *static_cast<const MeasureSupportTaskArgs*>(task->args);
+    std::vector<Table::Desc> tdesc{args.padded, args.directory};
+    auto pts =
+      PhysicalTable::create_all_unsafe(rt, tdesc, task->regions, regions);
+
+    cf_physical_table_t padded(pts[0]);
+    auto padded_value =
+      padded.template value<Legion::AffineAccessor>()
+      .template accessor<LEGION_READ_ONLY>();
+    SupportColumn<Legion::AffineAccessor>
+      support_col(*pts[1].column(SUPPORT_COLUMN_NAME).value());
+    auto support = support_col.template accessor<LEGION_WRITE_ONLY>();
+
+    const Legion::coord_t grid_size = padded.grid_size();
+    const Legion::coord_t center = grid_size / 2;
+    const Legion::coord_t max_half_support =
+      (grid_size / args.oversampling) / 2;
+    for (Legion::PointInRectIterator<directory_rank> pir(
+           support_col.rect(),
+           false);
+         pir();
+         pir++) {
+      Legion::Point<cf_table_t::cf_rank> pt;
+      for (size_t i = 0; i < index_rank; ++i)
+        pt[i] = (*pir)[i];
+      CFTableBase::cf_fp_t peak = 0;
+      for (pt[cf_table_t::d_x] = 0;
+           pt[cf_table_t::d_x] < grid_size;
+           ++pt[cf_table_t::d_x])
+        for (pt[cf_table_t::d_y] = 0;
+             pt[cf_table_t::d_y] < grid_size;
+             ++pt[cf_table_t::d_y]) {
+          auto v = padded_value[pt];
+          peak = std::max(peak, std::hypot(v.real(), v.imag()));
+        }
+      Legion::coord_t radius = 0;
+      if (peak > 0) {
+        const CFTableBase::cf_fp_t cutoff = args.threshold * peak;
+        for (pt[cf_table_t::d_x] = 0;
+             pt[cf_table_t::d_x] < grid_size;
+             ++pt[cf_table_t::d_x])
+          for (pt[cf_table_t::d_y] = 0;
+               pt[cf_table_t::d_y] < grid_size;
+               ++pt[cf_table_t::d_y]) {
+            auto v = padded_value[pt];
+            if (std::hypot(v.real(), v.imag()) >= cutoff)
+              radius =
+                std::max(
+                  radius,
+                  std::max(
+                    std::abs(pt[cf_table_t::d_x] - center),
+                    std::abs(pt[cf_table_t::d_y] - center)));
+          }
+      }
+      const Legion::coord_t half_support =
+        std::min(
+          (radius + args.oversampling - 1) / args.oversampling,
+          max_half_support);
+      support[*pir] = static_cast<support_t>(2 * half_support + 1);
+    }
+  }
+
+  /**
+   * normalize every kernel and copy it into its box in the packed kernel
+   * columns
+   *
+   * Kernel values and weights are divided by the magnitude of the sum of the
+   * kernel weights at the grid cell centers (zero sub-cell offset) within the
+   * kernel support.
+   */
+  static void
+  pack_task(
+    const Legion::Task* task,
+    const std::vector<Legion::PhysicalRegion>& regions,
+    Legion::Context ctx,
+    Legion::Runtime* rt) {
+
+    typedef CFTable<Axes...> cf_table_t;
+    const PackTaskArgs& args = *static_cast<const PackTaskArgs*>(task->args);
+    std::vector<Table::Desc> tdesc{args.padded, args.directory, args.kernels};
+    auto pts =
+      PhysicalTable::create_all_unsafe(rt, tdesc, task->regions, regions);
+
+    cf_physical_table_t padded(pts[0]);
+    auto padded_value_col = padded.template value<Legion::AffineAccessor>();
+    auto padded_rect = padded_value_col.rect();
+    auto padded_value = padded_value_col.template accessor<LEGION_READ_ONLY>();
+    auto padded_weight =
+      padded.template weight<Legion::AffineAccessor>()
+      .template accessor<LEGION_READ_ONLY>();
+    SupportColumn<Legion::AffineAccessor>
+      support_col(*pts[1].column(SUPPORT_COLUMN_NAME).value());
+    auto support = support_col.template accessor<LEGION_READ_ONLY>();
+    auto offset =
+      OffsetColumn<Legion::AffineAccessor>(
+        *pts[1].column(OFFSET_COLUMN_NAME).value())
+      .template accessor<LEGION_READ_ONLY>();
+    auto kernel_value =
+      KernelValueColumn<Legion::AffineAccessor>(
+        *pts[2].column(CFTableBase::CF_VALUE_COLUMN_NAME).value())
+      .template accessor<LEGION_WRITE_ONLY>();
+    auto kernel_weight =
+      KernelWeightColumn<Legion::AffineAccessor>(
+        *pts[2].column(CFTableBase::CF_WEIGHT_COLUMN_NAME).value())
+      .template accessor<LEGION_WRITE_ONLY>();
+
+    const Legion::coord_t oversampling = args.oversampling;
+    const Legion::coord_t center = padded.grid_size() / 2;
+    for (Legion::PointInRectIterator<directory_rank> pir(
+           support_col.rect(),
+           false);
+         pir();
+         pir++) {
+      Legion::Point<cf_table_t::cf_rank> pt;
+      for (size_t i = 0; i < index_rank; ++i)
+        pt[i] = (*pir)[i];
+      const support_t sup = support[*pir];
+      const Legion::coord_t half_support = sup / 2;
+
+      // normalization
+      CFTableBase::cf_weight_t weight_sum(0);
+      for (Legion::coord_t du = -half_support; du <= half_support; ++du) {
+        pt[cf_table_t::d_x] = center + du * oversampling;
+        for (Legion::coord_t dv = -half_support; dv <= half_support; ++dv) {
+          pt[cf_table_t::d_y] = center + dv * oversampling;
+          if (padded_rect.contains(pt))
+            weight_sum += padded_weight[pt];
+        }
+      }
+      const CFTableBase::cf_fp_t norm =
+        std::hypot(weight_sum.real(), weight_sum.imag());
+      const CFTableBase::cf_fp_t scale =
+        ((norm > 0) ? (CFTableBase::cf_fp_t)1.0 / norm : 1);
+
+      // kernel box
+      const Legion::coord_t hw = box_half_width(sup, oversampling);
+      const Legion::coord_t sz = box_size(sup, oversampling);
+      Legion::coord_t k = offset[*pir];
+      for (Legion::coord_t i = 0; i < sz; ++i) {
+        pt[cf_table_t::d_x] = center - hw + i;
+        for (Legion::coord_t j = 0; j < sz; ++j) {
+          pt[cf_table_t::d_y] = center - hw + j;
+          if (padded_rect.contains(pt)) {
+            kernel_value[k] = padded_value[pt] * scale;
+            kernel_weight[k] = padded_weight[pt] * scale;
+          } else {
+            kernel_value[k] = CFTableBase::cf_value_t(0);
+            kernel_weight[k] = CFTableBase::cf_weight_t(0);
+          }
+          ++k;
+        }
+      }
+    }
+  }
+
+  static void
+  preregister_tasks() {
+    {
+      pad_task_id = Legion::Runtime::generate_static_task_id();
+      Legion::TaskVariantRegistrar registrar(pad_task_id, pad_task_name);
+      registrar.add_constraint(
+        Legion::ProcessorConstraint(Legion::Processor::LOC_PROC));
+      registrar.set_leaf();
+      registrar.set_idempotent();
+      Legion::Runtime::preregister_task_variant<pad_task>(
+        registrar,
+        pad_task_name);
+    }
+    {
+      measure_support_task_id = Legion::Runtime::generate_static_task_id();
+      Legion::TaskVariantRegistrar registrar(
+        measure_support_task_id,
+        measure_support_task_name);
+      registrar.add_constraint(
+        Legion::ProcessorConstraint(Legion::Processor::LOC_PROC));
+      registrar.set_leaf();
+      registrar.set_idempotent();
+      Legion::Runtime::preregister_task_variant<measure_support_task>(
+        registrar,
+        measure_support_task_name);
+    }
+    {
+      pack_task_id = Legion::Runtime::generate_static_task_id();
+      Legion::TaskVariantRegistrar registrar(pack_task_id, pack_task_name);
+      registrar.add_constraint(
+        Legion::ProcessorConstraint(Legion::Processor::LOC_PROC));
+      registrar.set_leaf();
+      registrar.set_idempotent();
+      Legion::Runtime::preregister_task_variant<pack_task>(
+        registrar,
+        pack_task_name);
+    }
+  }
+
+protected:
+
+  static void
+  launch(
+    Legion::Context ctx,
+    Legion::Runtime* rt,
+    Legion::TaskID task_id,
+    const void* args,
+    size_t args_size,
+    const std::vector<Legion::RegionRequirement>& reqs) {
+
+    Legion::TaskLauncher task(
+      task_id,
+      Legion::TaskArgument(args, args_size),
+      Legion::Predicate::TRUE_PRED,
+      table_mapper);
+    for (auto& r : reqs)
+      task.add_region_requirement(r);
+    rt->execute_task(ctx, task);
+  }
+
+  static std::tuple<std::vector<Legion::RegionRequirement>, Table::Desc>
+  table_requirements(
+    Legion::Context ctx,
+    Legion::Runtime* rt,
+    const hyperion::Table& table,
+    const std::map<
+      std::string,
+      CXX_OPTIONAL_NAMESPACE::optional<Column::Requirements>>& colreqs) {
+
+    auto reqs =
+      table.requirements(
+        ctx,
+        rt,
+        ColumnSpacePartition(),
+        colreqs,
+        CXX_OPTIONAL_NAMESPACE::nullopt);
+    return std::make_tuple(std::get<0>(reqs), std::get<2>(reqs));
+  }
+
+  static hyperion::Table
+  create_directory(
+    Legion::Context ctx,
+    Legion::Runtime* rt,
+    const CFTableBase::Axis<Axes>&...axes) {
+
+    // table index ColumnSpace
+    ColumnSpace index_cs;
+    {
+      Legion::coord_t c_lo[]{axes.bounds().lo[0]...};
+      Legion::Point<index_rank> lo(c_lo);
+      Legion::coord_t c_hi[]{axes.bounds().hi[0]...};
+      Legion::Point<index_rank> hi(c_hi);
+      Legion::IndexSpace is =
+        rt->create_index_space(ctx, Legion::Rect<index_rank>(lo, hi));
+      index_cs =
+        ColumnSpace::create<cf_table_axes_t>(ctx, rt, {Axes...}, is, false);
+    }
+
+    // index columns
+    Table::fields_t fields;
+    fields.reserve(index_rank + 1);
+    {
+      std::vector<ColumnSpace>
+        index_axes_cs{
+        ColumnSpace::create<cf_table_axes_t>(
+          ctx,
+          rt,
+          {Axes},
+          rt->create_index_space(ctx, axes.bounds()),
+          true)...};
+      std::vector<std::pair<std::string, TableField>>
+        index_axes_fields{
+        {cf_table_axis<Axes>::name,
+         TableField(
+           ValueType<typename cf_table_axis<Axes>::type>::DataType,
+           CFTableBase::INDEX_VALUE_FID)}...};
+      for (size_t i = 0; i < index_rank; ++i)
+        fields.emplace_back(
+          index_axes_cs[i],
+          std::vector<std::pair<std::string, TableField>>{index_axes_fields[i]});
+    }
+
+    // SUPPORT and OFFSET columns
+    {
+      Legion::coord_t c_hi[]{axes.bounds().hi[0]..., 0};
+      Legion::Point<directory_rank> hi(c_hi);
+      Legion::IndexSpace is =
+        rt->create_index_space(
+          ctx,
+          Legion::Rect<directory_rank>(
+            Legion::Point<directory_rank>::ZEROES(),
+            hi));
+      fields.emplace_back(
+        ColumnSpace::create<cf_table_axes_t>(
+          ctx,
+          rt,
+          {Axes..., CF_ORDER0},
+          is,
+          false),
+        std::vector<std::pair<std::string, TableField>>{
+          {SUPPORT_COLUMN_NAME,
+           TableField(ValueType<support_t>::DataType, SUPPORT_FID)},
+          {OFFSET_COLUMN_NAME,
+           TableField(ValueType<offset_t>::DataType, OFFSET_FID)}});
+    }
+
+    auto result =
+      hyperion::Table::create(ctx, rt, std::move(index_cs), std::move(fields));
+
+    // initialize index columns
+    {
+      auto colreqs = Column::default_requirements;
+      colreqs.values = Column::Req{
+        WRITE_ONLY /* privilege */,
+        EXCLUSIVE /* coherence */,
+        true /* mapped */
+      };
+      auto reqs =
+        result.requirements(
+          ctx,
+          rt,
+          ColumnSpacePartition(),
+          {{SUPPORT_COLUMN_NAME, CXX_OPTIONAL_NAMESPACE::nullopt},
+           {OFFSET_COLUMN_NAME, CXX_OPTIONAL_NAMESPACE::nullopt}},
+          colreqs);
+      CFTableBase::InitIndexColumnTaskArgs args;
+      args.desc = std::get<2>(reqs);
+      CFTableBase::InitIndexColumnTaskArgs::initializer<Axes...>::init(
+        args,
+        axes...);
+      std::unique_ptr<char[]> buf =
+        std::make_unique<char[]>(args.serialized_size());
+      args.serialize(buf.get());
+      Legion::TaskLauncher task(
+        CFTableBase::init_index_column_task_id,
+        Legion::TaskArgument(buf.get(), args.serialized_size()));
+      for (auto& r : std::get<0>(reqs))
+        task.add_region_requirement(r);
+      rt->execute_task(ctx, task);
+    }
+    return result;
+  }
+
+  static hyperion::Table
+  create_kernels(Legion::Context ctx, Legion::Runtime* rt, size_t size) {
+
+    assert(size > 0);
+    Legion::IndexSpace is =
+      rt->create_index_space(
+        ctx,
+        Legion::Rect<1>(0, static_cast<Legion::coord_t>(size) - 1));
+    ColumnSpace index_cs =
+      ColumnSpace::create<cf_table_axes_t>(ctx, rt, {CF_ORDER0}, is, false);
+    Table::fields_t fields;
+    fields.emplace_back(
+      ColumnSpace::create<cf_table_axes_t>(ctx, rt, {CF_ORDER0}, is, false),
+      std::vector<std::pair<std::string, TableField>>{
+        {CFTableBase::CF_VALUE_COLUMN_NAME,
+         TableField(
+           ValueType<CFTableBase::cf_value_t>::DataType,
+           CFTableBase::CF_VALUE_FID)},
+        {CFTableBase::CF_WEIGHT_COLUMN_NAME,
+         TableField(
+           ValueType<CFTableBase::cf_weight_t>::DataType,
+           CFTableBase::CF_WEIGHT_FID)}});
+    return
+      hyperion::Table::create(ctx, rt, std::move(index_cs), std::move(fields));
+  }
+
+  static GriddingKernelTable
+  create_from_axes(
+    Legion::Context ctx,
+    Legion::Runtime* rt,
+    const CFTable<Axes...>& cfs,
+    size_t grid_size,
+    size_t oversampling,
+    float threshold,
+    unsigned flags,
+    double seconds,
+    const CFTableBase::Axis<Axes>&...axes) {
+
+    auto ro_colreqs = Column::default_requirements;
+    auto wo_colreqs = Column::default_requirements;
+    wo_colreqs.values.privilege = LEGION_WRITE_ONLY;
+
+    // zero-padded CFs
+    CFTable<Axes...> padded(ctx, rt, grid_size * oversampling, axes...);
+    {
+      PadTaskArgs args;
+      std::vector<Legion::RegionRequirement> reqs;
+      auto cfs_rqs =
+        table_requirements(
+          ctx,
+          rt,
+          cfs,
+          {{CFTableBase::CF_VALUE_COLUMN_NAME, ro_colreqs},
+           {CFTableBase::CF_WEIGHT_COLUMN_NAME, ro_colreqs}});
+      args.cfs = std::get<1>(cfs_rqs);
+      std::copy(
+        std::get<0>(cfs_rqs).begin(),
+        std::get<0>(cfs_rqs).end(),
+        std::back_inserter(reqs));
+      auto padded_rqs =
+        table_requirements(
+          ctx,
+          rt,
+          padded,
+          {{CFTableBase::CF_VALUE_COLUMN_NAME, wo_colreqs},
+           {CFTableBase::CF_WEIGHT_COLUMN_NAME, wo_colreqs}});
+      args.padded = std::get<1>(padded_rqs);
+      std::copy(
+        std::get<0>(padded_rqs).begin(),
+        std::get<0>(padded_rqs).end(),
+        std::back_inserter(reqs));
+      launch(ctx, rt, pad_task_id, &args, sizeof(args), reqs);
+    }
+
+    // FFT to uv domain
+    padded.apply_fft(ctx, rt, 1, true, true, flags, seconds);
+
+    // kernel supports
+    auto directory = create_directory(ctx, rt, axes...);
+    {
+      MeasureSupportTaskArgs args;
+      args.oversampling = oversampling;
+      args.threshold = threshold;
+      std::vector<Legion::RegionRequirement> reqs;
+      auto padded_rqs =
+        table_requirements(
+          ctx,
+          rt,
+          padded,
+          {{CFTableBase::CF_VALUE_COLUMN_NAME, ro_colreqs}});
+      args.padded = std::get<1>(padded_rqs);
+      std::copy(
+        std::get<0>(padded_rqs).begin(),
+        std::get<0>(padded_rqs).end(),
+        std::back_inserter(reqs));
+      auto directory_rqs =
+        table_requirements(
+          ctx,
+          rt,
+          directory,
+          {{SUPPORT_COLUMN_NAME, wo_colreqs}});
+      args.directory = std::get<1>(directory_rqs);
+      std::copy(
+        std::get<0>(directory_rqs).begin(),
+        std::get<0>(directory_rqs).end(),
+        std::back_inserter(reqs));
+      launch(ctx, rt, measure_support_task_id, &args, sizeof(args), reqs);
+    }
+
+    // kernel offsets in packed columns, in row-major order of the kernel
+    // indexes
+    size_t kernels_size = 0;
+    support_t max_support = 0;
+    {
+      auto offset_colreqs = Column::default_requirements_mapped;
+      offset_colreqs.values.privilege = LEGION_WRITE_ONLY;
+      PhysicalTableGuard<PhysicalTable> pt(
+        ctx,
+        rt,
+        directory.map_inline(
+          ctx,
+          rt,
+          {{SUPPORT_COLUMN_NAME, Column::default_requirements_mapped},
+           {OFFSET_COLUMN_NAME, offset_colreqs}},
+          CXX_OPTIONAL_NAMESPACE::nullopt));
+      SupportColumn<Legion::AffineAccessor>
+        support_col(*pt->column(SUPPORT_COLUMN_NAME).value());
+      auto support = support_col.template accessor<LEGION_READ_ONLY>();
+      auto offset =
+        OffsetColumn<Legion::AffineAccessor>(
+          *pt->column(OFFSET_COLUMN_NAME).value())
+        .template accessor<LEGION_WRITE_ONLY>();
+      for (Legion::PointInRectIterator<directory_rank> pir(
+             support_col.rect(),
+             false);
+           pir();
+           pir++) {
+        if (kernels_size > std::numeric_limits<offset_t>::max())
+          throw std::length_error(
+            "Packed gridding kernels exceed the range of the OFFSET column");
+        offset[*pir] = static_cast<offset_t>(kernels_size);
+        const support_t sup = support[*pir];
+        const size_t sz = box_size(sup, oversampling);
+        kernels_size += sz * sz;
+        max_support = std::max(max_support, sup);
+      }
+    }
+
+    // normalized, packed kernels
+    auto kernels = create_kernels(ctx, rt, kernels_size);
+    {
+      PackTaskArgs args;
+      args.oversampling = oversampling;
+      std::vector<Legion::RegionRequirement> reqs;
+      auto padded_rqs =
+        table_requirements(
+          ctx,
+          rt,
+          padded,
+          {{CFTableBase::CF_VALUE_COLUMN_NAME, ro_colreqs},
+           {CFTableBase::CF_WEIGHT_COLUMN_NAME, ro_colreqs}});
+      args.padded = std::get<1>(padded_rqs);
+      std::copy(
+        std::get<0>(padded_rqs).begin(),
+        std::get<0>(padded_rqs).end(),
+        std::back_inserter(reqs));
+      auto directory_rqs =
+        table_requirements(
+          ctx,
+          rt,
+          directory,
+          {{SUPPORT_COLUMN_NAME, ro_colreqs},
+           {OFFSET_COLUMN_NAME, ro_colreqs}});
+      args.directory = std::get<1>(directory_rqs);
+      std::copy(
+        std::get<0>(directory_rqs).begin(),
+        std::get<0>(directory_rqs).end(),
+        std::back_inserter(reqs));
+      auto kernels_rqs =
+        table_requirements(
+          ctx,
+          rt,
+          kernels,
+          {{CFTableBase::CF_VALUE_COLUMN_NAME, wo_colreqs},
+           {CFTableBase::CF_WEIGHT_COLUMN_NAME, wo_colreqs}});
+      args.kernels = std::get<1>(kernels_rqs);
+      std::copy(
+        std::get<0>(kernels_rqs).begin(),
+        std::get<0>(kernels_rqs).end(),
+        std::back_inserter(reqs));
+      launch(ctx, rt, pack_task_id, &args, sizeof(args), reqs);
+    }
+    padded.destroy(ctx, rt);
+
+    return
+      GriddingKernelTable(
+        std::move(directory),
+        std::move(kernels),
+        max_support);
+  }
+
+  hyperion::Table m_kernels;
+
+  support_t m_max_support;
+};
+
+template <cf_table_axes_t...Axes>
+Legion::TaskID GriddingKernelTable<Axes...>::pad_task_id;
+template <cf_table_axes_t...Axes>
+Legion::TaskID GriddingKernelTable<Axes...>::measure_support_task_id;
+template <cf_table_axes_t...Axes>
+Legion::TaskID GriddingKernelTable<Axes...>::pack_task_id;
+template <cf_table_axes_t...Axes>
+const constexpr char* GriddingKernelTable<Axes...>::pad_task_name;
+template <cf_table_axes_t...Axes>
+const constexpr char* GriddingKernelTable<Axes...>::measure_support_task_name;
+template <cf_table_axes_t...Axes>
+const constexpr char* GriddingKernelTable<Axes...>::pack_task_name;
+template <cf_table_axes_t...Axes>
+const constexpr char* GriddingKernelTable<Axes...>::SUPPORT_COLUMN_NAME;
+template <cf_table_axes_t...Axes>
+const constexpr char* GriddingKernelTable<Axes...>::OFFSET_COLUMN_NAME;
+
+}  // synthesis
+
+}  // hyperion
+
+#endif /* HYPERION_SYNTHESIS_GRIDDING_KERNEL_TABLE_H_ */
+// Local Variables:
+// mode: c++
+// c-basic-offset: 2
+// fill-column: 80
+// indent-tabs-mode: nil
+// End:
@@ -18,6 +18,7 @@
 
 #include <hyperion/synthesis/CFTable.h>
 #include <hyperion/synthesis/GridCoordinateTable.h>
+#include <hyperion/Instrumentation.h>
 
 #include <array>
 #include <cmath>
@@ -124,6 +125,9 @@ public:
     Legion::Context ctx,
     Legion::Runtime *rt) {
 
+    Instrumentation::Scope scope(task);
+    scope.add_region_bytes(rt, task->regions);
+
     const ComputeCFsTaskArgs& args =
       *static_cast<ComputeCFsTaskArgs*>(task->args);
     std::vector<Table::Desc> tdescs{args.ps, args.gc};
@@ -168,6 +168,7 @@ WTermTable::preregister_tasks() {
 #endif
 
     compute_cfs_task_id = Runtime::generate_static_task_id();
+    Instrumentation::register_task(compute_cfs_task_id, compute_cfs_task_name);
 
 #if USE_KOKKOS_VARIANT(SERIAL, CFS_TASK)
     // register a serial version on the CPU
@@ -18,6 +18,7 @@
 
 #include <hyperion/synthesis/CFTable.h>
 #include <hyperion/synthesis/GridCoordinateTable.h>
+#include <hyperion/Instrumentation.h>
 
 #include <array>
 #include <cmath>
@@ -90,6 +91,9 @@ public:
     Legion::Context ctx,
     Legion::Runtime* rt) {
 
+  Instrumentation::Scope scope(task);
+  scope.add_region_bytes(rt, task->regions);
+
   const ComputeCFsTaskArgs& args =
     *static_cast<const ComputeCFsTaskArgs*>(task->args);
   std::vector<Table::Desc> tdesc{args.w, args.gc};
@@ -0,0 +1,772 @@
+/*
+ * Copyright 2020 Associated Universities, Inc. Washington DC, USA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <hyperion/testing/TestSuiteDriver.h>
+#include <hyperion/testing/TestRecorder.h>
+
+#include <hyperion/hyperion.h>
+#include <hyperion/utility.h>
+#include <hyperion/synthesis/FFT.h>
+
+#include <mappers/default_mapper.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <stdlib.h>
+#include <string>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+using namespace hyperion;
+using namespace hyperion::synthesis;
+using namespace Legion;
+
+enum {
+  FFT_TEST_SUITE,
+};
+
+enum {
+  VALUE_FID = 10
+};
+
+#if HAVE_CXX17
+#define TE(f) testing::TestEval([&](){ return f; }, #f)
+#else
+#define TE(f) testing::TestEval<std::function<bool()>>([&](){ return f; }, #f)
+#endif
+
+// deterministic, irregular array values
+template <typename T>
+std::vector<complex<T>>
+test_values(size_t n) {
+  std::vector<complex<T>> result;
+  result.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    result.emplace_back(std::cos(0.3 * i * i), std::sin(0.7 * i));
+  return result;
+}
+
+// write values to a region, in row-major order
+template <typename T, int N>
+void
+write_region(
+  Context ctx,
+  Runtime* rt,
+  LogicalRegion lr,
+  const std::vector<complex<T>>& values) {
+
+  RegionRequirement req(lr, LEGION_WRITE_DISCARD, EXCLUSIVE, lr);
+  req.add_field(VALUE_FID);
+  PhysicalRegion pr = rt->map_region(ctx, req);
+  const FieldAccessor<
+    LEGION_WRITE_DISCARD,
+    complex<T>,
+    N,
+    coord_t,
+    AffineAccessor<complex<T>, N, coord_t>> acc(pr, VALUE_FID);
+  size_t i = 0;
+  for (PointInRectIterator<N> pir(
+         rt->get_index_space_domain(lr.get_index_space()),
+         false);
+       pir();
+       pir++)
+    acc[*pir] = values[i++];
+  rt->unmap_region(ctx, pr);
+}
+
+// read values from a region, in row-major order
+template <typename T, int N>
+std::vector<complex<T>>
+read_region(Context ctx, Runtime* rt, LogicalRegion lr) {
+
+  RegionRequirement req(lr, LEGION_READ_ONLY, EXCLUSIVE, lr);
+  req.add_field(VALUE_FID);
+  PhysicalRegion pr = rt->map_region(ctx, req);
+  const FieldAccessor<
+    LEGION_READ_ONLY,
+    complex<T>,
+    N,
+    coord_t,
+    AffineAccessor<complex<T>, N, coord_t>> acc(pr, VALUE_FID);
+  std::vector<complex<T>> result;
+  for (PointInRectIterator<N> pir(
+         rt->get_index_space_domain(lr.get_index_space()),
+         false);
+       pir();
+       pir++)
+    result.push_back(acc[*pir]);
+  rt->unmap_region(ctx, pr);
+  return result;
+}
+
+template <typename T, int N>
+LogicalRegion
+create_region(
+  Context ctx,
+  Runtime* rt,
+  const Rect<N>& rect,
+  const std::vector<complex<T>>& values) {
+
+  IndexSpace is = rt->create_index_space(ctx, rect);
+  FieldSpace fs = rt->create_field_space(ctx);
+  {
+    FieldAllocator fa = rt->create_field_allocator(ctx, fs);
+    fa.allocate_field(sizeof(complex<T>), VALUE_FID);
+  }
+  LogicalRegion result = rt->create_logical_region(ctx, is, fs);
+  write_region<T, N>(ctx, rt, result, values);
+  return result;
+}
+
+void
+destroy_region(Context ctx, Runtime* rt, LogicalRegion lr) {
+  rt->destroy_logical_region(ctx, lr);
+  rt->destroy_field_space(ctx, lr.get_field_space());
+  rt->destroy_index_space(ctx, lr.get_index_space());
+}
+
+template <typename T>
+FFT::Args
+fft_args(unsigned rank, FFT::Mode mode, unsigned flags = FFTW_ESTIMATE) {
+  FFT::Args result;
+  result.desc.rank = rank;
+  result.desc.transform = FFT::Type::C2C;
+  result.desc.precision =
+    (std::is_same<T, float>::value
+     ? FFT::Precision::SINGLE
+     : FFT::Precision::DOUBLE);
+  result.desc.sign = FFTW_FORWARD;
+  result.fid = VALUE_FID;
+  result.rotate_in = false;
+  result.rotate_out = false;
+  result.flags = flags;
+  result.seconds = -1;
+  result.mode = mode;
+  return result;
+}
+
+// transform the arrays in a region with a cached plan
+int
+execute_cached(
+  Context ctx,
+  Runtime* rt,
+  LogicalRegion lr,
+  const FFT::Args& args) {
+
+  TaskLauncher task(
+    FFT::execute_cached_plan_task_id,
+    TaskArgument(&args, sizeof(args)));
+  RegionRequirement req(lr, LEGION_READ_WRITE, EXCLUSIVE, lr);
+  req.add_field(VALUE_FID);
+  task.add_region_requirement(req);
+  return rt->execute_task(ctx, task).get_result<int>();
+}
+
+// transform the arrays in a region by creating, executing and destroying a
+// plan, without the plan cache
+int
+execute_uncached(
+  Context ctx,
+  Runtime* rt,
+  LogicalRegion lr,
+  const FFT::Args& args) {
+
+  RegionRequirement req(lr, LEGION_READ_WRITE, EXCLUSIVE, lr);
+  req.add_field(VALUE_FID);
+  req.tag = Mapping::DefaultMapper::MappingTags::SAME_ADDRESS_SPACE;
+
+  TaskLauncher creator(
+    FFT::create_plan_task_id,
+    TaskArgument(&args, sizeof(args)));
+  creator.add_region_requirement(req);
+  auto plan = rt->execute_task(ctx, creator);
+
+  bool destroy_plan = false;
+  TaskLauncher executor(
+    FFT::execute_fft_task_id,
+    TaskArgument(&destroy_plan, sizeof(destroy_plan)));
+  executor.add_region_requirement(req);
+  executor.add_future(plan);
+  auto rc = rt->execute_task(ctx, executor);
+
+  TaskLauncher destroyer(FFT::destroy_plan_task_id, TaskArgument());
+  destroyer.add_future(plan);
+  destroyer.add_future(rc);
+  rt->execute_task(ctx, destroyer);
+  return rc.get_result<int>();
+}
+
+// element-wise comparison of arrays, with tolerance relative to the larger of
+// one and the magnitude of the expected value
+template <typename T>
+bool
+all_close(
+  const std::vector<complex<T>>& values,
+  const std::vector<complex<T>>& expected,
+  T tolerance) {
+
+  if (values.size() != expected.size())
+    return false;
+  for (size_t i = 0; i < values.size(); ++i) {
+    const T err =
+      std::hypot(
+        values[i].real() - expected[i].real(),
+        values[i].imag() - expected[i].imag());
+    const T mag = std::hypot(expected[i].real(), expected[i].imag());
+    if (!(err <= tolerance * std::max(T(1), mag)))
+      return false;
+  }
+  return true;
+}
+
+void
+plan_cache_tests(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  typedef float T;
+  const T tolerance = 1.0e-5;
+
+  // three arrays of five values; since the values are single precision complex
+  // numbers, only the first array is aligned for SIMD instructions
+  const Rect<2> rect({0, 0}, {2, 4});
+  const auto values = test_values<T>(rect.volume());
+
+  FFT::clear_plan_cache(ctx, rt);
+  recorder.expect_true(
+    "Plan cache is initially empty",
+    TE(FFT::num_cached_plans(ctx, rt) == 0));
+
+  LogicalRegion ref = create_region<T, 2>(ctx, rt, rect, values);
+  const auto batched = fft_args<T>(1, FFT::Mode::BATCHED);
+  const int ref_rc = execute_uncached(ctx, rt, ref, batched);
+  recorder.assert_true("Uncached FFT succeeds", TE(ref_rc == 0));
+  const auto expected = read_region<T, 2>(ctx, rt, ref);
+  destroy_region(ctx, rt, ref);
+  recorder.expect_true(
+    "Uncached FFT does not add to plan cache",
+    TE(FFT::num_cached_plans(ctx, rt) == 0));
+
+  LogicalRegion lr = create_region<T, 2>(ctx, rt, rect, values);
+  {
+    const int rc = execute_cached(ctx, rt, lr, batched);
+    recorder.expect_true("Cached FFT succeeds", TE(rc == 0));
+    const auto result = read_region<T, 2>(ctx, rt, lr);
+    recorder.expect_true(
+      "Cached FFT result equals uncached FFT result",
+      TE(all_close(result, expected, tolerance)));
+    recorder.expect_true(
+      "Plan is added to plan cache",
+      TE(FFT::num_cached_plans(ctx, rt) == 1));
+  }
+  {
+    write_region<T, 2>(ctx, rt, lr, values);
+    const int rc = execute_cached(ctx, rt, lr, batched);
+    recorder.expect_true("Repeated cached FFT succeeds", TE(rc == 0));
+    const auto result = read_region<T, 2>(ctx, rt, lr);
+    recorder.expect_true(
+      "Repeated cached FFT result equals uncached FFT result",
+      TE(all_close(result, expected, tolerance)));
+    recorder.expect_true(
+      "Cached plan is reused",
+      TE(FFT::num_cached_plans(ctx, rt) == 1));
+  }
+  {
+    // in MULTITHREADED mode a plan for a single array is executed on every
+    // array in turn, which requires a plan created with FFTW_UNALIGNED
+    write_region<T, 2>(ctx, rt, lr, values);
+    const int rc =
+      execute_cached(ctx, rt, lr, fft_args<T>(1, FFT::Mode::MULTITHREADED));
+    recorder.expect_true(
+      "Cached FFT of unaligned arrays succeeds",
+      TE(rc == 0));
+    const auto result = read_region<T, 2>(ctx, rt, lr);
+    recorder.expect_true(
+      "Cached FFT result of unaligned arrays equals uncached FFT result",
+      TE(all_close(result, expected, tolerance)));
+    recorder.expect_true(
+      "Plan for unaligned arrays is added to plan cache",
+      TE(FFT::num_cached_plans(ctx, rt) == 2));
+  }
+  destroy_region(ctx, rt, lr);
+
+  FFT::clear_plan_cache(ctx, rt);
+  recorder.expect_true(
+    "Plan cache is empty after clear_plan_cache()",
+    TE(FFT::num_cached_plans(ctx, rt) == 0));
+}
+
+// values of the arrays in a region after transforming them with a cached plan
+template <typename T, int N>
+std::vector<complex<T>>
+cached_transform(
+  Context ctx,
+  Runtime* rt,
+  LogicalRegion lr,
+  const std::vector<complex<T>>& values,
+  const FFT::Args& args,
+  int& rc) {
+
+  write_region<T, N>(ctx, rt, lr, values);
+  rc = execute_cached(ctx, rt, lr, args);
+  return read_region<T, N>(ctx, rt, lr);
+}
+
+// compare the results of the execution modes on a region of rank-2 arrays;
+// "auto_mode" is the mode that AUTO is expected to select
+template <typename T>
+void
+compare_modes(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder,
+  const Rect<3>& rect,
+  FFT::Mode auto_mode,
+  const std::string& prefix) {
+
+  const T tolerance = 1.0e-4;
+  const auto values = test_values<T>(rect.volume());
+  LogicalRegion lr = create_region<T, 3>(ctx, rt, rect, values);
+  int batched_rc, multithreaded_rc, auto_rc;
+
+  FFT::clear_plan_cache(ctx, rt);
+  const auto first_mode =
+    ((auto_mode == FFT::Mode::BATCHED)
+     ? FFT::Mode::BATCHED
+     : FFT::Mode::MULTITHREADED);
+  const auto second_mode =
+    ((auto_mode == FFT::Mode::BATCHED)
+     ? FFT::Mode::MULTITHREADED
+     : FFT::Mode::BATCHED);
+  // run the mode that AUTO should select first, so that AUTO reuses its plan
+  auto first =
+    cached_transform<T, 3>(
+      ctx,
+      rt,
+      lr,
+      values,
+      fft_args<T>(2, first_mode),
+      (first_mode == FFT::Mode::BATCHED) ? batched_rc : multithreaded_rc);
+  auto automatic =
+    cached_transform<T, 3>(
+      ctx,
+      rt,
+      lr,
+      values,
+      fft_args<T>(2, FFT::Mode::AUTO),
+      auto_rc);
+  recorder.expect_true(
+    prefix + ": AUTO mode selects "
+    + ((auto_mode == FFT::Mode::BATCHED) ? "BATCHED" : "MULTITHREADED")
+    + " mode",
+    TE(FFT::num_cached_plans(ctx, rt) == 1));
+  auto second =
+    cached_transform<T, 3>(
+      ctx,
+      rt,
+      lr,
+      values,
+      fft_args<T>(2, second_mode),
+      (second_mode == FFT::Mode::BATCHED) ? batched_rc : multithreaded_rc);
+  destroy_region(ctx, rt, lr);
+  FFT::clear_plan_cache(ctx, rt);
+
+  recorder.assert_true(
+    prefix + ": FFTs in all modes succeed",
+    TE(batched_rc == 0 && multithreaded_rc == 0 && auto_rc == 0));
+  recorder.expect_true(
+    prefix + ": BATCHED and MULTITHREADED mode results are equal",
+    TE(all_close(first, second, tolerance)));
+  recorder.expect_true(
+    prefix + ": AUTO and explicit mode results are equal",
+    TE(all_close(automatic, first, tolerance)));
+}
+
+void
+mode_tests(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  // four small arrays
+  compare_modes<double>(
+    ctx,
+    rt,
+    recorder,
+    Rect<3>({0, 0, 0}, {3, 15, 15}),
+    FFT::Mode::BATCHED,
+    "Small arrays");
+
+  // two arrays of at least multithreaded_min_size elements
+  {
+    const coord_t n =
+      static_cast<coord_t>(std::ceil(std::sqrt(FFT::multithreaded_min_size)));
+    compare_modes<float>(
+      ctx,
+      rt,
+      recorder,
+      Rect<3>({0, 0, 0}, {1, n - 1, n - 1}),
+      FFT::Mode::MULTITHREADED,
+      "Large arrays");
+  }
+
+  // NULL plan: there is no wisdom for a plan with these (unusual) dimensions,
+  // so that no plan is created when only wisdom may be used
+  {
+    typedef double T;
+    const Rect<3> rect({0, 0, 0}, {2, 6, 10});
+    const auto values = test_values<T>(rect.volume());
+    LogicalRegion lr = create_region<T, 3>(ctx, rt, rect, values);
+    int rc;
+    const auto result =
+      cached_transform<T, 3>(
+        ctx,
+        rt,
+        lr,
+        values,
+        fft_args<T>(
+          2,
+          FFT::Mode::BATCHED,
+          FFTW_MEASURE | FFTW_WISDOM_ONLY),
+        rc);
+    destroy_region(ctx, rt, lr);
+    recorder.expect_true(
+      "FFT without a plan returns an error code",
+      TE(rc == 1));
+    recorder.expect_true(
+      "FFT without a plan fills arrays with NaN",
+      TE(
+        std::all_of(
+          result.begin(),
+          result.end(),
+          [](const complex<T>& v) {
+            return std::isnan(v.real()) && std::isnan(v.imag());
+          })));
+    recorder.expect_true(
+      "Missing plan is not cached",
+      TE(FFT::num_cached_plans(ctx, rt) == 0));
+  }
+}
+
+// row-major multi-index of offset i in an array with shape "dims"
+std::vector<size_t>
+unravel(size_t i, const std::vector<size_t>& dims) {
+  std::vector<size_t> result(dims.size());
+  for (size_t j = dims.size(); j > 0; --j) {
+    result[j - 1] = i % dims[j - 1];
+    i /= dims[j - 1];
+  }
+  return result;
+}
+
+// row-major offset of multi-index "idx" in an array with shape "dims"
+size_t
+ravel(const std::vector<size_t>& idx, const std::vector<size_t>& dims) {
+  size_t result = 0;
+  for (size_t j = 0; j < dims.size(); ++j)
+    result = result * dims[j] + idx[j];
+  return result;
+}
+
+// fftshift (or ifftshift, when "inverse" is true) of the arrays of the given
+// rank in the trailing axes of "values", implemented as numpy does it: fftshift
+// rolls every array axis of length n by n / 2 elements towards higher indexes,
+// and ifftshift rolls it back
+template <typename T>
+std::vector<complex<T>>
+reference_shift(
+  const std::vector<complex<T>>& values,
+  const std::vector<size_t>& dims,
+  unsigned rank,
+  bool inverse) {
+
+  std::vector<complex<T>> result(values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    auto idx = unravel(i, dims);
+    for (size_t j = dims.size() - rank; j < dims.size(); ++j)
+      idx[j] = (idx[j] + dims[j] / 2) % dims[j];
+    if (inverse)
+      result[i] = values[ravel(idx, dims)];
+    else
+      result[ravel(idx, dims)] = values[i];
+  }
+  return result;
+}
+
+// direct DFT of the arrays of the given rank in the trailing axes of "values"
+template <typename T>
+std::vector<complex<T>>
+reference_dft(
+  const std::vector<complex<T>>& values,
+  const std::vector<size_t>& dims,
+  unsigned rank,
+  int sign) {
+
+  const size_t outer = dims.size() - rank;
+  std::vector<complex<T>> result(values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto k = unravel(i, dims);
+    std::complex<double> sum = 0;
+    for (size_t m = 0; m < values.size(); ++m) {
+      const auto x = unravel(m, dims);
+      if (!std::equal(k.begin(), k.begin() + outer, x.begin()))
+        continue;
+      double phase = 0;
+      for (size_t j = outer; j < dims.size(); ++j)
+        phase += static_cast<double>(k[j] * x[j] % dims[j]) / dims[j];
+      sum +=
+        std::complex<double>(values[m].real(), values[m].imag())
+        * std::polar(1.0, sign * 2 * M_PI * phase);
+    }
+    result[i] = complex<T>(sum.real(), sum.imag());
+  }
+  return result;
+}
+
+// rotate the arrays in a region with rotate_arrays_task
+void
+rotate(
+  Context ctx,
+  Runtime* rt,
+  LogicalRegion lr,
+  const FFT::RotateArgs& args) {
+
+  TaskLauncher task(
+    FFT::rotate_arrays_task_id,
+    TaskArgument(&args, sizeof(args)));
+  RegionRequirement req(lr, LEGION_READ_WRITE, EXCLUSIVE, lr);
+  req.add_field(VALUE_FID);
+  task.add_region_requirement(req);
+  rt->execute_task(ctx, task);
+}
+
+// compare rotations in both directions of the arrays of the given rank in a
+// region with shape "dims" to the reference shifts
+template <int N>
+void
+compare_rotations(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder,
+  const std::vector<size_t>& dims,
+  unsigned rank) {
+
+  typedef double T;
+  assert(dims.size() == N);
+
+  Rect<N> rect;
+  std::string shape;
+  for (size_t i = 0; i < N; ++i) {
+    rect.lo[i] = 0;
+    rect.hi[i] = dims[i] - 1;
+    shape += (i == 0 ? "" : "x") + std::to_string(dims[i]);
+  }
+  const auto values = test_values<T>(rect.volume());
+  LogicalRegion lr = create_region<T, N>(ctx, rt, rect, values);
+  const std::string prefix =
+    "Rank " + std::to_string(rank) + " arrays in " + shape + " region: ";
+  for (bool inverse : {false, true}) {
+    write_region<T, N>(ctx, rt, lr, values);
+    const FFT::RotateArgs args{
+      fft_args<T>(rank, FFT::Mode::BATCHED).desc,
+      inverse};
+    rotate(ctx, rt, lr, args);
+    const auto result = read_region<T, N>(ctx, rt, lr);
+    recorder.expect_true(
+      prefix + (inverse ? "ifftshift" : "fftshift") + " rotation is correct",
+      TE(result == reference_shift(values, dims, rank, inverse)));
+  }
+  destroy_region(ctx, rt, lr);
+}
+
+void
+rotation_tests(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  // fftshift and ifftshift differ only on axes of odd length
+  compare_rotations<2>(ctx, rt, recorder, {2, 5}, 1);
+  compare_rotations<2>(ctx, rt, recorder, {2, 6}, 1);
+  compare_rotations<3>(ctx, rt, recorder, {2, 5, 6}, 2);
+  compare_rotations<3>(ctx, rt, recorder, {3, 4, 5}, 3);
+
+  // a cached FFT with rotations on both sides is fftshift(fft(ifftshift(x)))
+  typedef double T;
+  const T tolerance = 1.0e-9;
+  for (const auto& dims :
+         std::vector<std::vector<size_t>>{{3, 7}, {3, 8}, {2, 5, 6}}) {
+    const unsigned rank = dims.size() - 1;
+    std::vector<complex<T>> values;
+    std::vector<complex<T>> result;
+    int rc;
+    auto args = fft_args<T>(rank, FFT::Mode::BATCHED);
+    args.rotate_in = true;
+    args.rotate_out = true;
+    if (rank == 1) {
+      const Rect<2> rect({0, 0}, {coord_t(dims[0] - 1), coord_t(dims[1] - 1)});
+      values = test_values<T>(rect.volume());
+      LogicalRegion lr = create_region<T, 2>(ctx, rt, rect, values);
+      result = cached_transform<T, 2>(ctx, rt, lr, values, args, rc);
+      destroy_region(ctx, rt, lr);
+    } else {
+      const Rect<3> rect(
+        {0, 0, 0},
+        {coord_t(dims[0] - 1), coord_t(dims[1] - 1), coord_t(dims[2] - 1)});
+      values = test_values<T>(rect.volume());
+      LogicalRegion lr = create_region<T, 3>(ctx, rt, rect, values);
+      result = cached_transform<T, 3>(ctx, rt, lr, values, args, rc);
+      destroy_region(ctx, rt, lr);
+    }
+    const auto expected =
+      reference_shift(
+        reference_dft(
+          reference_shift(values, dims, rank, true),
+          dims,
+          rank,
+          FFTW_FORWARD),
+        dims,
+        rank,
+        false);
+    std::string shape;
+    for (auto& d : dims)
+      shape += (shape.empty() ? "" : "x") + std::to_string(d);
+    recorder.expect_true(
+      "FFT with rotations of rank " + std::to_string(rank)
+      + " arrays in " + shape + " region equals shifted DFT",
+      TE(rc == 0 && all_close(result, expected, tolerance)));
+  }
+  FFT::clear_plan_cache(ctx, rt);
+}
+
+std::string
+temporary_file_name() {
+  std::string result = "fftw.XXXXXX";
+#if HAVE_CXX17
+  int fd = mkstemp(result.data());
+#else
+  int fd = mkstemp(const_cast<char*>(result.data()));
+#endif
+  assert(fd != -1);
+  close(fd);
+  return result;
+}
+
+void
+wisdom_tests(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  typedef float T;
+  const T tolerance = 1.0e-5;
+  const Rect<2> rect({0, 0}, {1, 12});
+  const auto values = test_values<T>(rect.volume());
+  LogicalRegion lr = create_region<T, 2>(ctx, rt, rect, values);
+  const auto measure = fft_args<T>(1, FFT::Mode::BATCHED, FFTW_MEASURE);
+  const auto wisdom_only =
+    fft_args<T>(1, FFT::Mode::BATCHED, FFTW_MEASURE | FFTW_WISDOM_ONLY);
+  int rc;
+
+  unsetenv(FFT::wisdom_env_var);
+  recorder.expect_false(
+    "Wisdom is not imported without a file name",
+    TE(FFT::import_wisdom(ctx, rt, FFT::Precision::SINGLE)));
+  recorder.expect_false(
+    "Wisdom is not exported without a file name",
+    TE(FFT::export_wisdom(ctx, rt, FFT::Precision::SINGLE)));
+
+  FFT::clear_plan_cache(ctx, rt);
+  const auto expected =
+    cached_transform<T, 2>(ctx, rt, lr, values, measure, rc);
+  recorder.assert_true("FFT with measured plan succeeds", TE(rc == 0));
+
+  const std::string fname = temporary_file_name();
+  setenv(FFT::wisdom_env_var, fname.c_str(), 1);
+  recorder.expect_true(
+    "Wisdom is exported to file named by environment variable",
+    TE(FFT::export_wisdom(ctx, rt, FFT::Precision::SINGLE)));
+
+  FFT::clear_plan_cache(ctx, rt);
+  fftwf_mutex.lock(ctx, rt);
+  fftwf_forget_wisdom();
+  fftwf_mutex.unlock();
+  cached_transform<T, 2>(ctx, rt, lr, values, wisdom_only, rc);
+  recorder.expect_true(
+    "Wisdom-only FFT fails after wisdom is forgotten",
+    TE(rc == 1));
+
+  FFT::clear_plan_cache(ctx, rt);
+  recorder.expect_true(
+    "Wisdom is imported from file named by environment variable",
+    TE(FFT::import_wisdom(ctx, rt, FFT::Precision::SINGLE)));
+  const auto result =
+    cached_transform<T, 2>(ctx, rt, lr, values, wisdom_only, rc);
+  recorder.expect_true(
+    "Wisdom-only FFT succeeds after wisdom is imported",
+    TE(rc == 0 && all_close(result, expected, tolerance)));
+
+  unsetenv(FFT::wisdom_env_var);
+  unlink(fname.c_str());
+  destroy_region(ctx, rt, lr);
+  FFT::clear_plan_cache(ctx, rt);
+}
+
+void
+fft_test_suite(
+  const Task* task,
+  const std::vector<PhysicalRegion>& regions,
+  Context ctx,
+  Runtime* rt) {
+
+  testing::TestRecorder<READ_WRITE> recorder(
+    testing::TestLog<READ_WRITE>(
+      task->regions[0].region,
+      regions[0],
+      task->regions[1].region,
+      regions[1],
+      ctx,
+      rt));
+
+  plan_cache_tests(ctx, rt, recorder);
+  mode_tests(ctx, rt, recorder);
+  rotation_tests(ctx, rt, recorder);
+  wisdom_tests(ctx, rt, recorder);
+}
+
+int
+main(int argc, char* argv[]) {
+
+  testing::TestSuiteDriver driver =
+    testing::TestSuiteDriver::make<fft_test_suite>(
+      FFT_TEST_SUITE,
+      "fft_test_suite");
+
+  FFT::preregister_tasks();
+
+  return driver.start(argc, argv);
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 2
+// fill-column: 80
+// indent-tabs-mode: nil
+// End:
@@ -0,0 +1,444 @@
+/*
+ * Copyright 2020 Associated Universities, Inc. Washington DC, USA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <hyperion/testing/TestSuiteDriver.h>
+#include <hyperion/testing/TestRecorder.h>
+
+#include <hyperion/gridder/gridder.h>
+#include <hyperion/synthesis/GriddingKernelTable.h>
+#include <hyperion/synthesis/FFT.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+using namespace hyperion;
+using namespace Legion;
+
+enum {
+  GRIDDER_TEST_SUITE,
+};
+
+#if HAVE_CXX17
+#define TE(f) testing::TestEval([&](){ return f; }, #f)
+#else
+#define TE(f) testing::TestEval<std::function<bool()>>([&](){ return f; }, #f)
+#endif
+
+typedef synthesis::GriddingKernelTable<synthesis::CF_W> kernel_table_t;
+
+typedef complex<float> value_t;
+
+#define GRID_SIZE 16
+#define OVERSAMPLING 4
+#define SUPPORT 3
+#define UV_CELL 10.0
+
+// kernel box width for SUPPORT and OVERSAMPLING: 2 * (1 * 4 + 2) + 1
+#define BOX_SIZE 13
+
+// offset of the kernel in the packed kernel values, to verify that the kernel
+// offset is respected
+#define KERNEL_OFFSET 7
+
+// packed kernel values; the value at (i, j) in the kernel box is (i + 1, j +
+// 1), which identifies the box index of every value on the grid
+std::vector<value_t>
+packed_kernel() {
+  std::vector<value_t> result(KERNEL_OFFSET + BOX_SIZE * BOX_SIZE);
+  for (size_t i = 0; i < BOX_SIZE; ++i)
+    for (size_t j = 0; j < BOX_SIZE; ++j)
+      result[KERNEL_OFFSET + i * BOX_SIZE + j] = value_t(i + 1, j + 1);
+  return result;
+}
+
+// grid a single visibility with uv coordinates (in wavelengths) (u, v) onto a
+// zero-valued grid; returns false when the visibility is not gridded
+bool
+grid_point_source(
+  double u,
+  double v,
+  const value_t& vis,
+  bool conj,
+  std::vector<value_t>& grid) {
+
+  static const std::vector<value_t> kernel = packed_kernel();
+  grid.assign(GRID_SIZE * GRID_SIZE, value_t(0, 0));
+  double uv[2];
+  gridder::grid_coordinates(u, v, UV_CELL, GRID_SIZE, uv);
+  auto cell = gridder::nearest_grid_cell(uv, GRID_SIZE, SUPPORT);
+  if (!cell)
+    return false;
+  gridder::grid_visibility<kernel_table_t>(
+    cell.value(),
+    gridder::subcell_offset(uv, cell.value(), OVERSAMPLING),
+    SUPPORT,
+    OVERSAMPLING,
+    KERNEL_OFFSET,
+    conj,
+    vis,
+    [](coord_t i) {
+      return kernel[i];
+    },
+    [&grid](coord_t gu, coord_t gv, const value_t& x) {
+      grid[gu * GRID_SIZE + gv] += x;
+    });
+  return true;
+}
+
+// compare grid values with the expected footprint of a visibility: the cells
+// (u0 + du, v0 + dv), for du, dv in [-1, 1], have the kernel values at box rows
+// "rows[du + 1]" and box columns "cols[dv + 1]", multiplied by "vis", and all
+// other cells are zero
+bool
+has_footprint(
+  const std::vector<value_t>& grid,
+  coord_t u0,
+  coord_t v0,
+  const coord_t rows[3],
+  const coord_t cols[3],
+  const value_t& vis,
+  bool conj) {
+
+  bool result = true;
+  for (coord_t u = 0; u < GRID_SIZE; ++u)
+    for (coord_t v = 0; v < GRID_SIZE; ++v) {
+      value_t expected(0, 0);
+      if (std::abs(u - u0) <= 1 && std::abs(v - v0) <= 1) {
+        expected =
+          value_t(
+            rows[u - u0 + 1] + 1,
+            (conj ? -1 : 1) * (cols[v - v0 + 1] + 1))
+          * vis;
+      }
+      result = result && grid[u * GRID_SIZE + v] == expected;
+    }
+  return result;
+}
+
+#define CF_SIZE 32
+#define CF_OVERSAMPLING 2
+#define CF_THRESHOLD 0.01
+
+// standard deviations (in CF grid cells) of the Gaussian CFs of the kernel
+// table planes
+const std::vector<double> cf_sigmas{1.5, 2.0, 3.0, 4.0};
+
+// support of the kernel of a Gaussian CF with standard deviation "sigma": the
+// uv domain kernel is a Gaussian with standard deviation N / (2 pi sigma), in
+// oversampled samples, where N is the size of the padded CF; the values of the
+// chosen CFs are not close to the threshold at any sample
+kernel_table_t::support_t
+gaussian_support(double sigma) {
+  const double n = CF_SIZE * CF_OVERSAMPLING;
+  const coord_t radius =
+    static_cast<coord_t>(
+      std::floor(
+        n / (2 * M_PI * sigma) * std::sqrt(-2 * std::log(CF_THRESHOLD))));
+  const coord_t half_support =
+    std::min<coord_t>(
+      (radius + CF_OVERSAMPLING - 1) / CF_OVERSAMPLING,
+      CF_SIZE / 2);
+  return static_cast<kernel_table_t::support_t>(2 * half_support + 1);
+}
+
+// CFTable with a Gaussian CF (values and weights) in every W plane
+synthesis::CFTable<synthesis::CF_W>
+gaussian_cfs(Context ctx, Runtime* rt) {
+
+  typedef synthesis::CFTable<synthesis::CF_W> cf_table_t;
+  std::vector<float> w_values;
+  for (size_t i = 0; i < cf_sigmas.size(); ++i)
+    w_values.push_back(i);
+  cf_table_t result(
+    ctx,
+    rt,
+    CF_SIZE,
+    synthesis::CFTableBase::Axis<synthesis::CF_W>(w_values));
+  auto colreqs = Column::default_requirements_mapped;
+  colreqs.values.privilege = LEGION_WRITE_ONLY;
+  PhysicalTableGuard<cf_table_t::physical_table_t> pt(
+    ctx,
+    rt,
+    cf_table_t::physical_table_t(
+      result.map_inline(
+        ctx,
+        rt,
+        {{synthesis::CFTableBase::CF_VALUE_COLUMN_NAME, colreqs},
+         {synthesis::CFTableBase::CF_WEIGHT_COLUMN_NAME, colreqs}},
+        Column::default_requirements_mapped)));
+  auto value_col = pt->value<AffineAccessor>();
+  auto values = value_col.accessor<LEGION_WRITE_ONLY>();
+  auto weights =
+    pt->weight<AffineAccessor>().accessor<LEGION_WRITE_ONLY>();
+  const double center = CF_SIZE / 2;
+  for (PointInRectIterator<cf_table_t::cf_rank> pir(value_col.rect());
+       pir();
+       pir++) {
+    const double sigma = cf_sigmas[(*pir)[0]];
+    const double dx = (*pir)[cf_table_t::d_x] - center;
+    const double dy = (*pir)[cf_table_t::d_y] - center;
+    const synthesis::CFTableBase::cf_value_t v(
+      std::exp(-(dx * dx + dy * dy) / (2 * sigma * sigma)),
+      0);
+    values[*pir] = v;
+    weights[*pir] = v;
+  }
+  return result;
+}
+
+void
+gridding_kernel_table_tests(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  auto cfs = gaussian_cfs(ctx, rt);
+  auto kt =
+    kernel_table_t::create(
+      ctx,
+      rt,
+      cfs,
+      CF_OVERSAMPLING,
+      CF_THRESHOLD,
+      FFTW_ESTIMATE,
+      1.0);
+  cfs.destroy(ctx, rt);
+
+  std::vector<kernel_table_t::support_t> supports;
+  std::vector<kernel_table_t::offset_t> offsets;
+  {
+    PhysicalTableGuard<PhysicalTable> pt(
+      ctx,
+      rt,
+      kt.map_inline(
+        ctx,
+        rt,
+        {{kernel_table_t::SUPPORT_COLUMN_NAME,
+          Column::default_requirements_mapped},
+         {kernel_table_t::OFFSET_COLUMN_NAME,
+          Column::default_requirements_mapped}},
+        CXX_OPTIONAL_NAMESPACE::nullopt));
+    kernel_table_t::SupportColumn<AffineAccessor>
+      support_col(*pt->column(kernel_table_t::SUPPORT_COLUMN_NAME).value());
+    auto support = support_col.accessor<LEGION_READ_ONLY>();
+    auto offset =
+      kernel_table_t::OffsetColumn<AffineAccessor>(
+        *pt->column(kernel_table_t::OFFSET_COLUMN_NAME).value())
+      .accessor<LEGION_READ_ONLY>();
+    for (PointInRectIterator<kernel_table_t::directory_rank> pir(
+           support_col.rect());
+         pir();
+         pir++) {
+      supports.push_back(support[*pir]);
+      offsets.push_back(offset[*pir]);
+    }
+  }
+  recorder.assert_true(
+    "Kernel table has one kernel per CF",
+    TE(supports.size() == cf_sigmas.size()));
+
+  recorder.expect_true(
+    "Kernel supports are those of the Gaussian CFs",
+    testing::TestEval<std::function<bool()>>(
+      [&]() {
+        bool result = true;
+        for (size_t i = 0; i < cf_sigmas.size(); ++i)
+          result =
+            result && supports[i] == gaussian_support(cf_sigmas[i]);
+        return result;
+      }));
+  recorder.expect_true(
+    "Kernel table maximum support is the largest kernel support",
+    TE(kt.max_support()
+       == *std::max_element(supports.begin(), supports.end())));
+  recorder.expect_true(
+    "Kernel offsets are the running sum of kernel box sizes",
+    testing::TestEval<std::function<bool()>>(
+      [&]() {
+        bool result = true;
+        size_t sum = 0;
+        for (size_t i = 0; i < supports.size(); ++i) {
+          result = result && offsets[i] == sum;
+          const size_t sz =
+            kernel_table_t::box_size(supports[i], CF_OVERSAMPLING);
+          sum += sz * sz;
+        }
+        return result;
+      }));
+
+  {
+    PhysicalTableGuard<PhysicalTable> pt(
+      ctx,
+      rt,
+      kt.kernels().map_inline(
+        ctx,
+        rt,
+        {},
+        Column::default_requirements_mapped));
+    auto weight_col =
+      kernel_table_t::KernelWeightColumn<AffineAccessor>(
+        *pt->column(synthesis::CFTableBase::CF_WEIGHT_COLUMN_NAME).value());
+    auto weight = weight_col.accessor<LEGION_READ_ONLY>();
+    recorder.expect_true(
+      "Packed kernel columns hold all kernel boxes",
+      testing::TestEval<std::function<bool()>>(
+        [&]() {
+          const size_t sz =
+            kernel_table_t::box_size(supports.back(), CF_OVERSAMPLING);
+          return
+            static_cast<size_t>(weight_col.rect().volume())
+            == offsets.back() + sz * sz;
+        }));
+    recorder.expect_true(
+      "Kernel weights at grid cell centers sum to one",
+      testing::TestEval<std::function<bool()>>(
+        [&]() {
+          bool result = true;
+          for (size_t i = 0; i < supports.size(); ++i) {
+            const auto sup = supports[i];
+            const coord_t sz = kernel_table_t::box_size(sup, CF_OVERSAMPLING);
+            synthesis::CFTableBase::cf_weight_t sum(0);
+            for (coord_t du = -sup / 2; du <= sup / 2; ++du)
+              for (coord_t dv = -sup / 2; dv <= sup / 2; ++dv)
+                sum +=
+                  weight[
+                    offsets[i]
+                    + kernel_table_t::box_index(sup, CF_OVERSAMPLING, du, 0)
+                    * sz
+                    + kernel_table_t::box_index(sup, CF_OVERSAMPLING, dv, 0)];
+            result =
+              result && std::hypot(sum.real() - 1, sum.imag()) < 1.0e-4;
+          }
+          return result;
+        }));
+  }
+  kt.destroy(ctx, rt);
+}
+
+void
+gridder_test_suite(
+  const Task* task,
+  const std::vector<PhysicalRegion>& regions,
+  Context ctx,
+  Runtime* rt) {
+
+  testing::TestRecorder<READ_WRITE> recorder(
+    testing::TestLog<READ_WRITE>(
+      task->regions[0].region,
+      regions[0],
+      task->regions[1].region,
+      regions[1],
+      ctx,
+      rt));
+
+  recorder.assert_true(
+    "Kernel box size is as expected",
+    TE(kernel_table_t::box_size(SUPPORT, OVERSAMPLING) == BOX_SIZE));
+
+  std::vector<value_t> grid;
+  {
+    // a point source at the grid origin, without sub-cell offset, is centered
+    // on the grid center, with the central samples of the kernel box
+    const coord_t rows[3]{2, 6, 10};
+    const coord_t cols[3]{2, 6, 10};
+    const value_t vis(1, 0);
+    recorder.assert_true(
+      "Visibility at uv origin is gridded",
+      TE(grid_point_source(0.0, 0.0, vis, false, grid)));
+    recorder.expect_true(
+      "Visibility at uv origin has expected footprint",
+      TE(has_footprint(
+           grid,
+           GRID_SIZE / 2,
+           GRID_SIZE / 2,
+           rows,
+           cols,
+           vis,
+           false)));
+  }
+  {
+    // a visibility at (1.25, -2) cells from the grid center is gridded onto
+    // the cells around (9, 6), with a sub-cell offset of (1, 0) oversampled
+    // samples
+    const coord_t rows[3]{1, 5, 9};
+    const coord_t cols[3]{2, 6, 10};
+    const value_t vis(2, -1);
+    recorder.assert_true(
+      "Visibility with sub-cell offset is gridded",
+      TE(grid_point_source(1.25 * UV_CELL, -2.0 * UV_CELL, vis, false, grid)));
+    recorder.expect_true(
+      "Visibility with sub-cell offset has expected footprint",
+      TE(has_footprint(grid, 9, 6, rows, cols, vis, false)));
+  }
+  {
+    // a visibility with negative w is gridded with the conjugated kernel
+    const coord_t rows[3]{2, 6, 10};
+    const coord_t cols[3]{1, 5, 9};
+    const value_t vis(1, 0);
+    recorder.assert_true(
+      "Visibility gridded with conjugated kernel is gridded",
+      TE(grid_point_source(
+           -3.0 * UV_CELL,
+           0.25 * UV_CELL,
+           vis,
+           true,
+           grid)));
+    recorder.expect_true(
+      "Visibility gridded with conjugated kernel has expected footprint",
+      TE(has_footprint(grid, 5, 8, rows, cols, vis, true)));
+  }
+  {
+    // visibilities whose kernel footprint does not lie entirely on the grid
+    // are rejected
+    recorder.expect_false(
+      "Visibility with footprint crossing lower grid edge is not gridded",
+      TE(grid_point_source(-7.6 * UV_CELL, 0.0, value_t(1, 0), false, grid)));
+    recorder.expect_false(
+      "Visibility with footprint crossing upper grid edge is not gridded",
+      TE(grid_point_source(0.0, 6.6 * UV_CELL, value_t(1, 0), false, grid)));
+    recorder.expect_true(
+      "Visibility with footprint at grid edge is gridded",
+      TE(grid_point_source(-7.0 * UV_CELL, 0.0, value_t(1, 0), false, grid)));
+  }
+
+#ifdef HYPERION_USE_OPENMP
+  // FFT tasks, used to create the kernel table, have only OpenMP variants
+  gridding_kernel_table_tests(ctx, rt, recorder);
+#endif
+}
+
+int
+main(int argc, char* argv[]) {
+
+  testing::TestSuiteDriver driver =
+    testing::TestSuiteDriver::make<gridder_test_suite>(
+      GRIDDER_TEST_SUITE,
+      "gridder_test_suite");
+
+  synthesis::CFTableBase::preregister_all();
+  kernel_table_t::preregister_tasks();
+
+  return driver.start(argc, argv);
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 2
+// fill-column: 80
+// indent-tabs-mode: nil
+// End:
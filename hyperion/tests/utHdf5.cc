@@ -28,10 +28,12 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <fstream>
 #include <functional>
 #include <hdf5.h>
 #include <numeric>
 #include <set>
+#include <stdexcept>
 #include <stdlib.h>
 #include <unistd.h>
 
@@ -326,6 +328,14 @@ verify_col(
   return result;
 }
 
+void
+init_table0_z() {
+  for (size_t i = 0; i < TABLE0_NUM_ROWS; ++i) {
+    table0_z[2 * i] = table0_x[i];
+    table0_z[2 * i + 1] = table0_y[i];
+  }
+}
+
 void
 table_tests(
   Context ctx,
@@ -333,10 +343,7 @@ table_tests(
   bool save_output_file,
   testing::TestRecorder<READ_WRITE>& recorder) {
 
-  for (size_t i = 0; i < TABLE0_NUM_ROWS; ++i) {
-    table0_z[2 * i] = table0_x[i];
-    table0_z[2 * i + 1] = table0_y[i];
-  }
+  init_table0_z();
 
   // const float ms_vn = -42.1f;
   hyperion::string ms_nm("test");
@@ -715,6 +722,781 @@ table_tests(
     CXX_FILESYSTEM_NAMESPACE::remove(fname);
 }
 
+// table0 columns, without measures
+Table
+create_table0(Context ctx, Runtime* rt) {
+
+  auto xy_is = rt->create_index_space(ctx, Rect<1>(0, TABLE0_NUM_ROWS - 1));
+  auto xy_space =
+    ColumnSpace::create(
+      ctx,
+      rt,
+      std::vector<Table0Axes>{Table0Axes::ROW},
+      xy_is,
+      false);
+  auto z_is =
+    rt->create_index_space(
+      ctx,
+      Rect<2>(Point<2>(0, 0), Point<2>(TABLE0_NUM_ROWS - 1, 1)));
+  auto z_space =
+    ColumnSpace::create(
+      ctx,
+      rt,
+      std::vector<Table0Axes>{Table0Axes::ROW, Table0Axes::ZP},
+      z_is,
+      false);
+  std::vector<std::pair<std::string, TableField>> xy_fields{
+    {"X", TableField(HYPERION_TYPE_UINT, COL_X)},
+    {"Y", TableField(HYPERION_TYPE_UINT, COL_Y)}
+  };
+  std::vector<std::pair<std::string, TableField>> z_fields{
+    {"Z", TableField(HYPERION_TYPE_UINT, COL_Z)}
+  };
+  return
+    Table::create(
+      ctx,
+      rt,
+      xy_space,
+      {{xy_space, xy_fields}, {z_space, z_fields}});
+}
+
+std::string
+temporary_file_name() {
+  std::string result = "h5.XXXXXX";
+#if HAVE_CXX17
+  int fd = mkstemp(result.data());
+#else
+  int fd = mkstemp(const_cast<char*>(result.data()));
+#endif
+  assert(fd != -1);
+  close(fd);
+  return result;
+}
+
+// write table0 to a group named "table_name" in an HDF5 file, and copy the
+// table0 column values into the column datasets
+void
+write_table0(
+  Context ctx,
+  Runtime* rt,
+  hid_t fid,
+  const std::string& fname,
+  const std::string& table_name,
+  const ColumnDatasetOptions& options) {
+
+  init_table0_z();
+  auto tb0 = create_table0(ctx, rt);
+  {
+    hid_t tb_loc =
+      CHECK_H5(
+        H5Gcreate(
+          fid,
+          table_name.c_str(),
+          H5P_DEFAULT,
+          H5P_DEFAULT,
+          H5P_DEFAULT));
+    write_table(ctx, rt, tb_loc, tb0, options);
+    CHECK_H5(H5Gclose(tb_loc));
+    CHECK_H5(H5Fflush(fid, H5F_SCOPE_GLOBAL));
+  }
+  auto cols0 = tb0.columns();
+  std::unordered_map<std::string, unsigned*> col0_arrays{
+    {"X", table0_x},
+    {"Y", table0_y},
+    {"Z", table0_z}
+  };
+  std::unordered_map<std::string, PhysicalRegion> col0_prs;
+  for (auto& c : {"X", "Y", "Z"}) {
+    std::string cstr(c);
+    col0_prs[cstr] =
+      attach_table0_col(ctx, rt, cols0.at(cstr), col0_arrays.at(cstr));
+  }
+
+  hid_t root_loc = CHECK_H5(H5Gopen(fid, "/", H5P_DEFAULT));
+  auto itb1 = init_table(ctx, rt, root_loc, table_name);
+  CHECK_H5(H5Gclose(root_loc));
+  auto& tb1 = std::get<0>(itb1);
+  auto& tb1_paths = std::get<1>(itb1);
+  auto tb1_xy_pr =
+    attach_table_columns(
+      ctx,
+      rt,
+      fname,
+      "/",
+      tb1,
+      {"X", "Y"},
+      tb1_paths,
+      false,
+      true).value();
+  auto tb1_z_pr =
+    attach_table_columns(
+      ctx,
+      rt,
+      fname,
+      "/",
+      tb1,
+      {"Z"},
+      tb1_paths,
+      false,
+      true).value();
+  {
+    CopyLauncher copy;
+    {
+      auto src_lr = col0_prs["X"].get_logical_region();
+      RegionRequirement srq(src_lr, READ_ONLY, EXCLUSIVE, src_lr);
+      srq.add_field(cols0.at("X").fid);
+      srq.add_field(cols0.at("Y").fid);
+      auto dst_lr = tb1_xy_pr.get_logical_region();
+      RegionRequirement drq(dst_lr, WRITE_ONLY, EXCLUSIVE, dst_lr);
+      drq.add_field(cols0.at("X").fid);
+      drq.add_field(cols0.at("Y").fid);
+      copy.add_copy_requirements(srq, drq);
+    }
+    {
+      auto src_lr = col0_prs["Z"].get_logical_region();
+      RegionRequirement srq(src_lr, READ_ONLY, EXCLUSIVE, src_lr);
+      srq.add_field(cols0.at("Z").fid);
+      auto dst_lr = tb1_z_pr.get_logical_region();
+      RegionRequirement drq(dst_lr, WRITE_ONLY, EXCLUSIVE, dst_lr);
+      drq.add_field(cols0.at("Z").fid);
+      copy.add_copy_requirements(srq, drq);
+    }
+    rt->issue_copy_operation(ctx, copy);
+  }
+  rt->detach_external_resource(ctx, tb1_xy_pr).wait();
+  rt->detach_external_resource(ctx, tb1_z_pr).wait();
+  tb1.destroy(ctx, rt);
+  for (auto& c: {"X", "Y", "Z"})
+    rt->detach_external_resource(ctx, col0_prs[c]);
+  tb0.destroy(ctx, rt);
+}
+
+// verify the values of the columns of a table written by write_table0(),
+// attached by attach_table_columns()
+void
+verify_table0_values(
+  Context ctx,
+  Runtime* rt,
+  hid_t fid,
+  const std::string& fname,
+  const std::string& table_name,
+  const std::string& prefix,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  hid_t root_loc = CHECK_H5(H5Gopen(fid, "/", H5P_DEFAULT));
+  auto itb1 = init_table(ctx, rt, root_loc, table_name);
+  CHECK_H5(H5Gclose(root_loc));
+  auto& tb1 = std::get<0>(itb1);
+  auto& tb1_paths = std::get<1>(itb1);
+  auto cols1 = tb1.columns();
+  auto tb1_xy_pr =
+    attach_table_columns(
+      ctx,
+      rt,
+      fname,
+      "/",
+      tb1,
+      {"X", "Y"},
+      tb1_paths,
+      true,
+      true);
+  recorder.assert_true(
+    prefix + " X and Y columns attached",
+    TE((bool)tb1_xy_pr));
+  auto tb1_z_pr =
+    attach_table_columns(
+      ctx,
+      rt,
+      fname,
+      "/",
+      tb1,
+      {"Z"},
+      tb1_paths,
+      true,
+      true);
+  recorder.assert_true(
+    prefix + " Z column attached",
+    TE((bool)tb1_z_pr));
+  recorder.expect_true(
+    prefix + " column X values read as expected",
+    TE(verify_col<1>(
+         ctx,
+         rt,
+         table0_x,
+         tb1_xy_pr.value(),
+         cols1.at("X").fid,
+         {TABLE0_NUM_ROWS})));
+  recorder.expect_true(
+    prefix + " column Y values read as expected",
+    TE(verify_col<1>(
+         ctx,
+         rt,
+         table0_y,
+         tb1_xy_pr.value(),
+         cols1.at("Y").fid,
+         {TABLE0_NUM_ROWS})));
+  recorder.expect_true(
+    prefix + " column Z values read as expected",
+    TE(verify_col<2>(
+         ctx,
+         rt,
+         table0_z,
+         tb1_z_pr.value(),
+         cols1.at("Z").fid,
+         {TABLE0_NUM_ROWS, 2})));
+  rt->detach_external_resource(ctx, tb1_xy_pr.value());
+  rt->detach_external_resource(ctx, tb1_z_pr.value());
+  tb1.destroy(ctx, rt);
+}
+
+// test that a dataset has a chunked layout with the given chunk dimensions and
+// filter pipeline, or (when "chunk_dims" is empty) a contiguous layout
+bool
+has_layout(
+  hid_t fid,
+  const std::string& path,
+  const std::vector<hsize_t>& chunk_dims,
+  const std::vector<H5Z_filter_t>& filters) {
+
+  hid_t ds = CHECK_H5(H5Dopen(fid, path.c_str(), H5P_DEFAULT));
+  hid_t dcpl = CHECK_H5(H5Dget_create_plist(ds));
+  bool result;
+  if (chunk_dims.size() == 0) {
+    result = H5Pget_layout(dcpl) == H5D_CONTIGUOUS;
+  } else {
+    result = H5Pget_layout(dcpl) == H5D_CHUNKED;
+    if (result) {
+      std::vector<hsize_t> dims(chunk_dims.size() + 1);
+      int rank = H5Pget_chunk(dcpl, dims.size(), dims.data());
+      result =
+        rank == static_cast<int>(chunk_dims.size())
+        && std::equal(chunk_dims.begin(), chunk_dims.end(), dims.begin());
+    }
+  }
+  if (result) {
+    int nfilters = H5Pget_nfilters(dcpl);
+    result = nfilters == static_cast<int>(filters.size());
+    for (int i = 0; result && i < nfilters; ++i) {
+      unsigned flags;
+      size_t cd_nelmts = 0;
+      result =
+        H5Pget_filter2(dcpl, i, &flags, &cd_nelmts, NULL, 0, NULL, NULL)
+        == filters[i];
+    }
+  }
+  CHECK_H5(H5Pclose(dcpl));
+  CHECK_H5(H5Dclose(ds));
+  return result;
+}
+
+void
+chunked_table_tests(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  std::string fname = temporary_file_name();
+  hid_t fid = CHECK_H5(H5DatatypeManager::create(fname, H5F_ACC_TRUNC));
+  ColumnDatasetOptions chunked;
+  chunked.chunk_rows = 5;
+  chunked.deflate = 6;
+  chunked.shuffle = true;
+  write_table0(ctx, rt, fid, fname, "chunked", chunked);
+  write_table0(ctx, rt, fid, fname, "contiguous", ColumnDatasetOptions());
+
+  auto paths =
+    [fid](const std::string& table_name) {
+      return
+        get_table_column_paths(fid, "/" + table_name, {"X", "Y", "Z"});
+    };
+  {
+    hid_t tb_loc = CHECK_H5(H5Gopen(fid, "chunked", H5P_DEFAULT));
+    auto chunk_rows = read_chunk_rows(tb_loc);
+    CHECK_H5(H5Gclose(tb_loc));
+    recorder.assert_true(
+      "Chunked table has chunk_rows attribute",
+      TE((bool)chunk_rows));
+    recorder.expect_true(
+      "Chunked table chunk_rows attribute has expected value",
+      TE(chunk_rows.value() == chunked.chunk_rows));
+
+    auto ps = paths("chunked");
+    recorder.assert_true(
+      "Chunked table column paths exist",
+      TE(ps.count("X") > 0 && ps.count("Z") > 0));
+    const std::vector<H5Z_filter_t>
+      filters{H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE};
+    recorder.expect_true(
+      "Chunked table column X dataset has expected layout and filters",
+      TE(has_layout(fid, ps.at("X"), {5}, filters)));
+    recorder.expect_true(
+      "Chunked table column Z dataset has expected layout and filters",
+      TE(has_layout(fid, ps.at("Z"), {5, 2}, filters)));
+  }
+  {
+    hid_t tb_loc = CHECK_H5(H5Gopen(fid, "contiguous", H5P_DEFAULT));
+    auto chunk_rows = read_chunk_rows(tb_loc);
+    CHECK_H5(H5Gclose(tb_loc));
+    recorder.expect_false(
+      "Contiguous table has no chunk_rows attribute",
+      TE((bool)chunk_rows));
+
+    auto ps = paths("contiguous");
+    recorder.assert_true(
+      "Contiguous table column paths exist",
+      TE(ps.count("X") > 0 && ps.count("Z") > 0));
+    recorder.expect_true(
+      "Contiguous table column X dataset has contiguous layout",
+      TE(has_layout(fid, ps.at("X"), {}, {})));
+    recorder.expect_true(
+      "Contiguous table column Z dataset has contiguous layout",
+      TE(has_layout(fid, ps.at("Z"), {}, {})));
+  }
+  verify_table0_values(
+    ctx,
+    rt,
+    fid,
+    fname,
+    "chunked",
+    "Chunked table",
+    recorder);
+  verify_table0_values(
+    ctx,
+    rt,
+    fid,
+    fname,
+    "contiguous",
+    "Contiguous table",
+    recorder);
+  CHECK_H5(H5Fclose(fid));
+  CXX_FILESYSTEM_NAMESPACE::remove(fname);
+}
+
+// test that attach_all_table_columns() and attach_some_table_columns() pass
+// the "read_only" and "mapped" flags through to the column attachments
+void
+attach_selected_columns_tests(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  std::string fname = temporary_file_name();
+  hid_t fid = CHECK_H5(H5DatatypeManager::create(fname, H5F_ACC_TRUNC));
+  write_table0(ctx, rt, fid, fname, "selected", ColumnDatasetOptions());
+
+  hid_t root_loc = CHECK_H5(H5Gopen(fid, "/", H5P_DEFAULT));
+  auto itb = init_table(ctx, rt, root_loc, "selected");
+  CHECK_H5(H5Gclose(root_loc));
+  auto& tb = std::get<0>(itb);
+  auto& tb_paths = std::get<1>(itb);
+  const FieldID x_fid = tb.columns().at("X").fid;
+  {
+    auto prs =
+      attach_all_table_columns(
+        ctx,
+        rt,
+        fname,
+        "/",
+        tb,
+        {},
+        tb_paths,
+        true,
+        false);
+    recorder.expect_true(
+      "All table columns are attached",
+      TE(prs.size() == 3));
+    recorder.expect_true(
+      "Unmapped attachments of all table columns are not mapped",
+      testing::TestEval<std::function<bool()>>(
+        [&prs]() {
+          return
+            std::none_of(
+              prs.begin(),
+              prs.end(),
+              [](auto& pr_cols) { return std::get<0>(pr_cols).is_mapped(); });
+        }));
+    for (auto& pr_cols : prs)
+      rt->detach_external_resource(ctx, std::get<0>(pr_cols)).wait();
+  }
+  unsigned x_plus_10[TABLE0_NUM_ROWS];
+  for (size_t i = 0; i < TABLE0_NUM_ROWS; ++i)
+    x_plus_10[i] = table0_x[i] + 10;
+  {
+    auto prs =
+      attach_some_table_columns(
+        ctx,
+        rt,
+        fname,
+        "/",
+        tb,
+        {"X"},
+        tb_paths,
+        false,
+        true);
+    recorder.assert_true(
+      "Some table columns are attached",
+      TE(prs.size() == 1 && std::get<1>(*prs.begin()).count("X") > 0));
+    auto pr = std::get<0>(*prs.begin());
+    recorder.assert_true(
+      "Mapped attachment of some table columns is mapped",
+      TE(pr.is_mapped()));
+    {
+      const FA<READ_WRITE, unsigned, 1> x(pr, x_fid);
+      for (coord_t i = 0; i < TABLE0_NUM_ROWS; ++i)
+        x[i] = x_plus_10[i];
+    }
+    rt->detach_external_resource(ctx, pr).wait();
+  }
+  {
+    auto prs =
+      attach_some_table_columns(
+        ctx,
+        rt,
+        fname,
+        "/",
+        tb,
+        {"X"},
+        tb_paths,
+        true,
+        true);
+    recorder.assert_true(
+      "Read-only attachment of some table columns is attached",
+      TE(prs.size() == 1));
+    auto pr = std::get<0>(*prs.begin());
+    recorder.expect_true(
+      "Values written to read-write attachment of some table columns are saved",
+      TE(verify_col<1>(ctx, rt, x_plus_10, pr, x_fid, {TABLE0_NUM_ROWS})));
+    rt->detach_external_resource(ctx, pr).wait();
+  }
+  tb.destroy(ctx, rt);
+  CHECK_H5(H5Fclose(fid));
+  CXX_FILESYSTEM_NAMESPACE::remove(fname);
+}
+
+// test attachment of table columns over the ranges of rows selected by the
+// values of an integer column (X, standing in for a column like DATA_DESC_ID)
+void
+attach_rows_tests(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  std::string fname = temporary_file_name();
+  hid_t fid = CHECK_H5(H5DatatypeManager::create(fname, H5F_ACC_TRUNC));
+  write_table0(ctx, rt, fid, fname, "rows", ColumnDatasetOptions());
+
+  // select rows with even X values: rows [0, 2] and [6, 8]
+  auto rows =
+    select_rows(
+      fid,
+      get_table_column_paths(fid, "/rows", {"X"}).at("X"),
+      [](int x) { return x % 2 == 0; },
+      5);
+  recorder.assert_true(
+    "Selected rows are the expected ranges",
+    TE(rows.size() == 2
+       && rows[0] == Rect<1>(0, 2)
+       && rows[1] == Rect<1>(6, 8)));
+
+  recorder.expect_true(
+    "Rows selected in a dataset by file path are the expected ranges",
+    testing::TestEval<std::function<bool()>>(
+      [&]() {
+        CHECK_H5(H5Fflush(fid, H5F_SCOPE_GLOBAL));
+        auto frows =
+          select_rows(
+            CXX_FILESYSTEM_NAMESPACE::path(fname),
+            get_table_column_paths(fid, "/rows", {"X"}).at("X"),
+            [](int x) { return x % 2 == 0; });
+        return frows && frows.value() == rows;
+      }));
+  recorder.expect_false(
+    "Selection of rows in a file that cannot be opened has no value",
+    TE((bool)select_rows(
+         CXX_FILESYSTEM_NAMESPACE::path(fname + ".missing"),
+         "/rows/X",
+         [](int) { return true; })));
+
+  hid_t root_loc = CHECK_H5(H5Gopen(fid, "/", H5P_DEFAULT));
+  auto itb = init_table(ctx, rt, root_loc, "rows");
+  CHECK_H5(H5Gclose(root_loc));
+  auto& tb = std::get<0>(itb);
+  auto& tb_paths = std::get<1>(itb);
+  auto cols = tb.columns();
+
+  auto y_ip_prs =
+    attach_table_columns(
+      ctx,
+      rt,
+      fname,
+      "/",
+      tb,
+      {"Y"},
+      tb_paths,
+      rows,
+      true,
+      true);
+  auto z_ip_prs =
+    attach_table_columns(
+      ctx,
+      rt,
+      fname,
+      "/",
+      tb,
+      {"Z"},
+      tb_paths,
+      rows,
+      true,
+      true);
+  recorder.expect_true(
+    "Attachment over overlapping ranges of rows is rejected",
+    testing::TestEval<std::function<bool()>>(
+      [&]() {
+        try {
+          attach_table_columns(
+            ctx,
+            rt,
+            fname,
+            "/",
+            tb,
+            {"Y"},
+            tb_paths,
+            {Rect<1>(0, 4), Rect<1>(3, 8)},
+            true,
+            true);
+        } catch (const std::invalid_argument&) {
+          return true;
+        }
+        return false;
+      }));
+
+  // structured bindings can't be captured by the lambdas below
+  auto& y_ip = std::get<0>(y_ip_prs);
+  auto& y_prs = std::get<1>(y_ip_prs);
+  auto& z_ip = std::get<0>(z_ip_prs);
+  auto& z_prs = std::get<1>(z_ip_prs);
+  recorder.assert_true(
+    "Columns are attached over every range of selected rows",
+    TE(y_prs.size() == rows.size() && z_prs.size() == rows.size()));
+  recorder.expect_true(
+    "Attached sub-regions span the selected rows",
+    testing::TestEval<std::function<bool()>>(
+      [&]() {
+        bool result = true;
+        for (size_t i = 0; result && i < rows.size(); ++i) {
+          Rect<1> y_rect =
+            rt->get_index_space_domain(
+              std::get<0>(y_prs[i]).get_index_space());
+          Rect<2> z_rect =
+            rt->get_index_space_domain(
+              std::get<0>(z_prs[i]).get_index_space());
+          result =
+            y_rect == rows[i]
+            && z_rect == Rect<2>({rows[i].lo[0], 0}, {rows[i].hi[0], 1});
+        }
+        return result;
+      }));
+  recorder.expect_true(
+    "Attached column values in selected rows are as expected",
+    testing::TestEval<std::function<bool()>>(
+      [&]() {
+        bool result = true;
+        for (size_t i = 0; result && i < rows.size(); ++i) {
+          const FA<READ_ONLY, unsigned, 1>
+            y(std::get<1>(y_prs[i]), cols.at("Y").fid);
+          const FA<READ_ONLY, unsigned, 2>
+            z(std::get<1>(z_prs[i]), cols.at("Z").fid);
+          for (coord_t r = rows[i].lo[0]; result && r <= rows[i].hi[0]; ++r)
+            result =
+              y[r] == table0_y[r]
+              && z[Point<2>(r, 0)] == table0_z[2 * r]
+              && z[Point<2>(r, 1)] == table0_z[2 * r + 1];
+        }
+        return result;
+      }));
+  for (auto& prs : {y_prs, z_prs})
+    for (auto& lr_pr : prs)
+      rt->detach_external_resource(ctx, std::get<1>(lr_pr)).wait();
+  for (auto& ip : {y_ip, z_ip}) {
+    rt->destroy_index_space(ctx, rt->get_index_partition_color_space_name(ip));
+    rt->destroy_index_partition(ctx, ip);
+  }
+  tb.destroy(ctx, rt);
+  CHECK_H5(H5Fclose(fid));
+  CXX_FILESYSTEM_NAMESPACE::remove(fname);
+}
+
+// number of memory mappings of a file in this process
+size_t
+num_file_mappings(const std::string& fname) {
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  size_t result = 0;
+  while (std::getline(maps, line))
+    if (line.find(fname) != std::string::npos)
+      ++result;
+  return result;
+}
+
+// test zero-copy attachment of column datasets in a memory mapped file
+void
+mapped_dataset_tests(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  std::string fname = temporary_file_name();
+  {
+    hid_t fid = CHECK_H5(H5DatatypeManager::create(fname, H5F_ACC_TRUNC));
+    ColumnDatasetOptions chunked;
+    chunked.chunk_rows = 5;
+    write_table0(ctx, rt, fid, fname, "chunked", chunked);
+    write_table0(ctx, rt, fid, fname, "contiguous", ColumnDatasetOptions());
+    CHECK_H5(H5Fclose(fid));
+  }
+  hid_t fid = CHECK_H5(H5Fopen(fname.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT));
+  auto contiguous_paths =
+    get_table_column_paths(fid, "/contiguous", {"X", "Y", "Z"});
+  auto chunked_paths = get_table_column_paths(fid, "/chunked", {"X"});
+
+  hid_t root_loc = CHECK_H5(H5Gopen(fid, "/", H5P_DEFAULT));
+  auto itb = init_table(ctx, rt, root_loc, "contiguous");
+  CHECK_H5(H5Gclose(root_loc));
+  auto& tb = std::get<0>(itb);
+  auto cols = tb.columns();
+  auto& x_col = cols.at("X");
+  auto& z_col = cols.at("Z");
+
+  const Memory local_sysmem =
+    Machine::MemoryQuery(Machine::get_machine())
+    .has_affinity_to(rt->get_executing_processor(ctx))
+    .only_kind(Memory::SYSTEM_MEM)
+    .first();
+  {
+    auto file_map = FileMap::open(fname);
+    recorder.assert_true("File is memory mapped", TE((bool)file_map));
+
+    auto attach =
+      [&](const std::string& path,
+          const LogicalRegion& lr,
+          const Column& col,
+          hyperion::TypeTag dt) {
+        return
+          attach_mapped_dataset(
+            ctx,
+            rt,
+            *file_map,
+            fid,
+            path,
+            lr,
+            lr,
+            col.fid,
+            dt,
+            local_sysmem,
+            true,
+            true);
+      };
+    auto x_pr =
+      attach(
+        contiguous_paths.at("X"),
+        x_col.region,
+        x_col,
+        HYPERION_TYPE_UINT);
+    auto z_pr =
+      attach(
+        contiguous_paths.at("Z"),
+        z_col.region,
+        z_col,
+        HYPERION_TYPE_UINT);
+    recorder.assert_true(
+      "Contiguous datasets are attached without copying",
+      TE((bool)x_pr && (bool)z_pr));
+    recorder.expect_true(
+      "Values of contiguous datasets attached without copying are as expected",
+      testing::TestEval<std::function<bool()>>(
+        [&]() {
+          const FA<READ_ONLY, unsigned, 1> x(x_pr.value(), x_col.fid);
+          const FA<READ_ONLY, unsigned, 2> z(z_pr.value(), z_col.fid);
+          bool result = true;
+          for (coord_t r = 0; result && r < TABLE0_NUM_ROWS; ++r)
+            result =
+              x[r] == table0_x[r]
+              && z[Point<2>(r, 0)] == table0_z[2 * r]
+              && z[Point<2>(r, 1)] == table0_z[2 * r + 1];
+          return result;
+        }));
+    recorder.expect_false(
+      "Chunked dataset is not attached without copying",
+      TE((bool)attach(
+           chunked_paths.at("X"),
+           x_col.region,
+           x_col,
+           HYPERION_TYPE_UINT)));
+    recorder.expect_false(
+      "Dataset with another datatype is not attached without copying",
+      TE((bool)attach(
+           contiguous_paths.at("X"),
+           x_col.region,
+           x_col,
+           HYPERION_TYPE_INT)));
+    {
+      IndexSpace is =
+        rt->create_index_space(ctx, Rect<1>(0, TABLE0_NUM_ROWS - 2));
+      LogicalRegion lr =
+        rt->create_logical_region(ctx, is, x_col.region.get_field_space());
+      recorder.expect_false(
+        "Dataset with another extent is not attached without copying",
+        TE((bool)attach(
+             contiguous_paths.at("X"),
+             lr,
+             x_col,
+             HYPERION_TYPE_UINT)));
+      rt->destroy_logical_region(ctx, lr);
+      rt->destroy_index_space(ctx, is);
+    }
+    rt->detach_external_resource(ctx, x_pr.value()).wait();
+    rt->detach_external_resource(ctx, z_pr.value()).wait();
+  }
+  CHECK_H5(H5Fclose(fid));
+  recorder.expect_true(
+    "File is unmapped when its map is destroyed",
+    TE(num_file_mappings(fname) == 0));
+  {
+    std::unordered_map<std::string, std::tuple<bool, bool, bool>> modes;
+    for (auto& nm_pth : contiguous_paths)
+      modes[std::get<0>(nm_pth)] = {true, true, true};
+    auto pt =
+      tb.attach_columns(
+        ctx,
+        rt,
+        fname,
+        contiguous_paths,
+        modes,
+        CXX_OPTIONAL_NAMESPACE::nullopt,
+        true);
+    recorder.expect_true(
+      "File is mapped by zero-copy attachment of table columns",
+      TE(num_file_mappings(fname) > 0));
+    recorder.expect_true(
+      "Values of table column attached without copying are as expected",
+      testing::TestEval<std::function<bool()>>(
+        [&]() {
+          const FA<READ_ONLY, unsigned, 1>
+            x(pt.column("X").value()->values().value(), x_col.fid);
+          bool result = true;
+          for (coord_t r = 0; result && r < TABLE0_NUM_ROWS; ++r)
+            result = x[r] == table0_x[r];
+          return result;
+        }));
+    pt.detach_columns(ctx, rt, {"X", "Y", "Z"});
+    recorder.expect_true(
+      "File is unmapped by detachment of zero-copy table columns",
+      TE(num_file_mappings(fname) == 0));
+  }
+  tb.destroy(ctx, rt);
+  CXX_FILESYSTEM_NAMESPACE::remove(fname);
+}
+
 void
 hdf5_test_suite(
   const Task* task,
@@ -738,6 +1520,10 @@ hdf5_test_suite(
 
   tree_tests(recorder);
   table_tests(ctx, runtime, save_output_file, recorder);
+  chunked_table_tests(ctx, runtime, recorder);
+  attach_selected_columns_tests(ctx, runtime, recorder);
+  attach_rows_tests(ctx, runtime, recorder);
+  mapped_dataset_tests(ctx, runtime, recorder);
 }
 
 int
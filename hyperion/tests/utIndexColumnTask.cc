@@ -16,17 +16,19 @@
 #include <hyperion/testing/TestSuiteDriver.h>
 #include <hyperion/testing/TestRecorder.h>
 
-#include <memory>
-#include <ostream>
-#include <vector>
-
 #include <hyperion/utility.h>
 #include <hyperion/Table.h>
 #include <hyperion/Column.h>
+#include <hyperion/ColumnSpace.h>
 
-#ifdef HYPERION_USE_CASACORE
-# include <hyperion/MeasRef.h>
-#endif
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <tuple>
+#include <vector>
 
 using namespace hyperion;
 using namespace Legion;
@@ -36,35 +38,35 @@ enum {
 };
 
 enum struct Table0Axes {
-  ROW = 0,
-  X,
-  Y
+  ROW = 0
+};
+
+enum {
+  COL_X,
+  COL_Y,
+  COL_S
 };
 
 template <>
 struct hyperion::Axes<Table0Axes> {
   static const constexpr char* uid = "Table0Axes";
   static const std::vector<std::string> names;
-  static const unsigned num_axes = 3;
+  static const unsigned num_axes = 1;
 #ifdef HYPERION_USE_HDF5
   static const hid_t h5_datatype;
 #endif
 };
 
 const std::vector<std::string>
-hyperion::Axes<Table0Axes>::names{"ROW", "X", "Y"};
+hyperion::Axes<Table0Axes>::names{"ROW"};
 
 #ifdef HYPERION_USE_HDF5
 hid_t
 h5_dt() {
   hid_t result = H5Tenum_create(H5T_NATIVE_UCHAR);
   Table0Axes a = Table0Axes::ROW;
-  herr_t err = H5Tenum_insert(result, "ROW", &a);
+  [[maybe_unused]] herr_t err = H5Tenum_insert(result, "ROW", &a);
   assert(err >= 0);
-  a = Table0Axes::X;
-  err = H5Tenum_insert(result, "X", &a);
-  a = Table0Axes::Y;
-  err = H5Tenum_insert(result, "Y", &a);
   return result;
 }
 
@@ -72,22 +74,6 @@ const hid_t
 hyperion::Axes<Table0Axes>::h5_datatype = h5_dt();
 #endif
 
-std::ostream&
-operator<<(std::ostream& stream, const Table0Axes& ax) {
-  switch (ax) {
-  case Table0Axes::ROW:
-    stream << "Table0Axes::ROW";
-    break;
-  case Table0Axes::X:
-    stream << "Table0Axes::X";
-    break;
-  case Table0Axes::Y:
-    stream << "Table0Axes::Y";
-    break;
-  }
-  return stream;
-}
-
 #define TABLE0_NUM_X 4
 #define OX 22
 #define TABLE0_NUM_Y 3
@@ -103,51 +89,412 @@ unsigned table0_y[TABLE0_NUM_ROWS] {
                      OY + 0, OY + 1, OY + 2,
                      OY + 0, OY + 1, OY + 2,
                      OY + 0, OY + 1, OY + 2};
-
-Column::Generator
-table0_col(const std::string& name) {
-  return
-    [=](Context ctx, Runtime* rt, const std::string& name_prefix) {
-      return
-        Column::create(
-          ctx,
-          rt,
-          name,
-          std::vector<Table0Axes>{Table0Axes::ROW},
-          ValueType<unsigned>::DataType,
-          IndexTreeL(TABLE0_NUM_ROWS),
-#ifdef HYPERION_USE_CASACORE
-          MeasRef(),
-          std::nullopt,
-#endif
-          {},
-          name_prefix);
-    };
-}
+hyperion::string table0_s[TABLE0_NUM_ROWS] {
+                   "b", "b", "a",
+                     "c", "a", "a",
+                     "a", "b", "b",
+                     "c", "c", "b"};
 
 PhysicalRegion
-attach_table0_col(
-  Context context,
-  Runtime* runtime,
-  const Column& col,
-  unsigned *base) {
+attach_table0_col(Context ctx, Runtime* rt, const Column& col, void *base) {
 
   const Memory local_sysmem =
     Machine::MemoryQuery(Machine::get_machine())
-    .has_affinity_to(runtime->get_executing_processor(context))
+    .has_affinity_to(rt->get_executing_processor(ctx))
     .only_kind(Memory::SYSTEM_MEM)
     .first();
 
-  AttachLauncher task(EXTERNAL_INSTANCE, col.values_lr, col.values_lr);
-  task.attach_array_soa(
-    base,
-    true,
-    {Column::VALUE_FID},
-    local_sysmem);
-  return runtime->attach_external_resource(context, task);
+  AttachLauncher task(EXTERNAL_INSTANCE, col.region, col.region);
+  task.attach_array_soa(base, false, {col.fid}, local_sysmem);
+  PhysicalRegion result = rt->attach_external_resource(ctx, task);
+  AcquireLauncher acq(col.region, col.region, result);
+  acq.add_field(col.fid);
+  rt->issue_acquire(ctx, acq);
+  return result;
 }
 
+#if HAVE_CXX17
 #define TE(f) testing::TestEval([&](){ return f; }, #f)
+#else
+#define TE(f) testing::TestEval<std::function<bool()>>([&](){ return f; }, #f)
+#endif
+
+std::vector<DomainPoint>
+rows(std::initializer_list<coord_t> rs) {
+  std::vector<DomainPoint> result;
+  for (auto& r : rs)
+    result.push_back(Point<1>(r));
+  return result;
+}
+
+std::vector<row_run>
+runs(std::initializer_list<std::tuple<coord_t, coord_t>> rs) {
+  std::vector<row_run> result;
+  for (auto& r : rs)
+    result.push_back(
+      row_run{Point<1>(std::get<0>(r)), Point<1>(std::get<1>(r))});
+  return result;
+}
+
+bool
+same_runs(const std::vector<row_run>& a, const std::vector<row_run>& b) {
+  return
+    std::equal(
+      a.begin(),
+      a.end(),
+      b.begin(),
+      b.end(),
+      [](const row_run& ra, const row_run& rb) {
+        return ra.lo == rb.lo && ra.hi == rb.hi;
+      });
+}
+
+template <typename T>
+bool
+has_index(
+  const column_index_block<T>& cib,
+  const std::vector<T>& values,
+  const std::vector<std::vector<DomainPoint>>& points) {
+
+  bool result =
+    cib.values == values
+    && cib.offsets.size() == values.size() + 1
+    && cib.offsets[0] == 0;
+  for (size_t i = 0; result && i < values.size(); ++i)
+    result =
+      std::vector<DomainPoint>(
+        cib.points.begin() + cib.offsets[i],
+        cib.points.begin() + cib.offsets[i + 1])
+      == points[i];
+  return result && cib.offsets.back() == cib.points.size();
+}
+
+template <typename T>
+column_index_block<T>
+serdez_round_trip(const column_index_block<T>& cib) {
+  std::vector<char> buffer(cib.legion_buffer_size());
+  cib.legion_serialize(buffer.data());
+  column_index_block<T> result;
+  result.legion_deserialize(buffer.data());
+  return result;
+}
+
+void
+column_index_block_tests(testing::TestRecorder<READ_WRITE>& recorder) {
+
+  typedef column_index_block<unsigned> cib_t;
+  typedef std::vector<std::tuple<unsigned, DomainPoint>> pairs_t;
+
+  {
+    // values are in arbitrary order, and points of equal values are
+    // increasing in the input
+    auto cib =
+      cib_t::from_pairs(
+        pairs_t{
+          {3, Point<1>(0)},
+          {1, Point<1>(1)},
+          {3, Point<1>(2)},
+          {2, Point<1>(3)},
+          {1, Point<1>(4)},
+          {3, Point<1>(5)}});
+    recorder.expect_true(
+      "Block index of values has sorted values and rows",
+      TE(has_index<unsigned>(
+           cib,
+           {1, 2, 3},
+           {rows({1, 4}), rows({3}), rows({0, 2, 5})})));
+    recorder.expect_true(
+      "Block index has expected serdez round trip",
+      TE(has_index<unsigned>(
+           serdez_round_trip(cib),
+           {1, 2, 3},
+           {rows({1, 4}), rows({3}), rows({0, 2, 5})})));
+  }
+  {
+    // the row order of equal values is preserved by from_pairs(), even when
+    // the rows are not increasing
+    auto cib =
+      cib_t::from_pairs(
+        pairs_t{
+          {7, Point<1>(5)},
+          {4, Point<1>(9)},
+          {7, Point<1>(1)},
+          {7, Point<1>(3)},
+          {4, Point<1>(2)}});
+    recorder.expect_true(
+      "Block index retains row order of equal values",
+      TE(has_index<unsigned>(
+           cib,
+           {4, 7},
+           {rows({9, 2}), rows({5, 1, 3})})));
+  }
+  {
+    auto cib = cib_t::from_pairs(pairs_t{});
+    recorder.expect_true(
+      "Index of empty block is empty",
+      TE(cib.size() == 0 && has_index<unsigned>(cib, {}, {})));
+    recorder.expect_true(
+      "Empty block index has expected serdez round trip",
+      TE(serdez_round_trip(cib).size() == 0));
+  }
+  {
+    // values occurring in more than one block
+    auto b0 =
+      cib_t::from_pairs(
+        pairs_t{{1, Point<1>(0)}, {2, Point<1>(1)}, {1, Point<1>(2)}});
+    auto b1 =
+      cib_t::from_pairs(
+        pairs_t{{3, Point<1>(3)}, {1, Point<1>(4)}, {2, Point<1>(5)}});
+    auto b2 =
+      cib_t::from_pairs(
+        pairs_t{{2, Point<1>(6)}, {1, Point<1>(7)}, {1, Point<1>(8)}});
+    recorder.expect_true(
+      "Merged block indexes have rows of values in all blocks",
+      TE(has_index<unsigned>(
+           cib_t::merge(b0, b1),
+           {1, 2, 3},
+           {rows({0, 2, 4}), rows({1, 5}), rows({3})})));
+    recorder.expect_true(
+      "Merge of block indexes is symmetric",
+      TE(has_index<unsigned>(
+           cib_t::merge(b1, b0),
+           {1, 2, 3},
+           {rows({0, 2, 4}), rows({1, 5}), rows({3})})));
+    recorder.expect_true(
+      "Merge of block index with itself is idempotent",
+      TE(has_index<unsigned>(
+           cib_t::merge(b0, b0),
+           {1, 2},
+           {rows({0, 2}), rows({1})})));
+    recorder.expect_true(
+      "Merge of block index with empty block index is unchanged",
+      TE(has_index<unsigned>(
+           cib_t::merge(cib_t(), b1),
+           {1, 2, 3},
+           {rows({4}), rows({5}), rows({3})})
+         && has_index<unsigned>(
+           cib_t::merge(b1, cib_t::from_pairs(pairs_t{})),
+           {1, 2, 3},
+           {rows({4}), rows({5}), rows({3})})));
+    recorder.expect_true(
+      "Merge of many block indexes, including empty blocks, has all rows",
+      TE(has_index<unsigned>(
+           cib_t::merge(
+             std::vector<cib_t>{
+               cib_t(),
+               b2,
+               b0,
+               cib_t::from_pairs(pairs_t{}),
+               b1}),
+           {1, 2, 3},
+           {rows({0, 2, 4, 7, 8}), rows({1, 5, 6}), rows({3})})));
+    recorder.expect_true(
+      "Merge of no block indexes is empty",
+      TE(cib_t::merge(std::vector<cib_t>{}).size() == 0));
+  }
+  {
+    // string values
+    typedef column_index_block<hyperion::string> scib_t;
+    typedef std::vector<std::tuple<hyperion::string, DomainPoint>> spairs_t;
+    auto b0 =
+      scib_t::from_pairs(
+        spairs_t{
+          {"foo", Point<1>(0)},
+          {"bar", Point<1>(1)},
+          {"foo", Point<1>(2)}});
+    auto b1 =
+      scib_t::from_pairs(
+        spairs_t{{"baz", Point<1>(3)}, {"bar", Point<1>(4)}});
+    auto cib = scib_t::merge(std::vector<scib_t>{b0, scib_t(), b1});
+    recorder.expect_true(
+      "Merged block indexes of string values have expected values and rows",
+      TE(has_index<hyperion::string>(
+           cib,
+           {"bar", "baz", "foo"},
+           {rows({1, 4}), rows({3}), rows({0, 2})})));
+    recorder.expect_true(
+      "Block index of string values has expected serdez round trip",
+      TE(has_index<hyperion::string>(
+           serdez_round_trip(cib),
+           {"bar", "baz", "foo"},
+           {rows({1, 4}), rows({3}), rows({0, 2})})));
+  }
+}
+
+std::vector<row_run>
+runs2(
+  std::initializer_list<
+    std::tuple<std::array<coord_t, 2>, std::array<coord_t, 2>>> rs) {
+  std::vector<row_run> result;
+  for (auto& r : rs) {
+    auto& lo = std::get<0>(r);
+    auto& hi = std::get<1>(r);
+    result.push_back(
+      row_run{Point<2>(lo[0], lo[1]), Point<2>(hi[0], hi[1])});
+  }
+  return result;
+}
+
+std::vector<row_run>
+from_points(const std::vector<DomainPoint>& pts) {
+  std::vector<row_run> result;
+  row_run::from_points(pts.begin(), pts.end(), std::back_inserter(result));
+  return result;
+}
+
+std::vector<row_run>
+serdez_round_trip(const std::vector<row_run>& rs) {
+  typedef vector_serdez<row_run> serdez_t;
+  std::vector<char> buffer(serdez_t::serialized_size(rs));
+  size_t sz = serdez_t::serialize(rs, buffer.data());
+  assert(sz == buffer.size());
+  serdez_t::FIELD_TYPE result;
+  serdez_t::deserialize(result, buffer.data());
+  return result;
+}
+
+void
+row_run_tests(testing::TestRecorder<READ_WRITE>& recorder) {
+
+  recorder.expect_true(
+    "Runs of no points are empty",
+    TE(from_points({}).size() == 0));
+  recorder.expect_true(
+    "Runs of single point is a run of one point",
+    TE(same_runs(from_points(rows({4})), runs({{4, 4}}))));
+  recorder.expect_true(
+    "Adjacent and non-adjacent points are merged into maximal runs",
+    TE(same_runs(
+         from_points(rows({0, 1, 2, 4, 5, 9, 11, 12})),
+         runs({{0, 2}, {4, 5}, {9, 9}, {11, 12}}))));
+  recorder.expect_true(
+    "Runs of points only extend along the last coordinate",
+    TE(same_runs(
+         from_points(
+           {Point<2>(0, 0), Point<2>(0, 1), Point<2>(1, 2), Point<2>(1, 3),
+            Point<2>(2, 0), Point<2>(3, 0)}),
+         runs2({{{0, 0}, {0, 1}},
+                {{1, 2}, {1, 3}},
+                {{2, 0}, {2, 0}},
+                {{3, 0}, {3, 0}}}))));
+  recorder.expect_true(
+    "Run has expected size",
+    TE(runs({{3, 7}})[0].size() == 5
+       && runs2({{{1, 2}, {1, 3}}})[0].size() == 2));
+
+  recorder.expect_true(
+    "Intersection of overlapping runs is their overlap",
+    TE(same_runs(
+         row_run::intersection(runs({{0, 5}}), runs({{3, 8}})),
+         runs({{3, 5}}))
+       && same_runs(
+         row_run::intersection(runs({{3, 8}}), runs({{0, 5}})),
+         runs({{3, 5}}))));
+  recorder.expect_true(
+    "Intersection of nested runs is the inner runs",
+    TE(same_runs(
+         row_run::intersection(runs({{0, 10}}), runs({{2, 4}, {6, 7}})),
+         runs({{2, 4}, {6, 7}}))
+       && same_runs(
+         row_run::intersection(runs({{2, 4}, {6, 7}}), runs({{0, 10}})),
+         runs({{2, 4}, {6, 7}}))));
+  recorder.expect_true(
+    "Intersection of disjoint runs is empty",
+    TE(row_run::intersection(runs({{0, 2}, {6, 8}}), runs({{3, 5}})).size()
+       == 0
+       && row_run::intersection(runs({{0, 2}}), runs({{3, 4}})).size() == 0
+       && row_run::intersection(runs({{0, 2}}), {}).size() == 0));
+  recorder.expect_true(
+    "Intersection of run lists has a run for every overlap",
+    TE(same_runs(
+         row_run::intersection(
+           runs({{0, 3}, {5, 9}, {12, 12}}),
+           runs({{2, 6}, {8, 12}})),
+         runs({{2, 3}, {5, 6}, {8, 9}, {12, 12}}))));
+  recorder.expect_true(
+    "Intersection of runs differing in leading coordinates is empty",
+    TE(row_run::intersection(
+         runs2({{{0, 0}, {0, 5}}}),
+         runs2({{{1, 0}, {1, 5}}})).size() == 0
+       && same_runs(
+         row_run::intersection(
+           runs2({{{0, 2}, {0, 5}}, {{1, 0}, {1, 5}}}),
+           runs2({{{0, 4}, {0, 9}}, {{1, 3}, {1, 3}}})),
+         runs2({{{0, 4}, {0, 5}}, {{1, 3}, {1, 3}}}))));
+
+  recorder.expect_true(
+    "Row runs have expected serdez round trip",
+    TE(same_runs(
+         serdez_round_trip(runs({{0, 2}, {4, 5}, {9, 9}})),
+         runs({{0, 2}, {4, 5}, {9, 9}}))
+       && same_runs(
+         serdez_round_trip(runs2({{{0, 1}, {0, 3}}, {{2, 0}, {2, 0}}})),
+         runs2({{{0, 1}, {0, 3}}, {{2, 0}, {2, 0}}}))
+       && serdez_round_trip({}).size() == 0));
+}
+
+template <typename T>
+bool
+has_column_index(
+  Context ctx,
+  Runtime* rt,
+  LogicalRegion lr,
+  const std::vector<T>& values,
+  const std::vector<std::vector<row_run>>& rows) {
+
+  if (lr == LogicalRegion::NO_REGION)
+    return false;
+  Rect<1> bounds =
+    rt->get_index_space_domain(lr.get_index_space()).bounds<1, coord_t>();
+  if (bounds != Rect<1>(0, static_cast<coord_t>(values.size()) - 1))
+    return false;
+  RegionRequirement req(lr, READ_ONLY, EXCLUSIVE, lr);
+  req.add_field(Column::COLUMN_INDEX_VALUE_FID);
+  req.add_field(Column::COLUMN_INDEX_ROWS_FID);
+  PhysicalRegion pr = rt->map_region(ctx, req);
+  const FieldAccessor<
+    READ_ONLY, T, 1, coord_t, AffineAccessor<T, 1, coord_t>, true>
+    vs(pr, Column::COLUMN_INDEX_VALUE_FID);
+  const FieldAccessor<
+    READ_ONLY,
+    Column::COLUMN_INDEX_ROWS_TYPE,
+    1,
+    coord_t,
+    AffineAccessor<Column::COLUMN_INDEX_ROWS_TYPE, 1, coord_t>,
+    true> rs(pr, Column::COLUMN_INDEX_ROWS_FID);
+  bool result = true;
+  for (size_t i = 0; result && i < values.size(); ++i)
+    result = vs[i] == values[i] && same_runs(rs[i], rows[i]);
+  rt->unmap_region(ctx, pr);
+  return result;
+}
+
+void
+destroy_column_index(Context ctx, Runtime* rt, LogicalRegion lr) {
+  auto is = lr.get_index_space();
+  auto fs = lr.get_field_space();
+  rt->destroy_logical_region(ctx, lr);
+  rt->destroy_field_space(ctx, fs);
+  rt->destroy_index_space(ctx, is);
+}
+
+// copy a column index region, which moves the row runs field through its
+// serdez
+LogicalRegion
+copy_column_index(Context ctx, Runtime* rt, LogicalRegion lr) {
+  LogicalRegion result =
+    rt->create_logical_region(ctx, lr.get_index_space(), lr.get_field_space());
+  CopyLauncher copy;
+  RegionRequirement src(lr, READ_ONLY, EXCLUSIVE, lr);
+  src.add_field(Column::COLUMN_INDEX_VALUE_FID);
+  src.add_field(Column::COLUMN_INDEX_ROWS_FID);
+  RegionRequirement dst(result, WRITE_DISCARD, EXCLUSIVE, result);
+  dst.add_field(Column::COLUMN_INDEX_VALUE_FID);
+  dst.add_field(Column::COLUMN_INDEX_ROWS_FID);
+  copy.add_copy_requirements(src, dst);
+  rt->issue_copy_operation(ctx, copy);
+  return result;
+}
 
 void
 index_column_task_test_suite(
@@ -156,8 +503,8 @@ index_column_task_test_suite(
   Context ctx,
   Runtime* rt) {
 
-  testing::TestRecorder<WRITE_DISCARD> recorder(
-    testing::TestLog<WRITE_DISCARD>(
+  testing::TestRecorder<READ_WRITE> recorder(
+    testing::TestLog<READ_WRITE>(
       task->regions[0].region,
       regions[0],
       task->regions[1].region,
@@ -165,140 +512,88 @@ index_column_task_test_suite(
       ctx,
       rt));
 
-  Table table0 =
-    Table::create(
+  column_index_block_tests(recorder);
+  row_run_tests(recorder);
+
+  auto is = rt->create_index_space(ctx, Rect<1>(0, TABLE0_NUM_ROWS - 1));
+  auto cs =
+    ColumnSpace::create(
       ctx,
       rt,
-      "table0",
       std::vector<Table0Axes>{Table0Axes::ROW},
-      std::vector<Column::Generator>{
-        table0_col("X"),
-        table0_col("Y")});
-  auto col_x =
-    attach_table0_col(ctx, rt, table0.column(ctx, rt, "X"), table0_x);
-  auto col_y =
-    attach_table0_col(ctx, rt, table0.column(ctx, rt, "Y"), table0_y);
-  IndexColumnTask icx(table0.column(ctx, rt, "X"));
-  IndexColumnTask icy(table0.column(ctx, rt, "Y"));
-  Future fx = icx.dispatch(ctx, rt);
-  Future fy = icy.dispatch(ctx, rt);
+      is,
+      false);
+  std::vector<std::pair<std::string, TableField>> fields{
+    {"X", TableField(HYPERION_TYPE_UINT, COL_X)},
+    {"Y", TableField(HYPERION_TYPE_UINT, COL_Y)},
+    {"S", TableField(HYPERION_TYPE_STRING, COL_S)}
+  };
+  auto table0 = Table::create(ctx, rt, cs, {{cs, fields}});
+  auto cols = table0.columns();
+  std::vector<PhysicalRegion> col_prs{
+    attach_table0_col(ctx, rt, cols.at("X"), table0_x),
+    attach_table0_col(ctx, rt, cols.at("Y"), table0_y),
+    attach_table0_col(ctx, rt, cols.at("S"), table0_s)
+  };
 
   {
-    auto cx = fx.get_result<LogicalRegion>();
-    recorder.assert_false(
-      "IndexColumnTask X result is not empty",
-      TE(cx == LogicalRegion::NO_REGION));
-    recorder.assert_true(
-      "IndexColumnTask X result has one-dimensional IndexSpace",
-      TE(cx.get_index_space().get_dim()) == 1);
-    Domain xd = rt->get_index_space_domain(cx.get_index_space());
-    recorder.expect_true(
-      "IndexColumnTask X result IndexSpace has expected range",
-      TE(xd.lo()[0] == 0) && (TE(xd.hi()[0]) == TABLE0_NUM_X - 1));
-    recorder.expect_true(
-      "IndexColumnTask X result has expected values",
-      testing::TestEval(
-        [&ctx, rt, &cx]() {
-          RegionRequirement req(cx, READ_ONLY, EXCLUSIVE, cx);
-          req.add_field(IndexColumnTask::VALUE_FID);
-          PhysicalRegion pr = rt->map_region(ctx, req);
-          const FieldAccessor<
-            READ_ONLY, unsigned, 1, coord_t,
-            AffineAccessor<unsigned, 1, coord_t>, true>
-            x(pr, IndexColumnTask::VALUE_FID);
-          bool result =
-            x[0] == OX && x[1] == OX + 1 && x[2] == OX + 2 && x[3] == OX + 3;
-          rt->unmap_region(ctx, pr);
-          return result;
-        }));
+    auto lr = cols.at("X").create_index(ctx, rt);
     recorder.expect_true(
-      "IndexColumnTask X result has expected index groups",
-      testing::TestEval(
-        [&ctx, rt, &cx]() {
-          RegionRequirement req(cx, READ_ONLY, EXCLUSIVE, cx);
-          req.add_field(IndexColumnTask::ROWS_FID);
-          PhysicalRegion pr = rt->map_region(ctx, req);
-          const FieldAccessor<
-            READ_ONLY, std::vector<DomainPoint>, 1, coord_t,
-            AffineAccessor<std::vector<DomainPoint>, 1, coord_t>, true>
-            x(pr, IndexColumnTask::ROWS_FID);
-          bool result =
-            (x[0] ==
-             std::vector<DomainPoint>{Point<1>(0), Point<1>(1), Point<1>(2)})
-            && (x[1] ==
-                std::vector<DomainPoint>{Point<1>(3), Point<1>(4), Point<1>(5)})
-            && (x[2] ==
-                std::vector<DomainPoint>{Point<1>(6), Point<1>(7), Point<1>(8)})
-            && (x[3] ==
-                std::vector<DomainPoint>{Point<1>(9), Point<1>(10), Point<1>(11)});
-          rt->unmap_region(ctx, pr);
-          return result;
-        }));
-    auto is = cx.get_index_space();
-    auto fs = cx.get_field_space();
-    rt->destroy_logical_region(ctx, cx);
-    rt->destroy_field_space(ctx, fs);
-    rt->destroy_index_space(ctx, is);
+      "Index of column X has expected values and row runs",
+      TE(has_column_index<unsigned>(
+           ctx,
+           rt,
+           lr,
+           {OX + 0, OX + 1, OX + 2, OX + 3},
+           {runs({{0, 2}}), runs({{3, 5}}), runs({{6, 8}}), runs({{9, 11}})})));
+    if (lr != LogicalRegion::NO_REGION)
+      destroy_column_index(ctx, rt, lr);
   }
   {
-    auto cy = fy.get_result<LogicalRegion>();
-    recorder.assert_false(
-      "IndexColumnTask Y result is not empty",
-      TE(cy == LogicalRegion::NO_REGION));
-    recorder.assert_true(
-      "IndexColumnTask Y result has one-dimensional IndexSpace",
-      TE(cy.get_index_space().get_dim()) == 1);
-    Domain yd = rt->get_index_space_domain(cy.get_index_space());
+    auto lr = cols.at("Y").create_index(ctx, rt);
     recorder.expect_true(
-      "IndexColumnTask Y result IndexSpace has expected range",
-      TE(yd.lo()[0] == 0) && (TE(yd.hi()[0]) == TABLE0_NUM_Y - 1));
-    recorder.expect_true(
-      "IndexColumnTask Y result has expected values",
-      testing::TestEval(
-        [&ctx, rt, &cy]() {
-          RegionRequirement req(cy, READ_ONLY, EXCLUSIVE, cy);
-          req.add_field(IndexColumnTask::VALUE_FID);
-          PhysicalRegion pr = rt->map_region(ctx, req);
-          const FieldAccessor<
-            READ_ONLY, unsigned, 1, coord_t,
-            AffineAccessor<unsigned, 1, coord_t>, true>
-            y(pr, IndexColumnTask::VALUE_FID);
-          bool result = y[0] == OY && y[1] == OY + 1 && y[2] == OY + 2;
-          rt->unmap_region(ctx, pr);
-          return result;
-        }));
+      "Index of column Y has expected values and row runs",
+      TE(has_column_index<unsigned>(
+           ctx,
+           rt,
+           lr,
+           {OY + 0, OY + 1, OY + 2},
+           {runs({{0, 0}, {3, 3}, {6, 6}, {9, 9}}),
+            runs({{1, 1}, {4, 4}, {7, 7}, {10, 10}}),
+            runs({{2, 2}, {5, 5}, {8, 8}, {11, 11}})})));
+    if (lr != LogicalRegion::NO_REGION)
+      destroy_column_index(ctx, rt, lr);
+  }
+  {
+    auto lr = cols.at("S").create_index(ctx, rt);
     recorder.expect_true(
-      "IndexColumnTask Y result has expected index groups",
-      testing::TestEval(
-        [&ctx, rt, &cy]() {
-          RegionRequirement req(cy, READ_ONLY, EXCLUSIVE, cy);
-          req.add_field(IndexColumnTask::ROWS_FID);
-          PhysicalRegion pr = rt->map_region(ctx, req);
-          const FieldAccessor<
-            READ_ONLY, std::vector<DomainPoint>, 1, coord_t,
-            AffineAccessor<std::vector<DomainPoint>, 1, coord_t>, true>
-            y(pr, IndexColumnTask::ROWS_FID);
-          bool result =
-            (y[0] ==
-             std::vector<DomainPoint>{
-              Point<1>(0), Point<1>(3), Point<1>(6), Point<1>(9)})
-            && (y[1] ==
-                std::vector<DomainPoint>{
-                  Point<1>(1), Point<1>(4), Point<1>(7), Point<1>(10)})
-            && (y[2] ==
-                std::vector<DomainPoint>{
-                  Point<1>(2), Point<1>(5), Point<1>(8), Point<1>(11)});
-          rt->unmap_region(ctx, pr);
-          return result;
-        }));
-    auto is = cy.get_index_space();
-    auto fs = cy.get_field_space();
-    rt->destroy_logical_region(ctx, cy);
-    rt->destroy_field_space(ctx, fs);
-    rt->destroy_index_space(ctx, is);
+      "Index of string column S has expected values and row runs",
+      TE(has_column_index<hyperion::string>(
+           ctx,
+           rt,
+           lr,
+           {"a", "b", "c"},
+           {runs({{2, 2}, {4, 6}}),
+            runs({{0, 1}, {7, 8}, {11, 11}}),
+            runs({{3, 3}, {9, 10}})})));
+    if (lr != LogicalRegion::NO_REGION) {
+      auto cp = copy_column_index(ctx, rt, lr);
+      recorder.expect_true(
+        "Copy of index of string column S has expected values and row runs",
+        TE(has_column_index<hyperion::string>(
+             ctx,
+             rt,
+             cp,
+             {"a", "b", "c"},
+             {runs({{2, 2}, {4, 6}}),
+              runs({{0, 1}, {7, 8}, {11, 11}}),
+              runs({{3, 3}, {9, 10}})})));
+      rt->destroy_logical_region(ctx, cp);
+      destroy_column_index(ctx, rt, lr);
+    }
   }
-  rt->detach_external_resource(ctx, col_x);
-  rt->detach_external_resource(ctx, col_y);
+  for (auto& pr : col_prs)
+    rt->detach_external_resource(ctx, pr);
   table0.destroy(ctx, rt);
 }
 
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2020 Associated Universities, Inc. Washington DC, USA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <hyperion/testing/TestSuiteDriver.h>
+#include <hyperion/testing/TestRecorder.h>
+
+#include <hyperion/hyperion.h>
+#include <hyperion/Instrumentation.h>
+
+#include <chrono>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hyperion;
+using namespace Legion;
+
+enum {
+  INSTRUMENTATION_TEST_SUITE,
+  INSTRUMENTED_TASK
+};
+
+static const char* instrumented_task_name = "instrumented_task";
+
+static const std::size_t instrumented_bytes = 4096;
+
+static const std::size_t instrumented_rows = 16;
+
+#if HAVE_CXX17
+#define TE(f) testing::TestEval([&](){ return f; }, #f)
+#else
+#define TE(f) testing::TestEval<std::function<bool()>>([&](){ return f; }, #f)
+#endif
+
+bool
+instrumented_task(
+  const Task* task,
+  const std::vector<PhysicalRegion>&,
+  Context,
+  Runtime*) {
+
+  Instrumentation::Scope scope(task);
+  scope.add_bytes(instrumented_bytes);
+  scope.add_rows(instrumented_rows);
+  // ensure a measurable execution time
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return scope.active();
+}
+
+// fields of the summary line of the instrumented task, or an empty vector if
+// there is no such line
+static std::vector<std::string>
+summary_fields() {
+  std::ostringstream oss;
+  Instrumentation::dump(oss);
+  std::istringstream iss(oss.str());
+  const std::string prefix = std::string("\"") + instrumented_task_name + "\",";
+  std::vector<std::string> result;
+  std::string line;
+  while (result.empty() && std::getline(iss, line)) {
+    if (line.compare(0, prefix.size(), prefix) == 0) {
+      std::istringstream fields(line);
+      std::string field;
+      while (std::getline(fields, field, ','))
+        result.push_back(field);
+    }
+  }
+  return result;
+}
+
+enum {
+  SUMMARY_NAME,
+  SUMMARY_PROCESSOR,
+  SUMMARY_COUNT,
+  SUMMARY_SECONDS,
+  SUMMARY_MEAN_MS,
+  SUMMARY_BYTES,
+  SUMMARY_GB_PER_S,
+  SUMMARY_ROWS,
+  SUMMARY_NUM_FIELDS
+};
+
+void
+instrumentation_test_suite(
+  const Task* task,
+  const std::vector<PhysicalRegion>& regions,
+  Context ctx,
+  Runtime* rt) {
+
+  testing::TestRecorder<READ_WRITE> recorder(
+    testing::TestLog<READ_WRITE>(
+      task->regions[0].region,
+      regions[0],
+      task->regions[1].region,
+      regions[1],
+      ctx,
+      rt));
+
+  TaskLauncher instrumented(INSTRUMENTED_TASK, TaskArgument(NULL, 0));
+
+  // enabled instrumentation
+  {
+    Instrumentation::enable();
+    Instrumentation::reset();
+    bool active = rt->execute_task(ctx, instrumented).get_result<bool>();
+    recorder.expect_true(
+      "Scope is active when instrumentation is enabled",
+      TE(active));
+    auto fields = summary_fields();
+    recorder.assert_true(
+      "Summary includes instrumented task",
+      TE(fields.size() == SUMMARY_NUM_FIELDS));
+    recorder.expect_true(
+      "Instrumented task count is one",
+      TE(std::stoull(fields[SUMMARY_COUNT]) == 1));
+    recorder.expect_true(
+      "Instrumented task time is non-zero",
+      TE(std::stod(fields[SUMMARY_SECONDS]) > 0.0));
+    recorder.expect_true(
+      "Instrumented task bytes are accumulated",
+      TE(std::stoull(fields[SUMMARY_BYTES]) == instrumented_bytes));
+    recorder.expect_true(
+      "Instrumented task rows are accumulated",
+      TE(std::stoull(fields[SUMMARY_ROWS]) == instrumented_rows));
+  }
+
+  // disabled instrumentation
+  {
+    Instrumentation::reset();
+    Instrumentation::enable(false);
+    bool active = rt->execute_task(ctx, instrumented).get_result<bool>();
+    recorder.expect_false(
+      "Scope is inactive when instrumentation is disabled",
+      TE(active));
+    recorder.expect_true(
+      "Counters are zero when instrumentation is disabled",
+      TE(summary_fields().empty()));
+  }
+}
+
+int
+main(int argc, char** argv) {
+
+  testing::TestSuiteDriver driver =
+    testing::TestSuiteDriver::make<instrumentation_test_suite>(
+      INSTRUMENTATION_TEST_SUITE,
+      "instrumentation_test_suite");
+
+  {
+    TaskVariantRegistrar registrar(INSTRUMENTED_TASK, instrumented_task_name);
+    registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
+    registrar.set_leaf();
+    Runtime::preregister_task_variant<bool, instrumented_task>(
+      registrar,
+      instrumented_task_name);
+    Instrumentation::register_task(INSTRUMENTED_TASK, instrumented_task_name);
+  }
+
+  return driver.start(argc, argv);
+}
+
+// Local Variables:
+// mode: c++
+// c-basic-offset: 2
+// fill-column: 80
+// indent-tabs-mode: nil
+// End:
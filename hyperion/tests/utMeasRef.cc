@@ -16,11 +16,17 @@
 #include <hyperion/testing/TestSuiteDriver.h>
 #include <hyperion/testing/TestRecorder.h>
 #include <hyperion/MeasRef.h>
+#include <hyperion/Table.h>
+#include <hyperion/PhysicalTable.h>
+#include <hyperion/PhysicalColumn.h>
 
 #include <casacore/measures/Measures/MeasData.h>
 #include <casacore/measures/Measures/MCEpoch.h>
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <vector>
 
 using namespace hyperion;
 using namespace Legion;
@@ -35,6 +41,218 @@ enum {
 #define TE(f) testing::TestEval<std::function<bool()>>([&](){ return f; }, #f)
 #endif
 
+enum struct MeasAxes {
+  ROW = 0
+};
+
+template <>
+struct hyperion::Axes<MeasAxes> {
+  static const constexpr char* uid = "MeasAxes";
+  static const std::vector<std::string> names;
+  static const unsigned num_axes = 1;
+#ifdef HYPERION_USE_HDF5
+  static const hid_t h5_datatype;
+#endif
+};
+
+const std::vector<std::string>
+hyperion::Axes<MeasAxes>::names{"ROW"};
+
+#ifdef HYPERION_USE_HDF5
+hid_t
+h5_dt() {
+  hid_t result = H5Tenum_create(H5T_NATIVE_UCHAR);
+  MeasAxes a = MeasAxes::ROW;
+  [[maybe_unused]] herr_t err = H5Tenum_insert(result, "ROW", &a);
+  assert(err >= 0);
+  return result;
+}
+
+const hid_t
+hyperion::Axes<MeasAxes>::h5_datatype = h5_dt();
+#endif
+
+enum {
+  COL_TIME,
+  COL_TIME_REF
+};
+
+#define NUM_ROWS 6
+
+// per-row reference codes of the variable reference column
+const int row_refcodes[NUM_ROWS]{
+  casacore::MEpoch::TAI,
+  casacore::MEpoch::UTC,
+  casacore::MEpoch::UTC,
+  casacore::MEpoch::TAI,
+  casacore::MEpoch::UTC,
+  casacore::MEpoch::TAI
+};
+
+typedef PhysicalColumnTMD<
+  HYPERION_TYPE_DOUBLE,
+  MClass::M_EPOCH,
+  1,
+  1,
+  1,
+  AffineAccessor> TimeColumn;
+
+typedef PhysicalColumnTD<HYPERION_TYPE_INT, 1, 1, AffineAccessor>
+  TimeRefColumn;
+
+// (TAI) epoch written to row "row"
+casacore::MEpoch
+epoch_at(const Point<1>& row) {
+  return
+    casacore::MEpoch(
+      casacore::Quantity(casacore::MeasData::MJD2000 + row[0], "d"),
+      casacore::MEpoch::Ref(casacore::MEpoch::TAI));
+}
+
+void
+variable_reference_column_tests(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  casacore::MEpoch::Ref reftai(casacore::MEpoch::TAI);
+  casacore::MEpoch::Ref refutc(casacore::MEpoch::UTC);
+  MeasRef mr =
+    MeasRef::create(
+      ctx,
+      rt,
+      std::vector<std::tuple<casacore::MEpoch::Ref, unsigned>>{
+        {reftai, casacore::MEpoch::TAI},
+        {refutc, casacore::MEpoch::UTC}});
+
+  auto is = rt->create_index_space(ctx, Rect<1>(0, NUM_ROWS - 1));
+  auto cs =
+    ColumnSpace::create(
+      ctx,
+      rt,
+      std::vector<MeasAxes>{MeasAxes::ROW},
+      is,
+      false);
+  std::vector<std::pair<std::string, TableField>> fields{
+    {"TIME",
+     TableField(
+       HYPERION_TYPE_DOUBLE,
+       COL_TIME,
+       Keywords(),
+       mr,
+       hyperion::string("TIME_REF"))},
+    {"TIME_REF", TableField(HYPERION_TYPE_INT, COL_TIME_REF)}
+  };
+  Table tb = Table::create(ctx, rt, cs, {{cs, fields}});
+
+  auto reqs = Column::default_requirements;
+  reqs.values.privilege = READ_WRITE;
+  reqs.values.mapped = true;
+  PhysicalTable pt = tb.map_inline(ctx, rt, {}, reqs);
+  const Rect<1> rows(0, NUM_ROWS - 1);
+  {
+    auto refcodes =
+      TimeRefColumn(*pt.column("TIME_REF").value()).accessor<WRITE_ONLY>();
+    for (coord_t i = 0; i < NUM_ROWS; ++i)
+      refcodes[i] = row_refcodes[i];
+  }
+  TimeColumn time_col(*pt.column("TIME").value());
+  {
+    auto mra = time_col.meas_ref_accessor<READ_WRITE>(rt);
+    std::vector<std::tuple<coord_t, const void*>> visits;
+    mra.convert_rect(
+      rows,
+      [&visits](const Point<1>& pt, casacore::MEpoch::Convert& cvt) {
+        visits.emplace_back(pt[0], &cvt);
+      });
+    recorder.assert_true(
+      "convert_rect visits every point of a variable reference column once",
+      testing::TestEval<std::function<bool()>>(
+        [&visits]() {
+          std::vector<coord_t> pts;
+          for (auto& v : visits)
+            pts.push_back(std::get<0>(v));
+          std::sort(pts.begin(), pts.end());
+          bool result = pts.size() == NUM_ROWS;
+          for (size_t i = 0; result && i < pts.size(); ++i)
+            result = pts[i] == static_cast<coord_t>(i);
+          return result;
+        }));
+    recorder.expect_true(
+      "convert_rect visits points grouped by measure reference",
+      testing::TestEval<std::function<bool()>>(
+        [&visits]() {
+          std::vector<const void*> done;
+          const void* current = nullptr;
+          for (auto& v : visits) {
+            auto cvt = std::get<1>(v);
+            if (cvt != current) {
+              if (std::find(done.begin(), done.end(), cvt) != done.end())
+                return false;
+              done.push_back(cvt);
+              current = cvt;
+            }
+          }
+          return done.size() == 2;
+        }));
+    recorder.expect_true(
+      "convert_rect uses one converter per measure reference",
+      testing::TestEval<std::function<bool()>>(
+        [&visits]() {
+          for (auto& v0 : visits)
+            for (auto& v1 : visits) {
+              bool same_ref =
+                row_refcodes[std::get<0>(v0)] == row_refcodes[std::get<0>(v1)];
+              if (same_ref != (std::get<1>(v0) == std::get<1>(v1)))
+                return false;
+            }
+          return true;
+        }));
+    recorder.expect_true(
+      "convert_at returns the converter cached by convert_rect",
+      testing::TestEval<std::function<bool()>>(
+        [&visits, &mra]() {
+          for (auto& v : visits)
+            if (&mra.convert_at(Point<1>(std::get<0>(v))) != std::get<1>(v))
+              return false;
+          return true;
+        }));
+  }
+  {
+    auto meas = time_col.meas_accessor<READ_WRITE>(rt, "s");
+    meas.write(rows, epoch_at);
+    recorder.expect_true(
+      "Measures written over a rect have the per-row measure reference",
+      testing::TestEval<std::function<bool()>>(
+        [&meas]() {
+          for (coord_t i = 0; i < NUM_ROWS; ++i)
+            if (meas.read(Point<1>(i)).getRef().getType()
+                != static_cast<unsigned>(row_refcodes[i]))
+              return false;
+          return true;
+        }));
+    recorder.expect_true(
+      "Measures written over a rect are converted to the per-row reference",
+      testing::TestEval<std::function<bool()>>(
+        [&meas]() {
+          for (coord_t i = 0; i < NUM_ROWS; ++i) {
+            casacore::MEpoch::Convert
+              cvt(
+                epoch_at(Point<1>(i)),
+                casacore::MEpoch::Ref(row_refcodes[i]));
+            double expected = cvt().get("s").getValue();
+            double actual = meas.read(Point<1>(i)).get("s").getValue();
+            if (std::abs(actual - expected) > 1.0e-6)
+              return false;
+          }
+          return true;
+        }));
+  }
+  pt.unmap_regions(ctx, rt);
+  tb.destroy(ctx, rt);
+  mr.destroy(ctx, rt);
+}
+
 void
 meas_ref_test_suite(
   const Task *task,
@@ -134,11 +352,15 @@ meas_ref_test_suite(
 
     mr_1950.destroy(ctx, rt);
   }
+
+  variable_reference_column_tests(ctx, rt, recorder);
 }
 
 int
 main(int argc, char* argv[]) {
 
+  AxesRegistrar::register_axes<MeasAxes>();
+
   testing::TestSuiteDriver driver =
     testing::TestSuiteDriver::make<meas_ref_test_suite>(
       MEAS_REF_TEST_SUITE,
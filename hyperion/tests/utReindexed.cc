@@ -37,27 +37,30 @@ enum {
 enum struct Table0Axes {
   ROW = 0,
   X,
-  Y
+  Y,
+  P
 };
 
 enum {
   COL_X,
   COL_Y,
-  COL_Z
+  COL_Z,
+  COL_DATA,
+  COL_DATA_T
 };
 
 template <>
 struct hyperion::Axes<Table0Axes> {
   static const constexpr char* uid = "Table0Axes";
   static const std::vector<std::string> names;
-  static const unsigned num_axes = 3;
+  static const unsigned num_axes = 4;
 #ifdef HYPERION_USE_HDF5
   static const hid_t h5_datatype;
 #endif
 };
 
 const std::vector<std::string>
-hyperion::Axes<Table0Axes>::names{"ROW", "X", "Y"};
+hyperion::Axes<Table0Axes>::names{"ROW", "X", "Y", "P"};
 
 #ifdef HYPERION_USE_HDF5
 hid_t
@@ -72,6 +75,9 @@ h5_dt() {
   a = Table0Axes::Y;
   err = H5Tenum_insert(result, "Y", &a);
   assert(err >= 0);
+  a = Table0Axes::P;
+  err = H5Tenum_insert(result, "P", &a);
+  assert(err >= 0);
   return result;
 }
 
@@ -91,6 +97,9 @@ operator<<(std::ostream& stream, const Table0Axes& ax) {
   case Table0Axes::Y:
     stream << "Y";
     break;
+  case Table0Axes::P:
+    stream << "P";
+    break;
   }
   return stream;
 }
@@ -128,8 +137,38 @@ unsigned table0_y[TABLE0_NUM_ROWS] {
 unsigned table0_z[TABLE0_NUM_ROWS] {
                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
 
+#define TABLE0_NUM_P 2
+typedef DataType<HYPERION_TYPE_COMPLEX>::ValueType data_t;
+// DATA and DATA_T columns have the same values, (row, p), but the values of
+// DATA are stored in row-major order, and those of DATA_T in column-major
+// order
+data_t table0_data[TABLE0_NUM_ROWS * TABLE0_NUM_P];
+data_t table0_data_t[TABLE0_NUM_ROWS * TABLE0_NUM_P];
+
+data_t
+data_value(coord_t row, coord_t p) {
+  return data_t(row, p);
+}
+
+void
+init_table0_data() {
+  for (coord_t r = 0; r < TABLE0_NUM_ROWS; ++r)
+    for (coord_t p = 0; p < TABLE0_NUM_P; ++p) {
+      table0_data[r * TABLE0_NUM_P + p] = data_value(r, p);
+      table0_data_t[p * TABLE0_NUM_ROWS + r] = data_value(r, p);
+    }
+}
+
+// when "column_major" is true, the attached instance is left restricted, so
+// that tasks using the column region get the column-major instance, with
+// values that are not adjacent along the innermost axis
 PhysicalRegion
-attach_table0_col(Context ctx, Runtime* rt, const Column& col, unsigned *base) {
+attach_table0_col(
+  Context ctx,
+  Runtime* rt,
+  const Column& col,
+  void *base,
+  bool column_major = false) {
 
   const Memory local_sysmem =
     Machine::MemoryQuery(Machine::get_machine())
@@ -138,11 +177,13 @@ attach_table0_col(Context ctx, Runtime* rt, const Column& col, unsigned *base) {
     .first();
 
   AttachLauncher task(EXTERNAL_INSTANCE, col.region, col.region);
-  task.attach_array_soa(base, false, {col.fid}, local_sysmem);
+  task.attach_array_soa(base, column_major, {col.fid}, local_sysmem);
   PhysicalRegion result = rt->attach_external_resource(ctx, task);
-  AcquireLauncher acq(col.region, col.region, result);
-  acq.add_field(col.fid);
-  rt->issue_acquire(ctx, acq);
+  if (!column_major) {
+    AcquireLauncher acq(col.region, col.region, result);
+    acq.add_field(col.fid);
+    rt->issue_acquire(ctx, acq);
+  }
   return result;
 }
 
@@ -152,6 +193,70 @@ attach_table0_col(Context ctx, Runtime* rt, const Column& col, unsigned *base) {
 #define TE(f) testing::TestEval<std::function<bool()>>([&](){ return f; }, #f)
 #endif
 
+// test values of a column with axes (ROW, P) in a table reindexed by both X
+// and Y; the DATA column is copied by reindex_copy_values in runs along the P
+// axis, whereas the DATA_T column is copied value by value
+void
+test_reindexed_data_column(
+  Context ctx,
+  Runtime* rt,
+  const std::unordered_map<std::string, Column>& cols,
+  const std::string& name,
+  bool x_before_y,
+  const std::string& prefix,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  recorder.assert_true(
+    prefix + " reindexed table has '" + name + "' column",
+    TE(cols.count(name) > 0));
+
+  auto& cd = cols.at(name);
+  recorder.assert_true(
+    prefix + " reindexed '" + name + "' column has expected size",
+    testing::TestEval<std::function<bool()>>(
+      [&cd, &x_before_y, &ctx, rt]() {
+        auto is = cd.region.get_index_space();
+        auto dom = rt->get_index_space_domain(ctx, is);
+        if (dom.get_dim() != 3)
+          return false;
+        Rect<3> r(dom.bounds<3,coord_t>());
+        coord_t r0, r1;
+        if (x_before_y) {
+          r0 = TABLE0_NUM_X - 1;
+          r1 = TABLE0_NUM_Y - 1;
+        } else {
+          r1 = TABLE0_NUM_X - 1;
+          r0 = TABLE0_NUM_Y - 1;
+        }
+        Rect<3> expected(
+          Point<3>(0, 0, 0),
+          Point<3>(r0, r1, TABLE0_NUM_P - 1));
+        return r == expected;
+      }));
+  recorder.expect_true(
+    prefix + " reindexed '" + name + "' column has expected values",
+    testing::TestEval<std::function<bool()>>(
+      [&cd, &x_before_y, &ctx, rt]() {
+        RegionRequirement req(cd.region, READ_ONLY, EXCLUSIVE, cd.region);
+        req.add_field(cd.fid);
+        PhysicalRegion pr = rt->map_region(ctx, req);
+        const FieldAccessor<
+          READ_ONLY, data_t, 3, coord_t,
+          AffineAccessor<data_t, 3, coord_t>, true>
+          d(pr, cd.fid);
+        bool result = true;
+        DomainT<3,coord_t> dom =
+          rt->get_index_space_domain(cd.region.get_index_space());
+        coord_t p0 = (x_before_y ? 0 : 1);
+        coord_t p1 = 1 - p0;
+        for (PointInDomainIterator<3> pid(dom); pid(); pid++)
+          result = result &&
+            d[*pid] == data_value(pid[p0] * TABLE0_NUM_Y + pid[p1], pid[2]);
+        rt->unmap_region(ctx, pr);
+        return result;
+      }));
+}
+
 void
 test_totally_reindexed_table(
   Context ctx,
@@ -369,6 +474,133 @@ test_totally_reindexed_table(
           return result;
         }));
   }
+  test_reindexed_data_column(
+    ctx,
+    rt,
+    cols,
+    "DATA",
+    x_before_y,
+    prefix,
+    recorder);
+  test_reindexed_data_column(
+    ctx,
+    rt,
+    cols,
+    "DATA_T",
+    x_before_y,
+    prefix,
+    recorder);
+}
+
+// values of X column in table1 occur in several, separate runs of rows
+unsigned table1_x[TABLE0_NUM_ROWS] {
+                   OX + 0, OX + 0, OX + 1, OX + 1,
+                     OX + 0, OX + 0, OX + 1, OX + 1,
+                     OX + 0, OX + 0, OX + 1, OX + 1};
+
+void
+test_runs_reindexed_table(
+  Context ctx,
+  Runtime* rt,
+  testing::TestRecorder<READ_WRITE>& recorder) {
+
+  auto xz_is = rt->create_index_space(ctx, Rect<1>(0, TABLE0_NUM_ROWS - 1));
+  auto xz_space =
+    ColumnSpace::create(
+      ctx,
+      rt,
+      std::vector<Table0Axes>{Table0Axes::ROW},
+      xz_is,
+      false);
+  std::vector<std::pair<std::string, TableField>> xz_fields{
+    {"X", TableField(HYPERION_TYPE_UINT, COL_X)},
+    {"Z", TableField(HYPERION_TYPE_UINT, COL_Z)}
+  };
+  auto table1 = Table::create(ctx, rt, xz_space, {{xz_space, xz_fields}});
+  std::vector<PhysicalRegion> col_prs;
+  {
+    auto cols = table1.columns();
+    col_prs.push_back(attach_table0_col(ctx, rt, cols.at("X"), table1_x));
+    col_prs.push_back(attach_table0_col(ctx, rt, cols.at("Z"), table0_z));
+  }
+  Table tbx;
+  {
+    Future f =
+      table1.reindexed(
+        ctx,
+        rt,
+        std::vector<Table0Axes>{Table0Axes::X},
+        true);
+    tbx = f.get_result<Table>();
+  }
+  auto cols = tbx.columns();
+  recorder.assert_true(
+    "Table reindexed on value runs has 'X' and 'Z' columns",
+    TE(cols.count("X") > 0 && cols.count("Z") > 0));
+  {
+    auto& cx = cols.at("X");
+    recorder.expect_true(
+      "Reindexed 'X' column has one value per run set",
+      testing::TestEval<std::function<bool()>>(
+        [&cx, &ctx, rt]() {
+          auto dom =
+            rt->get_index_space_domain(ctx, cx.region.get_index_space());
+          if (dom.get_dim() != 1
+              || Rect<1>(dom.bounds<1,coord_t>()) != Rect<1>(0, 1))
+            return false;
+          RegionRequirement req(cx.region, READ_ONLY, EXCLUSIVE, cx.region);
+          req.add_field(cx.fid);
+          PhysicalRegion pr = rt->map_region(ctx, req);
+          const FieldAccessor<
+            READ_ONLY, unsigned, 1, coord_t,
+            AffineAccessor<unsigned, 1, coord_t>, true>
+            x(pr, cx.fid);
+          bool result = x[0] == OX && x[1] == OX + 1;
+          rt->unmap_region(ctx, pr);
+          return result;
+        }));
+  }
+  {
+    // the rows of every X value are the concatenation of three runs of two
+    // rows each
+    auto& cz = cols.at("Z");
+    recorder.assert_true(
+      "Reindexed 'Z' column has rows of all runs",
+      testing::TestEval<std::function<bool()>>(
+        [&cz, &ctx, rt]() {
+          auto dom =
+            rt->get_index_space_domain(ctx, cz.region.get_index_space());
+          return
+            dom.get_dim() == 2
+            && Rect<2>(dom.bounds<2,coord_t>())
+            == Rect<2>(Point<2>(0, 0), Point<2>(1, TABLE0_NUM_ROWS / 2 - 1));
+        }));
+    recorder.expect_true(
+      "Reindexed 'Z' column has values of rows of all runs, in order",
+      testing::TestEval<std::function<bool()>>(
+        [&cz, &ctx, rt]() {
+          RegionRequirement req(cz.region, READ_ONLY, EXCLUSIVE, cz.region);
+          req.add_field(cz.fid);
+          PhysicalRegion pr = rt->map_region(ctx, req);
+          const FieldAccessor<
+            READ_ONLY, unsigned, 2, coord_t,
+            AffineAccessor<unsigned, 2, coord_t>, true>
+            z(pr, cz.fid);
+          bool result = true;
+          DomainT<2,coord_t> dom =
+            rt->get_index_space_domain(cz.region.get_index_space());
+          for (PointInDomainIterator<2> pid(dom); pid(); pid++) {
+            coord_t row = (pid[1] / 2) * 4 + pid[0] * 2 + pid[1] % 2;
+            result = result && z[*pid] == table0_z[row];
+          }
+          rt->unmap_region(ctx, pr);
+          return result;
+        }));
+  }
+  tbx.destroy(ctx, rt);
+  for (auto& pr : col_prs)
+    rt->detach_external_resource(ctx, pr);
+  table1.destroy(ctx, rt);
 }
 
 void
@@ -425,7 +657,31 @@ reindexed_test_suite(
     {"Z", TableField(HYPERION_TYPE_UINT, COL_Z)}
   };
 
-  auto table0 = Table::create(ctx, rt, xyz_space, {{xyz_space, xyz_fields}});
+  init_table0_data();
+  auto data_is =
+    rt->create_index_space(
+      ctx,
+      Rect<2>(
+        Point<2>(0, 0),
+        Point<2>(TABLE0_NUM_ROWS - 1, TABLE0_NUM_P - 1)));
+  auto data_space =
+    ColumnSpace::create(
+      ctx,
+      rt,
+      std::vector<Table0Axes>{Table0Axes::ROW, Table0Axes::P},
+      data_is,
+      false);
+  std::vector<std::pair<std::string, TableField>> data_fields{
+    {"DATA", TableField(HYPERION_TYPE_COMPLEX, COL_DATA)},
+    {"DATA_T", TableField(HYPERION_TYPE_COMPLEX, COL_DATA_T)}
+  };
+
+  auto table0 =
+    Table::create(
+      ctx,
+      rt,
+      xyz_space,
+      {{xyz_space, xyz_fields}, {data_space, data_fields}});
   {
     std::unordered_map<std::string, PhysicalRegion> col_prs;
     {
@@ -442,6 +698,10 @@ reindexed_test_suite(
         col_prs[cstr] =
           attach_table0_col(ctx, rt, cols.at(cstr), col_arrays.at(cstr));
       }
+      col_prs["DATA"] =
+        attach_table0_col(ctx, rt, cols.at("DATA"), table0_data);
+      col_prs["DATA_T"] =
+        attach_table0_col(ctx, rt, cols.at("DATA_T"), table0_data_t, true);
     }
     // tests of complete, one-step reindexing
     {
@@ -698,6 +958,8 @@ reindexed_test_suite(
     }
   }
   table0.destroy(ctx, rt);
+
+  test_runs_reindexed_table(ctx, rt, recorder);
 }
 
 int
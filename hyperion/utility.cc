@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <hyperion/utility.h>
+#include <hyperion/Instrumentation.h>
 #include <hyperion/tree_index_space.h>
 #include <hyperion/MSTable.h>
 #include <hyperion/Table.h>
@@ -345,6 +346,8 @@ hyperion::OpsManager::register_ops(
 
   Runtime::register_custom_serdez_op<
     vector_serdez<DomainPoint>>(serdez_id(V_DOMAIN_POINT_SID));
+  Runtime::register_custom_serdez_op<
+    vector_serdez<row_run>>(serdez_id(V_ROW_RUN_SID));
   Runtime::register_custom_serdez_op<
     string_serdez<std::string>>(serdez_id(STD_STRING_SID));
 
@@ -410,154 +413,10 @@ hyperion::OpsManager::register_ops(
     reduction_id(BOOL_OR_REDOP));
   Runtime::register_reduction_op<coord_bor_redop>(
     reduction_id(COORD_BOR_REDOP));
-
-#ifdef WITH_ACC_FIELD_REDOP_SERDEZ
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_STRING_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_STRING>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_STRING>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_STRING>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_BOOL_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_BOOL>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_BOOL>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_BOOL>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_CHAR_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_CHAR>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_CHAR>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_CHAR>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_UCHAR_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_UCHAR>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_UCHAR>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_UCHAR>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_SHORT_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_SHORT>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_SHORT>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_SHORT>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_USHORT_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_USHORT>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_USHORT>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_USHORT>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_INT_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_INT>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_INT>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_INT>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_UINT_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_UINT>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_UINT>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_UINT>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_FLOAT_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_FLOAT>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_FLOAT>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_FLOAT>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_DOUBLE_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_DOUBLE>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_DOUBLE>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_DOUBLE>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_COMPLEX_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_COMPLEX>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_COMPLEX>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_COMPLEX>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_DCOMPLEX_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_DCOMPLEX>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_DCOMPLEX>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_DCOMPLEX>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_RECT2_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_RECT2>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_RECT2>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_RECT2>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_RECT3_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_RECT3>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_RECT3>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_RECT3>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_STOKES_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_STOKES>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_STOKES>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_STOKES>::ValueType>::fold_fn);
-  Runtime::register_reduction_op(
-    reduction_id(ACC_FIELD_STOKES_PAIR_REDOP),
-    Realm::ReductionOpUntyped::create_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_STOKES_PAIR>::ValueType>>(),
-    acc_field_redop<DataType<HYPERION_TYPE_STOKES_PAIR>::ValueType>::init_fn,
-    acc_field_redop<DataType<HYPERION_TYPE_STOKES_PAIR>::ValueType>::fold_fn);
-#else
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_STRING>::ValueType>>(
-      reduction_id(ACC_FIELD_STRING_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_BOOL>::ValueType>>(
-      reduction_id(ACC_FIELD_BOOL_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_CHAR>::ValueType>>(
-      reduction_id(ACC_FIELD_CHAR_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_UCHAR>::ValueType>>(
-      reduction_id(ACC_FIELD_UCHAR_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_SHORT>::ValueType>>(
-      reduction_id(ACC_FIELD_SHORT_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_USHORT>::ValueType>>(
-      reduction_id(ACC_FIELD_USHORT_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_INT>::ValueType>>(
-      reduction_id(ACC_FIELD_INT_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_UINT>::ValueType>>(
-      reduction_id(ACC_FIELD_UINT_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_FLOAT>::ValueType>>(
-      reduction_id(ACC_FIELD_FLOAT_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_DOUBLE>::ValueType>>(
-      reduction_id(ACC_FIELD_DOUBLE_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_COMPLEX>::ValueType>>(
-      reduction_id(ACC_FIELD_COMPLEX_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_DCOMPLEX>::ValueType>>(
-      reduction_id(ACC_FIELD_DCOMPLEX_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_RECT2>::ValueType>>(
-      reduction_id(ACC_FIELD_RECT2_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_RECT3>::ValueType>>(
-      reduction_id(ACC_FIELD_RECT3_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_STOKES>::ValueType>>(
-      reduction_id(ACC_FIELD_STOKES_REDOP));
-  Runtime::register_reduction_op<
-    acc_field_redop<DataType<HYPERION_TYPE_STOKES_PAIR>::ValueType>>(
-      reduction_id(ACC_FIELD_STOKES_PAIR_REDOP));
-#endif // WITH_ACC_FIELD_REDOP_SERDEZ
+  Runtime::register_reduction_op<complex_sum_redop<float>>(
+    reduction_id(COMPLEX_SUM_REDOP));
+  Runtime::register_reduction_op<complex_sum_redop<double>>(
+    reduction_id(DCOMPLEX_SUM_REDOP));
 
 #define REGISTER_POINT_ADD_REDOP(DIM)                   \
   Runtime::register_reduction_op<point_add_redop<DIM>>( \
@@ -635,6 +494,8 @@ hyperion::register_mapper(
 void
 hyperion::preregister_all() {
 
+  Instrumentation::preregister();
+
   {
     LayoutConstraintRegistrar
       registrar(FieldSpace::NO_SPACE, "soa_right");
@@ -659,6 +520,19 @@ hyperion::preregister_all() {
     add_aos_left_ordering_constraint(registrar);
     aos_left_layout = Runtime::preregister_layout(registrar);
   }
+  // the order of registration must match the values of the named layout tags
+  // in TableMapper
+  {
+    [[maybe_unused]] TableMapper::LayoutTag ltag;
+    ltag = TableMapper::register_layout("soa_right", soa_right_layout);
+    assert(ltag == TableMapper::soa_right_layout_tag);
+    ltag = TableMapper::register_layout("soa_left", soa_left_layout);
+    assert(ltag == TableMapper::soa_left_layout_tag);
+    ltag = TableMapper::register_layout("aos_right", aos_right_layout);
+    assert(ltag == TableMapper::aos_right_layout_tag);
+    ltag = TableMapper::register_layout("aos_left", aos_left_layout);
+    assert(ltag == TableMapper::aos_left_layout_tag);
+  }
 
   table_mapper = Runtime::generate_static_mapper_id();
   Runtime::add_registration_callback(register_mapper);
@@ -844,125 +844,244 @@ public:
   }
 };
 
+/**
+ * Sorted index of the values in (a block of) a column
+ *
+ * The distinct values are held in increasing order in "values", and the
+ * (increasing) points at which values[i] occurs are
+ * points[offsets[i]:offsets[i + 1]]. All points are stored in one flat array,
+ * which keeps the result compact and allows it to be serialized with a
+ * handful of memcpy calls.
+ */
 template <typename T>
-struct acc_field_redop_rhs {
-  std::vector<std::tuple<T, std::vector<Legion::DomainPoint>>> v;
+struct column_index_block {
+  std::vector<T> values;
+  std::vector<size_t> offsets;
+  std::vector<Legion::DomainPoint> points;
+
+  size_t
+  size() const {
+    return values.size();
+  }
 
   size_t
   legion_buffer_size(void) const {
-    return acc_field_serdez<T>::serialized_size(v);
+    return
+      2 * sizeof(size_t)
+      + values.size() * (sizeof(T) + sizeof(size_t))
+      + points.size() * sizeof(Legion::DomainPoint);
   }
 
   size_t
   legion_serialize(void* buffer) const {
-    return acc_field_serdez<T>::serialize(v, buffer);
+    char* b = static_cast<char*>(buffer);
+    size_t nv = values.size();
+    size_t np = points.size();
+    std::memcpy(b, &nv, sizeof(nv));
+    b += sizeof(nv);
+    std::memcpy(b, &np, sizeof(np));
+    b += sizeof(np);
+    std::memcpy(b, values.data(), nv * sizeof(T));
+    b += nv * sizeof(T);
+    // offsets[0] is always 0, and offsets[nv] is always np
+    if (nv > 0)
+      std::memcpy(b, offsets.data() + 1, nv * sizeof(size_t));
+    b += nv * sizeof(size_t);
+    std::memcpy(b, points.data(), np * sizeof(Legion::DomainPoint));
+    b += np * sizeof(Legion::DomainPoint);
+    return b - static_cast<char*>(buffer);
   }
 
   size_t
   legion_deserialize(const void* buffer) {
-    return acc_field_serdez<T>::deserialize(v, buffer);
+    const char* b = static_cast<const char*>(buffer);
+    size_t nv, np;
+    std::memcpy(&nv, b, sizeof(nv));
+    b += sizeof(nv);
+    std::memcpy(&np, b, sizeof(np));
+    b += sizeof(np);
+    values.resize(nv);
+    std::memcpy(values.data(), b, nv * sizeof(T));
+    b += nv * sizeof(T);
+    offsets.resize(nv + 1);
+    offsets[0] = 0;
+    std::memcpy(offsets.data() + 1, b, nv * sizeof(size_t));
+    b += nv * sizeof(size_t);
+    points.resize(np);
+    std::memcpy(points.data(), b, np * sizeof(Legion::DomainPoint));
+    b += np * sizeof(Legion::DomainPoint);
+    return b - static_cast<const char*>(buffer);
+  }
+
+  /**
+   * Build the index of (value, point) pairs given in arbitrary order
+   *
+   * Points with equal values keep their relative order, so that the points of
+   * every value are increasing whenever the input points are increasing.
+   */
+  static column_index_block
+  from_pairs(std::vector<std::tuple<T, Legion::DomainPoint>>&& pairs) {
+    std::stable_sort(
+      pairs.begin(),
+      pairs.end(),
+      [](const auto& a, const auto& b) {
+        return std::get<0>(a) < std::get<0>(b);
+      });
+    column_index_block result;
+    result.points.reserve(pairs.size());
+    result.offsets.push_back(0);
+    for (auto& t_pt : pairs) {
+      if (result.values.size() == 0
+          || result.values.back() < std::get<0>(t_pt)) {
+        if (result.values.size() > 0)
+          result.offsets.push_back(result.points.size());
+        result.values.push_back(std::get<0>(t_pt));
+      }
+      result.points.push_back(std::get<1>(t_pt));
+    }
+    if (result.values.size() > 0)
+      result.offsets.push_back(result.points.size());
+    return result;
   }
-};
 
-template <typename T>
-class acc_field_redop {
-public:
-  typedef std::vector<std::tuple<T, std::vector<Legion::DomainPoint>>> LHS;
-  typedef acc_field_redop_rhs<T> RHS;
-
-  static void
-  combine(LHS& lhs, const RHS& rhs) {
-    if (lhs.size() == 0) {
-      lhs = rhs.v;
-    } else {
-      std::for_each(
-        rhs.v.begin(),
-        rhs.v.end(),
-        [&lhs](auto& t_rns) {
-#if HAVE_CXX17
-          auto& [t, rns] = t_rns;
-#else // !HAVE_CXX17
-          auto& t = std::get<0>(t_rns);
-          auto& rns = std::get<1>(t_rns);
-#endif // HAVE_CXX17
-          if (rns.size() > 0) {
-            auto lb =
-              std::lower_bound(
-                lhs.begin(),
-                lhs.end(),
-                t,
-                [](const auto& a, const auto& b) { return std::get<0>(a) < b; });
-            if (lb != lhs.end() && std::get<0>(*lb) == t) {
-              auto& lrns = std::get<1>(*lb);
-              auto l = lrns.begin();
-              auto r = rns.begin();
-              while (r != rns.end() && l != lrns.end()) {
-                if (*r < *l) {
-                  // the following lrns.insert() call may invalidate the "l"
-                  // iterator; to compensate, save the iterator's offset, do the
-                  // insertion, and then recreate the iterator
-                  auto lo = std::distance(l, lrns.begin());
-                  lrns.insert(l, *r);
-                  l = lrns.begin() + lo + 1;
-                  ++r;
-                } else if (*r == *l) {
-                  ++r;
-                } else {
-                  ++l;
-                }
-              }
-              std::copy(r, rns.end(), std::back_inserter(lrns));
-            } else {
-              lhs.insert(lb, t_rns);
-            }
-          }
-        });
+  /**
+   * Merge two indexes
+   *
+   * The points of a value that occurs in both indexes are merged in order;
+   * points present in both are retained only once.
+   */
+  static column_index_block
+  merge(const column_index_block& a, const column_index_block& b) {
+    column_index_block result;
+    result.values.reserve(a.values.size() + b.values.size());
+    result.offsets.reserve(a.values.size() + b.values.size() + 1);
+    result.points.reserve(a.points.size() + b.points.size());
+    result.offsets.push_back(0);
+    auto append =
+      [&result](const column_index_block& cib, size_t i) {
+        result.points.insert(
+          result.points.end(),
+          cib.points.begin() + cib.offsets[i],
+          cib.points.begin() + cib.offsets[i + 1]);
+      };
+    size_t ia = 0;
+    size_t ib = 0;
+    while (ia < a.values.size() || ib < b.values.size()) {
+      if (ib == b.values.size()
+          || (ia < a.values.size() && a.values[ia] < b.values[ib])) {
+        result.values.push_back(a.values[ia]);
+        append(a, ia++);
+      } else if (ia == a.values.size() || b.values[ib] < a.values[ia]) {
+        result.values.push_back(b.values[ib]);
+        append(b, ib++);
+      } else {
+        result.values.push_back(a.values[ia]);
+        std::set_union(
+          a.points.begin() + a.offsets[ia],
+          a.points.begin() + a.offsets[ia + 1],
+          b.points.begin() + b.offsets[ib],
+          b.points.begin() + b.offsets[ib + 1],
+          std::back_inserter(result.points));
+        ++ia;
+        ++ib;
+      }
+      result.offsets.push_back(result.points.size());
     }
+    return result;
   }
 
-  template <bool EXCL>
-  static void
-  apply(LHS& lhs, const RHS& rhs) {
-    combine(lhs, rhs);
+  /**
+   * Merge any number of indexes
+   *
+   * Indexes are merged pairwise in a balanced tree, so every value and point
+   * is copied only O(log(blocks.size())) times.
+   */
+  static column_index_block
+  merge(std::vector<column_index_block>&& blocks) {
+    if (blocks.size() == 0)
+      return column_index_block();
+    while (blocks.size() > 1) {
+      std::vector<column_index_block> merged;
+      merged.reserve((blocks.size() + 1) / 2);
+      for (size_t i = 0; i + 1 < blocks.size(); i += 2)
+        merged.push_back(merge(blocks[i], blocks[i + 1]));
+      if (blocks.size() % 2 == 1)
+        merged.push_back(std::move(blocks.back()));
+      blocks = std::move(merged);
+    }
+    return std::move(blocks[0]);
   }
+};
 
-  static const RHS identity;
-
-  template <bool EXCL>
-  static void
-  fold(RHS& rhs1, const RHS& rhs2) {
-    combine(rhs1.v, rhs2);
-  }
+/**
+ * Run of consecutive points that differ only in their last coordinate
+ *
+ * The run comprises all points p with lo <= p <= hi. Sorted lists of disjoint
+ * runs provide a compact representation of sets of (row) points, as rows
+ * with a common value typically occur in long sequences.
+ */
+struct HYPERION_EXPORT row_run {
+  Legion::DomainPoint lo;
+  Legion::DomainPoint hi;
 
-#ifdef WITH_ACC_FIELD_REDOP_SERDEZ
-  static void
-  init_fn(const Legion::ReductionOp*, void *& state, size_t& sz) {
-    RHS rhs;
-    state = realloc(state, rhs.legion_buffer_size());
-    sz = rhs.legion_serialize(state);
+  size_t
+  size() const {
+    return hi[hi.get_dim() - 1] - lo[lo.get_dim() - 1] + 1;
+  }
+
+  /**
+   * Compress sorted, unique points into maximal runs
+   */
+  template <typename InputIt, typename OutputIt>
+  static OutputIt
+  from_points(InputIt first, InputIt last, OutputIt d_first) {
+    if (first != last) {
+      row_run run{*first, *first};
+      for (++first; first != last; ++first) {
+        int d = run.hi.get_dim() - 1;
+        bool extends = first->get_dim() == run.hi.get_dim();
+        for (int i = 0; extends && i < d; ++i)
+          extends = (*first)[i] == run.hi[i];
+        if (extends && (*first)[d] == run.hi[d] + 1) {
+          run.hi = *first;
+        } else {
+          *d_first++ = run;
+          run = row_run{*first, *first};
+        }
+      }
+      *d_first++ = run;
+    }
+    return d_first;
+  }
+
+  /**
+   * Intersection of two sorted lists of disjoint runs
+   */
+  static std::vector<row_run>
+  intersection(
+    const std::vector<row_run>& first,
+    const std::vector<row_run>& second) {
+
+    // since all the points of a run share every coordinate except the last,
+    // two overlapping runs (as intervals in lexicographic order) intersect in
+    // a run
+    std::vector<row_run> result;
+    auto f = first.begin();
+    auto s = second.begin();
+    while (f != first.end() && s != second.end()) {
+      auto& lo = (f->lo < s->lo) ? s->lo : f->lo;
+      auto& hi = (f->hi < s->hi) ? f->hi : s->hi;
+      if (!(hi < lo))
+        result.push_back(row_run{lo, hi});
+      if (f->hi < s->hi)
+        ++f;
+      else
+        ++s;
+    }
+    return result;
   }
-
-  static void
-  fold_fn(
-    const Legion::ReductionOp* reduction_op,
-    void *& state,
-    size_t& sz,
-    const void* result) {
-    RHS rhs, lhs;
-    rhs.legion_deserialize(result);
-    lhs.legion_deserialize(state);
-    reduction_op->fold(&lhs, &rhs, 1, true);
-    sz = lhs.legion_buffer_size();
-    state = realloc(state, sz);
-    lhs.legion_serialize(state);
-  }
-#endif // WITH_ACC_FIELD_REDOP_SERDEZ
 };
 
-template <typename T>
-typename acc_field_redop<T>::RHS const acc_field_redop<T>::identity =
-  acc_field_redop_rhs<T>{{}};
-
 struct HYPERION_EXPORT coord_bor_redop {
 
   typedef coord_t LHS;
@@ -1001,6 +1120,56 @@ coord_bor_redop::fold<false>(RHS& rhs1, RHS rhs2) {
   __atomic_or_fetch(&rhs1, rhs2, __ATOMIC_ACQUIRE);
 }
 
+template <typename T>
+struct complex_sum_redop {
+
+  typedef complex<T> LHS;
+  typedef complex<T> RHS;
+
+  static const RHS identity;
+
+  // complex values are layout compatible with an array of two values of the
+  // underlying floating point type, which is used by the non-exclusive variants
+  // to update the real and imaginary parts atomically
+  static void
+  atomic_add(T* lhs, T rhs) {
+    T expected;
+    __atomic_load(lhs, &expected, __ATOMIC_RELAXED);
+    T desired;
+    do {
+      desired = expected + rhs;
+    } while (!__atomic_compare_exchange(
+               lhs,
+               &expected,
+               &desired,
+               true,
+               __ATOMIC_ACQ_REL,
+               __ATOMIC_RELAXED));
+  }
+
+  template <bool EXCLUSIVE>
+  static void
+  apply(LHS& lhs, RHS rhs) {
+    if (EXCLUSIVE) {
+      lhs += rhs;
+    } else {
+      T* parts = reinterpret_cast<T*>(&lhs);
+      atomic_add(&parts[0], rhs.real());
+      atomic_add(&parts[1], rhs.imag());
+    }
+  }
+
+  template <bool EXCLUSIVE>
+  static void
+  fold(RHS& rhs1, RHS rhs2) {
+    apply<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+template <typename T>
+typename complex_sum_redop<T>::RHS const complex_sum_redop<T>::identity =
+  complex<T>(0, 0);
+
 template <TypeTag T>
 struct DataType {
 
@@ -1015,6 +1184,8 @@ public:
 
     V_DOMAIN_POINT_SID,
 
+    V_ROW_RUN_SID,
+
     STD_STRING_SID,
 
     ACC_FIELD_STRING_SID,
@@ -1047,22 +1218,8 @@ public:
 
     COORD_BOR_REDOP,
 
-    ACC_FIELD_STRING_REDOP,
-    ACC_FIELD_BOOL_REDOP,
-    ACC_FIELD_CHAR_REDOP,
-    ACC_FIELD_UCHAR_REDOP,
-    ACC_FIELD_SHORT_REDOP,
-    ACC_FIELD_USHORT_REDOP,
-    ACC_FIELD_INT_REDOP,
-    ACC_FIELD_UINT_REDOP,
-    ACC_FIELD_FLOAT_REDOP,
-    ACC_FIELD_DOUBLE_REDOP,
-    ACC_FIELD_COMPLEX_REDOP,
-    ACC_FIELD_DCOMPLEX_REDOP,
-    ACC_FIELD_RECT2_REDOP,
-    ACC_FIELD_RECT3_REDOP,
-    ACC_FIELD_STOKES_REDOP,
-    ACC_FIELD_STOKES_PAIR_REDOP,
+    COMPLEX_SUM_REDOP,
+    DCOMPLEX_SUM_REDOP,
 
     // this must be at the end
     POINT_ADD_REDOP_BASE
@@ -1245,7 +1402,6 @@ struct DataType<HYPERION_TYPE_BOOL> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_BOOL);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_BOOL_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_BOOL_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::Bool CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1272,7 +1428,6 @@ struct DataType<HYPERION_TYPE_CHAR> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_CHAR);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_CHAR_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_CHAR_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::Char CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1299,7 +1454,6 @@ struct DataType<HYPERION_TYPE_UCHAR> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_UCHAR);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_UCHAR_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_UCHAR_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::uChar CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1326,7 +1480,6 @@ struct DataType<HYPERION_TYPE_SHORT> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_SHORT);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_SHORT_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_SHORT_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::Short CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1353,7 +1506,6 @@ struct DataType<HYPERION_TYPE_USHORT> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_USHORT);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_USHORT_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_USHORT_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::uShort CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1380,7 +1532,6 @@ struct DataType<HYPERION_TYPE_INT> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_INT);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_INT_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_INT_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::Int CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1407,7 +1558,6 @@ struct DataType<HYPERION_TYPE_UINT> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_UINT);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_UINT_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_UINT_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::uInt CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1434,7 +1584,6 @@ struct DataType<HYPERION_TYPE_FLOAT> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_FLOAT);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_FLOAT_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_FLOAT_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::Float CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1461,7 +1610,6 @@ struct DataType<HYPERION_TYPE_DOUBLE> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_DOUBLE);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_DOUBLE_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_DOUBLE_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::Double CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1488,7 +1636,6 @@ struct DataType<HYPERION_TYPE_COMPLEX> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_COMPLEX);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_COMPLEX_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_COMPLEX_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::Complex CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1515,7 +1662,6 @@ struct DataType<HYPERION_TYPE_DCOMPLEX> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_DCOMPLEX);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_DCOMPLEX_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_DCOMPLEX_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::DComplex CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1542,7 +1688,6 @@ struct DataType<HYPERION_TYPE_STRING> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_STRING);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_STRING_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_STRING_REDOP;
 #ifdef HYPERION_USE_CASACORE
   typedef casacore::String CasacoreType;
   constexpr static casacore::DataType CasacoreTypeTag =
@@ -1569,7 +1714,6 @@ struct DataType<HYPERION_TYPE_RECT2> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_RECT2);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_RECT2_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_RECT2_REDOP;
 #ifdef HYPERION_USE_HDF5
   constexpr static hid_t h5t_id = H5DatatypeManager::RECT2_H5T;
 #endif
@@ -1585,7 +1729,6 @@ struct DataType<HYPERION_TYPE_RECT3> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_RECT3);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_RECT3_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_RECT3_REDOP;
 #ifdef HYPERION_USE_HDF5
   constexpr static hid_t h5t_id = H5DatatypeManager::RECT3_H5T;
 #endif
@@ -1601,7 +1744,6 @@ struct DataType<HYPERION_TYPE_STOKES> {
   constexpr static int id = static_cast<int>(HYPERION_TYPE_STOKES);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_STOKES_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_STOKES_REDOP;
 #ifdef HYPERION_USE_HDF5
   constexpr static hid_t h5t_id = H5DatatypeManager::STOKES_H5T;
 #endif
@@ -1612,14 +1754,13 @@ struct DataType<HYPERION_TYPE_STOKES> {
 
 template <>
 struct DataType<HYPERION_TYPE_STOKES_PAIR> {
-  // I'd prefer to use std::pair or std::tuple but they are not copy assignable,
-  // which is an issue in the acc_field_redop implementation above
+  // I'd prefer to use std::pair or std::tuple but they are not trivially
+  // copyable, which is an issue for the serialization of column_index_block
   typedef std::array<stokes_t, 2> ValueType;
   constexpr static const char* s = "stokes_pair";
   constexpr static int id = static_cast<int>(HYPERION_TYPE_STOKES_PAIR);
   constexpr static size_t serdez_size = sizeof(ValueType);
   constexpr static int af_serdez_id = OpsManager::ACC_FIELD_STOKES_PAIR_SID;
-  constexpr static int af_redop_id = OpsManager::ACC_FIELD_STOKES_PAIR_REDOP;
 #ifdef HYPERION_USE_HDF5
   constexpr static hid_t h5t_id = H5DatatypeManager::STOKES_PAIR_H5T;
 #endif